@@ -0,0 +1,488 @@
+/*
+ * Charm-Crypto is a framework for rapidly prototyping cryptosystems.
+ *
+ * Charm-Crypto is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Charm-Crypto is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Charm-Crypto. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Please contact the charm-crypto dev team at support@charm-crypto.com
+ * for any questions.
+ */
+
+/*
+ *   @file    ec_secp256k1.c
+ *
+ *   @brief   native scalar multiplication on secp256k1
+ *
+ *   OpenSSL has no dedicated method for secp256k1 and runs its generic BIGNUM
+ *   ladder. Here field elements are 4x64-bit limbs mod p = 2^256 - 2^32 - 977,
+ *   points use homogeneous projective coordinates with the complete formulas of
+ *   Renes, Costello and Batina (a = 0), and the scalar is split with the GLV
+ *   endomorphism (x, y) -> (beta * x, y) = lambda * (x, y) into two ~128-bit
+ *   halves. Everything that depends on the scalar is branch free.
+ *
+ ************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "ec_secp256k1.h"
+
+#if defined(__SIZEOF_INT128__)
+
+typedef unsigned __int128 u128;
+
+/* little-endian limbs; any value < 2^256, reduced mod p only on output */
+typedef struct { uint64_t v[4]; } fe;
+/* x = X / Z, y = Y / Z; the point at infinity is (0 : 1 : 0) */
+typedef struct { fe X, Y, Z; } ge;
+
+#define SECP256K1_C		0x1000003D1ULL	/* 2^256 mod p */
+#define SECP256K1_B3	21				/* 3 * b */
+#define GLV_WINDOW		4
+#define GLV_WINDOWS		33				/* 4-bit windows covering 132 bits */
+#define GLV_TABLE		(1 << GLV_WINDOW)
+
+static const fe fe_beta = {{ 0xC1396C28719501EEULL, 0x9CF0497512F58995ULL, 0x6E64479EAC3434E9ULL, 0x7AE96A2B657C0710ULL }};
+
+/* GLV lattice: c1 = round(k * g1 / 2^384), c2 = round(k * g2 / 2^384),
+ * k1 = k - c1 * a1 - c2 * a2, k2 = c1 * (-b1) - c2 * b2 (see Guide to ECC, alg. 3.74) */
+static const uint64_t glv_g1[4]  = { 0xE893209A45DBB031ULL, 0x3DAA8A1471E8CA7FULL, 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL };
+static const uint64_t glv_g2[4]  = { 0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL, 0x6F547FA90ABFE4C4ULL, 0xE4437ED6010E8828ULL };
+static const uint64_t glv_a1[4]  = { 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL, 0, 0 };
+static const uint64_t glv_mb1[4] = { 0x6F547FA90ABFE4C3ULL, 0xE4437ED6010E8828ULL, 0, 0 };
+static const uint64_t glv_a2[4]  = { 0x57C1108D9D44CFD8ULL, 0x14CA50F7A8E2F3F6ULL, 1, 0 };
+static const uint64_t glv_b2[4]  = { 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL, 0, 0 };
+
+/* r += c * 2^256 mod p for a carry c that spilled out of the top limb */
+static void fe_fold(fe *r, uint64_t c)
+{
+	int i, j;
+	for(j = 0; j < 2; j++) {
+		// the second round only sees a carry if the first one wrapped, leaving r small
+		u128 t = (u128) c * SECP256K1_C;
+		for(i = 0; i < 4; i++) {
+			t += r->v[i];
+			r->v[i] = (uint64_t) t;
+			t >>= 64;
+		}
+		c = (uint64_t) t;
+	}
+}
+
+static void fe_add(fe *r, const fe *a, const fe *b)
+{
+	u128 t = 0;
+	int i;
+	for(i = 0; i < 4; i++) {
+		t += (u128) a->v[i] + b->v[i];
+		r->v[i] = (uint64_t) t;
+		t >>= 64;
+	}
+	fe_fold(r, (uint64_t) t);
+}
+
+static void fe_sub(fe *r, const fe *a, const fe *b)
+{
+	uint64_t borrow = 0, sub;
+	int i, j;
+	for(i = 0; i < 4; i++) {
+		u128 t = (u128) a->v[i] - b->v[i] - borrow;
+		r->v[i] = (uint64_t) t;
+		borrow = (uint64_t) (t >> 127);
+	}
+	// a wrap added 2^256 = C (mod p): take C back off, once more if that wraps too
+	for(j = 0; j < 2; j++) {
+		sub = borrow * SECP256K1_C;
+		borrow = 0;
+		for(i = 0; i < 4; i++) {
+			u128 t = (u128) r->v[i] - (i == 0 ? sub : 0) - borrow;
+			r->v[i] = (uint64_t) t;
+			borrow = (uint64_t) (t >> 127);
+		}
+	}
+}
+
+static void fe_mul(fe *r, const fe *a, const fe *b)
+{
+	uint64_t t[8] = { 0 }, c;
+	u128 acc;
+	int i, j;
+
+	for(i = 0; i < 4; i++) {
+		c = 0;
+		for(j = 0; j < 4; j++) {
+			acc = (u128) a->v[i] * b->v[j] + t[i + j] + c;
+			t[i + j] = (uint64_t) acc;
+			c = (uint64_t) (acc >> 64);
+		}
+		t[i + 4] = c;
+	}
+
+	// fold the high half back in using 2^256 = C (mod p)
+	c = 0;
+	for(i = 0; i < 4; i++) {
+		acc = (u128) t[i + 4] * SECP256K1_C + t[i] + c;
+		r->v[i] = (uint64_t) acc;
+		c = (uint64_t) (acc >> 64);
+	}
+	fe_fold(r, c);
+}
+
+static void fe_mul_small(fe *r, const fe *a, uint64_t k)
+{
+	u128 t = 0;
+	int i;
+	for(i = 0; i < 4; i++) {
+		t += (u128) a->v[i] * k;
+		r->v[i] = (uint64_t) t;
+		t >>= 64;
+	}
+	fe_fold(r, (uint64_t) t);
+}
+
+/* fully reduce to [0, p) */
+static void fe_normalize(fe *r)
+{
+	fe s;
+	u128 t = SECP256K1_C;
+	uint64_t mask;
+	int i;
+	for(i = 0; i < 4; i++) {
+		t += r->v[i];
+		s.v[i] = (uint64_t) t;
+		t >>= 64;
+	}
+	// r + C overflows 2^256 exactly when r >= p, and then s = r - p
+	mask = 0 - (uint64_t) t;
+	for(i = 0; i < 4; i++) {
+		r->v[i] = (s.v[i] & mask) | (r->v[i] & ~mask);
+	}
+}
+
+static void fe_cmov(fe *r, const fe *a, uint64_t mask)
+{
+	int i;
+	for(i = 0; i < 4; i++) {
+		r->v[i] = (a->v[i] & mask) | (r->v[i] & ~mask);
+	}
+}
+
+static int fe_from_bn(fe *r, const BIGNUM *x)
+{
+	uint8_t buf[32];
+	int i, j;
+	if(BN_is_negative(x) || BN_bn2binpad(x, buf, sizeof(buf)) != sizeof(buf)) return 0;
+	for(i = 0; i < 4; i++) {
+		r->v[i] = 0;
+		for(j = 0; j < 8; j++) {
+			r->v[i] = (r->v[i] << 8) | buf[(3 - i) * 8 + j];
+		}
+	}
+	return 1;
+}
+
+static int fe_to_bn(BIGNUM *x, const fe *a)
+{
+	uint8_t buf[32];
+	fe t = *a;
+	int i, j;
+	fe_normalize(&t);
+	for(i = 0; i < 4; i++) {
+		for(j = 0; j < 8; j++) {
+			buf[(3 - i) * 8 + j] = (uint8_t) (t.v[i] >> (56 - 8 * j));
+		}
+	}
+	return BN_bin2bn(buf, sizeof(buf), x) != NULL;
+}
+
+/* complete addition, Renes-Costello-Batina algorithm 7; r may alias p or q */
+static void ge_add(ge *r, const ge *p, const ge *q)
+{
+	fe t0, t1, t2, t3, t4, X3, Y3, Z3;
+
+	fe_mul(&t0, &p->X, &q->X);
+	fe_mul(&t1, &p->Y, &q->Y);
+	fe_mul(&t2, &p->Z, &q->Z);
+	fe_add(&t3, &p->X, &p->Y);
+	fe_add(&t4, &q->X, &q->Y);
+	fe_mul(&t3, &t3, &t4);
+	fe_add(&t4, &t0, &t1);
+	fe_sub(&t3, &t3, &t4);
+	fe_add(&t4, &p->Y, &p->Z);
+	fe_add(&X3, &q->Y, &q->Z);
+	fe_mul(&t4, &t4, &X3);
+	fe_add(&X3, &t1, &t2);
+	fe_sub(&t4, &t4, &X3);
+	fe_add(&X3, &p->X, &p->Z);
+	fe_add(&Y3, &q->X, &q->Z);
+	fe_mul(&X3, &X3, &Y3);
+	fe_add(&Y3, &t0, &t2);
+	fe_sub(&Y3, &X3, &Y3);
+	fe_add(&X3, &t0, &t0);
+	fe_add(&t0, &X3, &t0);
+	fe_mul_small(&t2, &t2, SECP256K1_B3);
+	fe_add(&Z3, &t1, &t2);
+	fe_sub(&t1, &t1, &t2);
+	fe_mul_small(&Y3, &Y3, SECP256K1_B3);
+	fe_mul(&X3, &t4, &Y3);
+	fe_mul(&t2, &t3, &t1);
+	fe_sub(&X3, &t2, &X3);
+	fe_mul(&Y3, &Y3, &t0);
+	fe_mul(&t1, &t1, &Z3);
+	fe_add(&Y3, &t1, &Y3);
+	fe_mul(&t0, &t0, &t3);
+	fe_mul(&Z3, &Z3, &t4);
+	fe_add(&Z3, &Z3, &t0);
+
+	r->X = X3;
+	r->Y = Y3;
+	r->Z = Z3;
+}
+
+/* complete doubling, Renes-Costello-Batina algorithm 9; r may alias p */
+static void ge_dbl(ge *r, const ge *p)
+{
+	fe t0, t1, t2, X3, Y3, Z3;
+
+	fe_mul(&t0, &p->Y, &p->Y);
+	fe_add(&Z3, &t0, &t0);
+	fe_add(&Z3, &Z3, &Z3);
+	fe_add(&Z3, &Z3, &Z3);
+	fe_mul(&t1, &p->Y, &p->Z);
+	fe_mul(&t2, &p->Z, &p->Z);
+	fe_mul_small(&t2, &t2, SECP256K1_B3);
+	fe_mul(&X3, &t2, &Z3);
+	fe_add(&Y3, &t0, &t2);
+	fe_mul(&Z3, &t1, &Z3);
+	fe_add(&t1, &t2, &t2);
+	fe_add(&t2, &t1, &t2);
+	fe_sub(&t0, &t0, &t2);
+	fe_mul(&Y3, &t0, &Y3);
+	fe_add(&Y3, &X3, &Y3);
+	fe_mul(&t1, &p->X, &p->Y);
+	fe_mul(&X3, &t0, &t1);
+	fe_add(&X3, &X3, &X3);
+
+	r->X = X3;
+	r->Y = Y3;
+	r->Z = Z3;
+}
+
+static void ge_set_infinity(ge *r)
+{
+	memset(r, 0, sizeof(ge));
+	r->Y.v[0] = 1;
+}
+
+/* r = table[idx], reading every entry so the access pattern doesn't depend on idx */
+static void ge_lookup(ge *r, const ge *table, uint64_t idx)
+{
+	uint64_t j, mask;
+	ge_set_infinity(r);
+	for(j = 0; j < GLV_TABLE; j++) {
+		mask = 0 - (((j ^ idx) - 1) >> 63);
+		fe_cmov(&r->X, &table[j].X, mask);
+		fe_cmov(&r->Y, &table[j].Y, mask);
+		fe_cmov(&r->Z, &table[j].Z, mask);
+	}
+}
+
+/* r = a * b mod 2^256 */
+static void u256_mul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+	uint64_t t[4] = { 0 }, c;
+	u128 acc;
+	int i, j;
+	for(i = 0; i < 4; i++) {
+		c = 0;
+		for(j = 0; i + j < 4; j++) {
+			acc = (u128) a[i] * b[j] + t[i + j] + c;
+			t[i + j] = (uint64_t) acc;
+			c = (uint64_t) (acc >> 64);
+		}
+	}
+	memcpy(r, t, sizeof(t));
+}
+
+/* r = a - b mod 2^256 */
+static void u256_sub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4])
+{
+	uint64_t borrow = 0;
+	int i;
+	for(i = 0; i < 4; i++) {
+		u128 t = (u128) a[i] - b[i] - borrow;
+		r[i] = (uint64_t) t;
+		borrow = (uint64_t) (t >> 127);
+	}
+}
+
+/* r = round(k * g / 2^384), which always fits in 128 bits */
+static void u256_mul_shift384(uint64_t r[4], const uint64_t k[4], const uint64_t g[4])
+{
+	uint64_t t[8] = { 0 }, c;
+	u128 acc;
+	int i, j;
+	for(i = 0; i < 4; i++) {
+		c = 0;
+		for(j = 0; j < 4; j++) {
+			acc = (u128) k[i] * g[j] + t[i + j] + c;
+			t[i + j] = (uint64_t) acc;
+			c = (uint64_t) (acc >> 64);
+		}
+		t[i + 4] = c;
+	}
+	// round on bit 383
+	acc = (u128) t[6] + (t[5] >> 63);
+	r[0] = (uint64_t) acc;
+	r[1] = t[7] + (uint64_t) (acc >> 64);
+	r[2] = r[3] = 0;
+}
+
+/* replaces a two's complement value by its absolute value; returns an all-ones mask if it was negative */
+static uint64_t u256_abs(uint64_t r[4])
+{
+	uint64_t mask = 0 - (r[3] >> 63), carry = mask & 1;
+	int i;
+	for(i = 0; i < 4; i++) {
+		u128 t = (u128) (r[i] ^ mask) + carry;
+		r[i] = (uint64_t) t;
+		carry = (uint64_t) (t >> 64);
+	}
+	return mask;
+}
+
+/* split k (< n) into k = k1 + k2 * lambda (mod n) with |k1|, |k2| < 2^132 */
+static int glv_split(uint64_t k1[4], uint64_t k2[4], uint64_t *neg1, uint64_t *neg2, const uint64_t k[4])
+{
+	uint64_t c1[4], c2[4], t[4];
+
+	u256_mul_shift384(c1, k, glv_g1);
+	u256_mul_shift384(c2, k, glv_g2);
+
+	u256_mul(t, c1, glv_a1);
+	u256_sub(k1, k, t);
+	u256_mul(t, c2, glv_a2);
+	u256_sub(k1, k1, t);
+
+	u256_mul(k2, c1, glv_mb1);
+	u256_mul(t, c2, glv_b2);
+	u256_sub(k2, k2, t);
+
+	*neg1 = u256_abs(k1);
+	*neg2 = u256_abs(k2);
+	// the lattice bound keeps both halves near 128 bits, so this never fails in practice
+	return (k1[3] | k2[3] | ((k1[2] | k2[2]) >> (GLV_WINDOW * GLV_WINDOWS - 128))) == 0;
+}
+
+static void ge_cneg(ge *r, uint64_t mask)
+{
+	fe zero = {{ 0, 0, 0, 0 }}, neg;
+	fe_sub(&neg, &zero, &r->Y);
+	fe_cmov(&r->Y, &neg, mask);
+}
+
+/* r = k * p with k < n */
+static int ge_mul(ge *r, const ge *p, const uint64_t k[4])
+{
+	ge t1[GLV_TABLE], t2[GLV_TABLE], t;
+	uint64_t k1[4], k2[4], neg1, neg2, idx;
+	int i, j;
+
+	if(!glv_split(k1, k2, &neg1, &neg2, k)) return 0;
+
+	// multiples of p and of lambda * p = (beta * x, y), signed to match k1 and k2
+	ge_set_infinity(&t1[0]);
+	t1[1] = *p;
+	for(i = 2; i < GLV_TABLE; i++) {
+		ge_add(&t1[i], &t1[i - 1], p);
+	}
+	for(i = 0; i < GLV_TABLE; i++) {
+		t2[i] = t1[i];
+		fe_mul(&t2[i].X, &t2[i].X, &fe_beta);
+		ge_cneg(&t1[i], neg1);
+		ge_cneg(&t2[i], neg2);
+	}
+
+	ge_set_infinity(r);
+	for(i = GLV_WINDOWS - 1; i >= 0; i--) {
+		for(j = 0; j < GLV_WINDOW; j++) {
+			ge_dbl(r, r);
+		}
+		idx = (k1[(i * GLV_WINDOW) / 64] >> ((i * GLV_WINDOW) % 64)) & (GLV_TABLE - 1);
+		ge_lookup(&t, t1, idx);
+		ge_add(r, r, &t);
+		idx = (k2[(i * GLV_WINDOW) / 64] >> ((i * GLV_WINDOW) % 64)) & (GLV_TABLE - 1);
+		ge_lookup(&t, t2, idx);
+		ge_add(r, r, &t);
+	}
+	return 1;
+}
+
+int secp256k1_point_mul(const EC_GROUP *group, EC_POINT *r, const EC_POINT *P, const BIGNUM *m, BN_CTX *ctx)
+{
+	BIGNUM *x, *y, *z, *k;
+	fe X, Y, Z, ZZ, scalar;
+	ge p, q;
+	int ok = 0;
+
+	if(EC_POINT_is_at_infinity(group, P)) {
+		return EC_POINT_set_to_infinity(group, r);
+	}
+
+	BN_CTX_start(ctx);
+	x = BN_CTX_get(ctx);
+	y = BN_CTX_get(ctx);
+	z = BN_CTX_get(ctx);
+	k = BN_CTX_get(ctx);
+	if(k == NULL || !BN_nnmod(k, m, EC_GROUP_get0_order(group), ctx) ||
+	   !EC_POINT_get_Jprojective_coordinates_GFp(group, P, x, y, z, ctx) ||
+	   !fe_from_bn(&X, x) || !fe_from_bn(&Y, y) || !fe_from_bn(&Z, z) || !fe_from_bn(&scalar, k)) {
+		goto end;
+	}
+
+	// Jacobian (X, Y, Z) -> homogeneous (X * Z, Y, Z^3)
+	fe_mul(&ZZ, &Z, &Z);
+	fe_mul(&p.X, &X, &Z);
+	p.Y = Y;
+	fe_mul(&p.Z, &ZZ, &Z);
+
+	if(!ge_mul(&q, &p, scalar.v)) goto end;
+
+	// homogeneous (X, Y, Z) -> Jacobian (X * Z, Y * Z^2, Z)
+	fe_mul(&ZZ, &q.Z, &q.Z);
+	fe_mul(&X, &q.X, &q.Z);
+	fe_mul(&Y, &q.Y, &ZZ);
+	Z = q.Z;
+	fe_normalize(&Z);
+	if((Z.v[0] | Z.v[1] | Z.v[2] | Z.v[3]) == 0) {
+		ok = EC_POINT_set_to_infinity(group, r);
+	}
+	else {
+		ok = fe_to_bn(x, &X) && fe_to_bn(y, &Y) && fe_to_bn(z, &Z) &&
+			 EC_POINT_set_Jprojective_coordinates_GFp(group, r, x, y, z, ctx);
+	}
+
+end:
+	BN_CTX_end(ctx);
+	OPENSSL_cleanse(&scalar, sizeof(scalar));
+	return ok;
+}
+
+#else
+
+/* no 128-bit integer type: always use OpenSSL */
+int secp256k1_point_mul(const EC_GROUP *group, EC_POINT *r, const EC_POINT *P, const BIGNUM *m, BN_CTX *ctx)
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Charm-Crypto is a framework for rapidly prototyping cryptosystems.
+ *
+ * Charm-Crypto is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Charm-Crypto is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Charm-Crypto. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Please contact the charm-crypto dev team at support@charm-crypto.com
+ * for any questions.
+ */
+
+/*
+ *   @file    ec_secp256k1.h
+ *
+ *   @brief   native scalar multiplication on secp256k1
+ *
+ ************************************************************************/
+
+#ifndef EC_SECP256K1_H
+#define EC_SECP256K1_H
+
+#include <openssl/ec.h>
+#include <openssl/bn.h>
+
+/* r = m * P on secp256k1 (group must be NID_secp256k1). Runs in constant time with
+ * 4x64-bit limbs, complete addition formulas and the GLV endomorphism.
+ * Returns 1 on success and 0 if the caller should fall back to EC_POINT_mul. */
+int secp256k1_point_mul(const EC_GROUP *group, EC_POINT *r, const EC_POINT *P, const BIGNUM *m, BN_CTX *ctx);
+
+#endif
@@ -29,6 +29,48 @@
 
 #include "ecmodule.h"
 
+/* BN_CTX scratch space isn't thread safe, so every OS thread gets its own */
+static pthread_key_t bn_ctx_key;
+static pthread_once_t bn_ctx_key_once = PTHREAD_ONCE_INIT;
+
+static void bn_ctx_release(void *ctx)
+{
+	BN_CTX_free((BN_CTX *) ctx);
+}
+
+static void bn_ctx_make_key(void)
+{
+	pthread_key_create(&bn_ctx_key, bn_ctx_release);
+}
+
+BN_CTX *thread_bn_ctx(void)
+{
+	BN_CTX *ctx;
+	pthread_once(&bn_ctx_key_once, bn_ctx_make_key);
+	ctx = (BN_CTX *) pthread_getspecific(bn_ctx_key);
+	if(ctx == NULL) {
+		ctx = BN_CTX_new();
+		pthread_setspecific(bn_ctx_key, ctx);
+	}
+	return ctx;
+}
+
+/* r = uniformly random in [0, range), drawn from the thread's generator by rejection */
+static int bn_rand_below(BIGNUM *r, const BIGNUM *range)
+{
+	int bits = BN_num_bits(range), len = (bits + 7) / 8, ok;
+	uint8_t buf[MAX_BUF];
+
+	if(bits == 0 || len > MAX_BUF) return FALSE;
+	do {
+		ok = drbg_bytes(buf, len);
+		buf[0] &= 0xff >> (8 * len - bits);
+		BN_bin2bn(buf, len, r);
+	} while(ok && BN_cmp(r, range) >= 0);
+	OPENSSL_cleanse(buf, len);
+	return ok;
+}
+
 void printf_buffer_as_hex(uint8_t * data, size_t len)
 {
 #ifdef DEBUG
@@ -145,6 +187,8 @@ ECElement *createNewPoint(GroupType type, ECGroup *gobj) {
 		newObj->elemZ = NULL;
 	}
 	newObj->point_init = TRUE;
+	newObj->pp_group = NULL;
+	newObj->is_gen = FALSE;
 	newObj->group = gobj; // gobj->group
 	Py_INCREF(newObj->group);
 	return newObj;
@@ -160,6 +204,7 @@ void ECElement_dealloc(ECElement* self) {
 	/* clear structure */
 	if(self->point_init && self->type == G)  { debug("clearing ec point.\n"); EC_POINT_free(self->P);    }
 	if(self->point_init && self->type == ZR) { debug("clearing ec zr element.\n"); BN_free(self->elemZ); }
+	if(self->pp_group != NULL) { EC_GROUP_free(self->pp_group); }
 	Py_XDECREF(self->group);
 	Py_TYPE(self)->tp_free((PyObject*)self);
 }
@@ -176,6 +221,8 @@ PyObject *ECElement_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
     	self->P = NULL;
     	self->elemZ = NULL;
     	self->point_init = FALSE;
+    	self->pp_group = NULL;
+    	self->is_gen = FALSE;
     }
     return (PyObject *) self;
 }
@@ -187,7 +234,8 @@ void ECGroup_dealloc(ECGroup *self)
 		debug("clearing ec group struct.\n");
 		EC_GROUP_clear_free(self->ec_group);
 		BN_free(self->order);
-		BN_CTX_free(self->ctx);
+		if(self->mont != NULL) BN_MONT_CTX_free(self->mont);
+		sswu_consts_free(self->sswu);
 		self->group_init = FALSE;
 		Py_END_ALLOW_THREADS;
 	}
@@ -212,7 +260,8 @@ PyObject *ECGroup_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 		self->nid        = -1;
 		self->ec_group   = NULL;
 		self->order		 = BN_new();
-    	self->ctx        = BN_CTX_new();
+		self->mont		 = NULL;
+		self->sswu		 = NULL;
 #ifdef BENCHMARK_ENABLED
 		memset(self->bench_id, 0, ID_LEN);
 		self->dBench = NULL;
@@ -249,7 +298,7 @@ int ECGroup_init(ECGroup *self, PyObject *args, PyObject *kwds)
     setBigNum((PyLongObject *) pObj, &p);
 
     // make sure p is prime then continue loading a and b parameters for EC
-    if(BN_is_prime_ex(p, BN_prime_checks, self->ctx, NULL) != 1) {
+    if(BN_is_prime_ex(p, BN_prime_checks, thread_bn_ctx(), NULL) != 1) {
       debug("p is not prime.\n");
       BN_free(p);
       PyErr_SetString(PyECErrorObject, "p must be a prime integer.");
@@ -264,7 +313,7 @@ int ECGroup_init(ECGroup *self, PyObject *args, PyObject *kwds)
     debug("a (bn) is now '%s'\n", BN_bn2dec(a));
     debug("b (bn) is now '%s'\n", BN_bn2dec(b));
     // now we can instantiate the ec_group
-    self->ec_group = EC_GROUP_new_curve_GFp(p, a, b, self->ctx);
+    self->ec_group = EC_GROUP_new_curve_GFp(p, a, b, thread_bn_ctx());
     if(!self->ec_group) {
       EC_GROUP_free(self->ec_group);
       PyErr_SetString(PyECErrorObject, "could not initialize ec group.");
@@ -292,7 +341,7 @@ int ECGroup_init(ECGroup *self, PyObject *args, PyObject *kwds)
 		printf("OK!\n");
 #endif
     debug("ec group check...\n");
-    if(!EC_GROUP_check(self->ec_group, self->ctx)) {
+    if(!EC_GROUP_check(self->ec_group, thread_bn_ctx())) {
         EC_GROUP_free(self->ec_group);
         PyErr_SetString(PyECErrorObject, "group check failed, try another curve.");
         return -1;
@@ -308,7 +357,19 @@ int ECGroup_init(ECGroup *self, PyObject *args, PyObject *kwds)
   }
 
   // obtain the order of the elliptic curve and store in group object
-  EC_GROUP_get_order(self->ec_group, self->order, self->ctx);
+  EC_GROUP_get_order(self->ec_group, self->order, thread_bn_ctx());
+  // cache the Montgomery form of the order, reused by every ZR mul and exp
+  if(self->mont == NULL && BN_is_odd(self->order)) {
+    self->mont = BN_MONT_CTX_new();
+    if(self->mont != NULL && !BN_MONT_CTX_set(self->mont, self->order, thread_bn_ctx())) {
+      BN_MONT_CTX_free(self->mont);
+      self->mont = NULL;
+    }
+  }
+  // multiples of the generator (some curves, e.g. P-256, ship with a static table)
+  if(EC_GROUP_get0_generator(self->ec_group) != NULL && !EC_GROUP_have_precompute_mult(self->ec_group)) {
+    EC_GROUP_precompute_mult(self->ec_group, thread_bn_ctx());
+  }
   self->group_init = TRUE;
   return 0;
 }
@@ -322,7 +383,7 @@ PyObject *ECGroup_print(ECGroup *self) {
 	if(!self->group_init)
 		return PyUnicode_FromString("");
 	BIGNUM *p = BN_new(), *a = BN_new(), *b = BN_new();
-	EC_GROUP_get_curve_GFp(self->ec_group, p, a, b, self->ctx);
+	EC_GROUP_get_curve_GFp(self->ec_group, p, a, b, thread_bn_ctx());
 
 	const char *id;
 	if(self->nid == -1) id = "custom";
@@ -356,7 +417,7 @@ PyObject *ECElement_print(ECElement *self) {
     VERIFY_GROUP(self->group);
 
     BIGNUM *x = BN_new(), *y = BN_new();
-    EC_POINT_get_affine_coordinates_GFp(self->group->ec_group, self->P, x, y, self->group->ctx);
+    EC_POINT_get_affine_coordinates_GFp(self->group->ec_group, self->P, x, y, thread_bn_ctx());
     char *xstr = BN_bn2dec(x);
     char *ystr = BN_bn2dec(y);
     //debug("P -> x = %s\n", xstr);
@@ -392,7 +453,7 @@ PyObject *ECE_init(ECElement *self, PyObject *args) {
       if(long_obj != NULL) {
         if (_PyLong_Check(long_obj)) {
           setBigNum((PyLongObject *) long_obj, &obj->elemZ);
-          BN_mod(obj->elemZ, obj->elemZ, gobj->order, gobj->ctx);
+          BN_mod(obj->elemZ, obj->elemZ, gobj->order, thread_bn_ctx());
         } else {
           EXIT_IF(TRUE, "expecting a number (int or long)");
         }
@@ -426,9 +487,14 @@ PyObject *ECE_random(ECElement *self, PyObject *args)
 			//START_CLOCK(dBench);
 			do {
 				// generate random point
-				BN_rand_range(x, gobj->order);
-				EC_POINT_set_compressed_coordinates_GFp(gobj->ec_group, objG->P, x, 1, gobj->ctx);
-				EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, objG->P, x, y, gobj->ctx);
+				if(!bn_rand_below(x, gobj->order)) {
+					BN_free(x);
+					BN_free(y);
+					Py_DECREF(objG);
+					EXIT_IF(TRUE, "failed to seed the random generator.");
+				}
+				EC_POINT_set_compressed_coordinates_GFp(gobj->ec_group, objG->P, x, 1, thread_bn_ctx());
+				EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, objG->P, x, y, thread_bn_ctx());
 				// make sure point is on curve and not zero
 
 				if(BN_is_zero(x) || BN_is_zero(y)) {
@@ -436,7 +502,7 @@ PyObject *ECE_random(ECElement *self, PyObject *args)
 					continue;
 				}
 
-				if(EC_POINT_is_on_curve(gobj->ec_group, objG->P, gobj->ctx)) {
+				if(EC_POINT_is_on_curve(gobj->ec_group, objG->P, thread_bn_ctx())) {
 					FindAnotherPoint = FALSE;
 				}
 //				char *xstr = BN_bn2dec(x);
@@ -454,7 +520,10 @@ PyObject *ECE_random(ECElement *self, PyObject *args)
 		}
 		else if(type == ZR) {
 			ECElement *objZR = createNewPoint(ZR, gobj);
-			BN_rand_range(objZR->elemZ, gobj->order);
+			if(!bn_rand_below(objZR->elemZ, gobj->order)) {
+				Py_DECREF(objZR);
+				EXIT_IF(TRUE, "failed to seed the random generator.");
+			}
 
 			return (PyObject *) objZR;
 		}
@@ -468,6 +537,102 @@ PyObject *ECE_random(ECElement *self, PyObject *args)
 	EXIT_IF(TRUE, "invalid argument.");
 }
 
+/*
+ * ans = base ^ m. Uses the table built by initPP() if there is one, and the group's generator
+ * table when base came from generator(). Doesn't touch any python object, so it can run without the GIL.
+ */
+void point_mul(ECElement *ans, ECElement *base, const BIGNUM *m)
+{
+	EC_GROUP *group = base->group->ec_group;
+	BN_CTX *ctx = thread_bn_ctx();
+
+	if(base->pp_group != NULL) {
+		EC_POINT_mul(base->pp_group, ans->P, m, NULL, NULL, ctx);
+	}
+	else if(base->is_gen) {
+		EC_POINT_mul(group, ans->P, m, NULL, NULL, ctx);
+	}
+	// OpenSSL has no specialized method for secp256k1, so that curve tries the native GLV code first
+	else if(base->group->nid != NID_secp256k1 || !secp256k1_point_mul(group, ans->P, base->P, m, ctx)) {
+		EC_POINT_mul(group, ans->P, NULL, base->P, m, ctx);
+	}
+}
+
+/* r = a * b mod order. Two Montgomery products with the cached context are cheaper than
+ * BN_mod_mul's full division, but they need reduced operands: anything else (e.g. a raw
+ * Python integer) takes the generic path. */
+void zr_mod_mul(BIGNUM *r, const BIGNUM *a, const BIGNUM *b, ECGroup *group)
+{
+	BN_CTX *ctx = thread_bn_ctx();
+	BIGNUM *t;
+
+	if(group->mont == NULL || BN_is_negative(a) || BN_is_negative(b) ||
+	   BN_ucmp(a, group->order) >= 0 || BN_ucmp(b, group->order) >= 0) {
+		BN_mod_mul(r, a, b, group->order, ctx);
+		return;
+	}
+
+	BN_CTX_start(ctx);
+	t = BN_CTX_get(ctx);
+	// aR^-1 * (bR) = ab mod order
+	if(t == NULL || !BN_to_montgomery(t, b, group->mont, ctx) ||
+	   !BN_mod_mul_montgomery(r, a, t, group->mont, ctx)) {
+		BN_mod_mul(r, a, b, group->order, ctx);
+	}
+	BN_CTX_end(ctx);
+}
+
+/* r = a ^ e mod order without rebuilding the Montgomery context on every call */
+void zr_mod_exp(BIGNUM *r, const BIGNUM *a, const BIGNUM *e, ECGroup *group)
+{
+	if(group->mont != NULL && !BN_is_negative(e)) {
+		BN_mod_exp_mont(r, a, e, group->order, thread_bn_ctx(), group->mont);
+	}
+	else {
+		BN_mod_exp(r, a, e, group->order, thread_bn_ctx());
+	}
+}
+
+static PyObject *ECE_initPP(ECElement *self, PyObject *args) {
+
+	Point_Init(self);
+	EXIT_IF(self->type != G, "element not of type G.");
+	if(self->pp_group != NULL) {
+		PyErr_SetString(PyExc_ValueError, "Pre-processing table alreay initialized.");
+		return NULL;
+	}
+	if(EC_POINT_is_at_infinity(self->group->ec_group, self->P)) {
+		Py_RETURN_FALSE;
+	}
+
+	EC_GROUP *group = self->group->ec_group;
+	EC_GROUP *pp_group = EC_GROUP_dup(group);
+	BIGNUM *cofactor = BN_new();
+	int result = FALSE;
+
+	Py_BEGIN_ALLOW_THREADS
+	if(pp_group != NULL && EC_GROUP_get_cofactor(group, cofactor, thread_bn_ctx()) &&
+	   EC_GROUP_set_generator(pp_group, self->P, self->group->order, cofactor) &&
+	   EC_GROUP_precompute_mult(pp_group, thread_bn_ctx())) {
+		result = TRUE;
+	}
+	Py_END_ALLOW_THREADS
+	BN_free(cofactor);
+
+	if(result == FALSE) {
+		EC_GROUP_free(pp_group);
+		EXIT_IF(TRUE, "could not build the pre-processing table.");
+	}
+	// another thread may have stored a table while this one was building
+	if(self->pp_group != NULL) {
+		EC_GROUP_free(pp_group);
+		PyErr_SetString(PyExc_ValueError, "Pre-processing table alreay initialized.");
+		return NULL;
+	}
+	self->pp_group = pp_group;
+	Py_RETURN_TRUE;
+}
+
 static PyObject *ECE_is_infinity(ECElement *self, PyObject *args) {
 
 	Point_Init(self);
@@ -495,7 +660,7 @@ static PyObject *ECE_add(PyObject *o1, PyObject *o2) {
 			BIGNUM *lhs_val = BN_new();
 			setBigNum((PyLongObject *) o1, &lhs_val);
 			ans = createNewPoint(ZR, rhs->group);
-			BN_mod_add(ans->elemZ, lhs_val, rhs->elemZ, ans->group->order, ans->group->ctx);
+			BN_mod_add(ans->elemZ, lhs_val, rhs->elemZ, ans->group->order, thread_bn_ctx());
 			BN_free(lhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(ADDITION, ans->type, ans->group);
@@ -510,7 +675,7 @@ static PyObject *ECE_add(PyObject *o1, PyObject *o2) {
 			BIGNUM *rhs_val = BN_new();
 			setBigNum((PyLongObject *) o2, &rhs_val);
 			ans = createNewPoint(ZR, lhs->group); // ->group, lhs->ctx);
-			BN_mod_add(ans->elemZ, lhs->elemZ, rhs_val, ans->group->order, ans->group->ctx);
+			BN_mod_add(ans->elemZ, lhs->elemZ, rhs_val, ans->group->order, thread_bn_ctx());
 			BN_free(rhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(ADDITION, ans->type, ans->group);
@@ -527,7 +692,7 @@ static PyObject *ECE_add(PyObject *o1, PyObject *o2) {
 			IS_SAME_GROUP(lhs, rhs);
 			// easy, just call BN_add
 			ans = createNewPoint(ZR, lhs->group);
-			BN_mod_add(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->order, ans->group->ctx);
+			BN_mod_add(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->order, thread_bn_ctx());
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(ADDITION, ans->type, ans->group);
 #endif
@@ -561,7 +726,7 @@ static PyObject *ECE_sub(PyObject *o1, PyObject *o2) {
 			BIGNUM *lhs_val = BN_new();
 			setBigNum((PyLongObject *) o1, &lhs_val);
 			ans = createNewPoint(ZR, rhs->group); // ->group, rhs->ctx);
-			BN_mod_sub(ans->elemZ, lhs_val, rhs->elemZ, ans->group->order, ans->group->ctx);
+			BN_mod_sub(ans->elemZ, lhs_val, rhs->elemZ, ans->group->order, thread_bn_ctx());
 			BN_free(lhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(SUBTRACTION, ans->type, ans->group);
@@ -577,7 +742,7 @@ static PyObject *ECE_sub(PyObject *o1, PyObject *o2) {
 			BIGNUM *rhs_val = BN_new();
 			setBigNum((PyLongObject *) o2, &rhs_val);
 			ans = createNewPoint(ZR, lhs->group);
-			BN_mod_sub(ans->elemZ, lhs->elemZ, rhs_val, ans->group->order, ans->group->ctx);
+			BN_mod_sub(ans->elemZ, lhs->elemZ, rhs_val, ans->group->order, thread_bn_ctx());
 			BN_free(rhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(SUBTRACTION, ans->type, ans->group);
@@ -593,7 +758,7 @@ static PyObject *ECE_sub(PyObject *o1, PyObject *o2) {
 		if(ElementZR(lhs, rhs)) {
 			IS_SAME_GROUP(lhs, rhs);
 			ans = createNewPoint(ZR, lhs->group);
-			BN_mod_sub(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->order, ans->group->ctx);
+			BN_mod_sub(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->order, thread_bn_ctx());
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(SUBTRACTION, ans->type, ans->group);
 #endif
@@ -623,7 +788,7 @@ static PyObject *ECE_mul(PyObject *o1, PyObject *o2) {
 			BIGNUM *lhs_val = BN_new();
 			setBigNum((PyLongObject *) o1, &lhs_val);
 			ans = createNewPoint(ZR, rhs->group);
-			BN_mod_mul(ans->elemZ, lhs_val, rhs->elemZ, ans->group->order, ans->group->ctx);
+			zr_mod_mul(ans->elemZ, lhs_val, rhs->elemZ, ans->group);
 			BN_free(lhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(MULTIPLICATION, ans->type, ans->group);
@@ -639,7 +804,7 @@ static PyObject *ECE_mul(PyObject *o1, PyObject *o2) {
 			BIGNUM *rhs_val = BN_new();
 			setBigNum((PyLongObject *) o2, &rhs_val);
 			ans = createNewPoint(ZR, lhs->group); // ->group, lhs->ctx);
-			BN_mod_mul(ans->elemZ, lhs->elemZ, rhs_val, ans->group->order, ans->group->ctx);
+			zr_mod_mul(ans->elemZ, lhs->elemZ, rhs_val, ans->group);
 			BN_free(rhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(MULTIPLICATION, ans->type, ans->group);
@@ -655,11 +820,13 @@ static PyObject *ECE_mul(PyObject *o1, PyObject *o2) {
 
 		if(ElementG(lhs, rhs)) {
 			ans = createNewPoint(G, lhs->group);
-			EC_POINT_add(ans->group->ec_group, ans->P, lhs->P, rhs->P, ans->group->ctx);
+			Py_BEGIN_ALLOW_THREADS
+			EC_POINT_add(ans->group->ec_group, ans->P, lhs->P, rhs->P, thread_bn_ctx());
+			Py_END_ALLOW_THREADS
 		}
 		else if(ElementZR(lhs, rhs)) {
 			ans = createNewPoint(ZR, lhs->group);
-			BN_mod_mul(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->order, ans->group->ctx);
+			zr_mod_mul(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group);
 		}
 		else {
 
@@ -692,7 +859,7 @@ static PyObject *ECE_div(PyObject *o1, PyObject *o2) {
 			rm = BN_new();
 			setBigNum((PyLongObject *) o1, &lhs_val);
 			ans = createNewPoint(ZR, rhs->group);
-			BN_div(ans->elemZ, rm, lhs_val, rhs->elemZ, ans->group->ctx);
+			BN_div(ans->elemZ, rm, lhs_val, rhs->elemZ, thread_bn_ctx());
 			BN_free(lhs_val);
 			BN_free(rm);
 #ifdef BENCHMARK_ENABLED
@@ -710,7 +877,7 @@ static PyObject *ECE_div(PyObject *o1, PyObject *o2) {
 			rm = BN_new();
 			setBigNum((PyLongObject *) o2, &rhs_val);
 			ans = createNewPoint(ZR, lhs->group); // ->group, lhs->ctx);
-			BN_div(ans->elemZ, rm, lhs->elemZ, rhs_val, ans->group->ctx);
+			BN_div(ans->elemZ, rm, lhs->elemZ, rhs_val, thread_bn_ctx());
 			BN_free(rhs_val);
 			BN_free(rm);
 #ifdef BENCHMARK_ENABLED
@@ -729,14 +896,16 @@ static PyObject *ECE_div(PyObject *o1, PyObject *o2) {
 			ECElement *rhs_neg = negatePoint(rhs);
 			if(rhs_neg != NULL) {
 				ans = createNewPoint(G, lhs->group);
-				EC_POINT_add(ans->group->ec_group, ans->P, lhs->P, rhs_neg->P, ans->group->ctx);
+				Py_BEGIN_ALLOW_THREADS
+				EC_POINT_add(ans->group->ec_group, ans->P, lhs->P, rhs_neg->P, thread_bn_ctx());
+				Py_END_ALLOW_THREADS
 			}
 			Py_DECREF(rhs_neg);
 		}
 		else if(ElementZR(lhs, rhs)) {
 			ans = createNewPoint(ZR, lhs->group);
 			rm = BN_new();
-			BN_div(ans->elemZ, rm, lhs->elemZ, rhs->elemZ, ans->group->ctx);
+			BN_div(ans->elemZ, rm, lhs->elemZ, rhs->elemZ, thread_bn_ctx());
 			BN_free(rm);
 		}
 		else {
@@ -767,7 +936,7 @@ static PyObject *ECE_rem(PyObject *o1, PyObject *o2) {
 			BIGNUM *lhs_val = BN_new();
 			setBigNum((PyLongObject *) o1, &lhs_val);
 			ans = createNewPoint(ZR, rhs->group);
-			BN_mod(ans->elemZ, lhs_val, rhs->elemZ, ans->group->ctx);
+			BN_mod(ans->elemZ, lhs_val, rhs->elemZ, thread_bn_ctx());
 			BN_free(lhs_val);
 
 			return (PyObject *) ans;
@@ -781,7 +950,7 @@ static PyObject *ECE_rem(PyObject *o1, PyObject *o2) {
 			BIGNUM *rhs_val = BN_new();
 			setBigNum((PyLongObject *) o2, &rhs_val);
 			ans = createNewPoint(ZR, lhs->group);
-			BN_mod(ans->elemZ, lhs->elemZ, rhs_val, ans->group->ctx);
+			BN_mod(ans->elemZ, lhs->elemZ, rhs_val, thread_bn_ctx());
 			BN_free(rhs_val);
 			return (PyObject *) ans;
 		}
@@ -793,7 +962,7 @@ static PyObject *ECE_rem(PyObject *o1, PyObject *o2) {
 		if(ElementZR(lhs, rhs)) {
 			ans = createNewPoint(ZR, lhs->group);
 			// reall calls BN_div with the dv se to NULL.
-			BN_mod(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->ctx);
+			BN_mod(ans->elemZ, lhs->elemZ, rhs->elemZ, thread_bn_ctx());
 			return (PyObject *) ans;
 		}
 		else {
@@ -818,7 +987,9 @@ static PyObject *ECE_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 			BIGNUM *lhs_val = BN_new();
 			setBigNum((PyLongObject *) o1, &lhs_val);
 			ans = createNewPoint(ZR, rhs->group);
-			BN_mod_exp(ans->elemZ, lhs_val, rhs->elemZ, ans->group->order, ans->group->ctx);
+			Py_BEGIN_ALLOW_THREADS
+			zr_mod_exp(ans->elemZ, lhs_val, rhs->elemZ, ans->group);
+			Py_END_ALLOW_THREADS
 			BN_free(lhs_val);
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCH(EXPONENTIATION, ans->type, ans->group);
@@ -839,7 +1010,9 @@ static PyObject *ECE_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 					setBigNum((PyLongObject *) o2, &rhs_val);
 
 					ans = createNewPoint(ZR, lhs->group);
-					BN_mod_exp(ans->elemZ, lhs->elemZ, rhs_val, ans->group->order, ans->group->ctx);
+					Py_BEGIN_ALLOW_THREADS
+					zr_mod_exp(ans->elemZ, lhs->elemZ, rhs_val, ans->group);
+					Py_END_ALLOW_THREADS
 					BN_free(rhs_val);
 			}
 			else if(rhs == -1) {
@@ -858,7 +1031,9 @@ static PyObject *ECE_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 					BIGNUM *rhs_val = BN_new();
 					setBigNum((PyLongObject *) o2, &rhs_val);
 					ans = createNewPoint(G, lhs->group); // ->group, lhs->ctx);
-					EC_POINT_mul(ans->group->ec_group, ans->P, NULL, lhs->P, rhs_val, ans->group->ctx);
+					Py_BEGIN_ALLOW_THREADS
+					point_mul(ans, lhs, rhs_val);
+					Py_END_ALLOW_THREADS
 					BN_free(rhs_val);
 			}
 			else if(rhs == -1) {
@@ -885,11 +1060,15 @@ static PyObject *ECE_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 
 		if(lhs->type == G && rhs->type == ZR) {
 			ans = createNewPoint(G, lhs->group);
-			EC_POINT_mul(ans->group->ec_group, ans->P, NULL, lhs->P, rhs->elemZ, ans->group->ctx);
+			Py_BEGIN_ALLOW_THREADS
+			point_mul(ans, lhs, rhs->elemZ);
+			Py_END_ALLOW_THREADS
 		}
 		else if(ElementZR(lhs, rhs)) {
 			ans = createNewPoint(ZR, lhs->group);
-			BN_mod_exp(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group->order, ans->group->ctx);
+			Py_BEGIN_ALLOW_THREADS
+			zr_mod_exp(ans->elemZ, lhs->elemZ, rhs->elemZ, ans->group);
+			Py_END_ALLOW_THREADS
 		}
 		else {
 
@@ -910,14 +1089,17 @@ ECElement *invertECElement(ECElement *self) {
 	if(self->type == G) {
 		newObj = createNewPoint(G, self->group); // ->group, self->ctx);
 		EC_POINT_copy(newObj->P, self->P);
-		if(EC_POINT_invert(newObj->group->ec_group, newObj->P, newObj->group->ctx)) {
+		if(EC_POINT_invert(newObj->group->ec_group, newObj->P, thread_bn_ctx())) {
 			return newObj;
 		}
 		Py_XDECREF(newObj);
 	}
 	else if(self->type == ZR) {
 		// get modulus and compute mod_inverse
-		BIGNUM *x = BN_mod_inverse(NULL, self->elemZ, self->group->order, self->group->ctx);
+		BIGNUM *x = NULL;
+		Py_BEGIN_ALLOW_THREADS
+		x = BN_mod_inverse(NULL, self->elemZ, self->group->order, thread_bn_ctx());
+		Py_END_ALLOW_THREADS
 		if(x != NULL) {
 			newObj = createNewPoint(ZR, self->group);
 			BN_copy(newObj->elemZ, x);
@@ -954,14 +1136,14 @@ ECElement *negatePoint(ECElement *self) {
 	ECElement *newObj = NULL;
 
 	BIGNUM *x = BN_new(), *y = BN_new();
-	EC_POINT_get_affine_coordinates_GFp(self->group->ec_group, self->P, x, y, self->group->ctx);
+	EC_POINT_get_affine_coordinates_GFp(self->group->ec_group, self->P, x, y, thread_bn_ctx());
 	BN_set_negative(y, TRUE);
 
 	newObj = createNewPoint(G, self->group);
-	EC_POINT_set_affine_coordinates_GFp(newObj->group->ec_group, newObj->P, x, y, newObj->group->ctx);
+	EC_POINT_set_affine_coordinates_GFp(newObj->group->ec_group, newObj->P, x, y, thread_bn_ctx());
 	BN_free(x);
 	BN_free(y);
-	if(EC_POINT_is_on_curve(newObj->group->ec_group, newObj->P, newObj->group->ctx)) {
+	if(EC_POINT_is_on_curve(newObj->group->ec_group, newObj->P, thread_bn_ctx())) {
 		return newObj;
 	}
 	/* error */
@@ -1033,7 +1215,7 @@ static PyObject *ECE_convertToZR(ECElement *self, PyObject *args) {
 			Point_Init(obj);
 			if(obj->type == G) {
 				BIGNUM *x = BN_new(), *y = BN_new();
-				EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, obj->P, x, y, gobj->ctx);
+				EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, obj->P, x, y, thread_bn_ctx());
 				if(PyBool_Check(retXY)) {
 					// see if retXY is Py_True or Py_False
 					if(retXY == Py_True) {
@@ -1128,7 +1310,7 @@ static PyObject *ECE_equals(PyObject *o1, PyObject *o2, int opid) {
 //		Point_Init(rhs)
 
 		if(ElementG(lhs, rhs)) {
-			if(EC_POINT_cmp(lhs->group->ec_group, lhs->P, rhs->P, lhs->group->ctx) == 0) {
+			if(EC_POINT_cmp(lhs->group->ec_group, lhs->P, rhs->P, thread_bn_ctx()) == 0) {
 				if(opid == Py_EQ) result = TRUE;
 			}
 			else if(opid == Py_NE) result = TRUE;
@@ -1162,6 +1344,7 @@ static PyObject *ECE_getGen(ECElement *self, PyObject *arg) {
 		ECElement *genObj = createNewPoint(G, gobj);
 		const EC_POINT *gen = EC_GROUP_get0_generator(gobj->ec_group);
 		EC_POINT_copy(genObj->P, gen);
+		genObj->is_gen = TRUE;
 
 		return (PyObject *) genObj;
 	}
@@ -1179,7 +1362,7 @@ void set_element_from_hash(ECElement *self, uint8_t *input, int input_len)
 
 	BIGNUM *x = BN_new(), *y = BN_new();
 	int TryNextX = TRUE;
-	BN_CTX *ctx = BN_CTX_new();
+	BN_CTX *ctx = thread_bn_ctx();
 	ECGroup *gobj = self->group;
 	// assume input string is a binary string, then set x to (x mod q)
 	BN_bin2bn((const uint8_t *) input, input_len, x);
@@ -1209,7 +1392,6 @@ void set_element_from_hash(ECElement *self, uint8_t *input, int input_len)
 
 	BN_free(x);
 	BN_free(y);
-	BN_CTX_free(ctx);
 }
 
 static PyObject *ECE_hash(ECElement *self, PyObject *args) {
@@ -1257,6 +1439,548 @@ static PyObject *ECE_hash(ECElement *self, PyObject *args) {
 	EXIT_IF(TRUE, "invalid arguments");
 }
 
+/*
+ * RFC 9380 hash-to-curve (hash_to_curve, random oracle variant) using the simplified SWU map.
+ * Only curves with a registered suite are supported since Z (and for secp256k1 the 3-isogeny)
+ * are fixed per curve. All suite curves have p = 3 mod 4 and cofactor 1.
+ */
+static const char *secp256k1_iso_a = "3F8731ABDD661ADCA08A5558F0F5D272E953D363CB6F0E5D405447C01A444533";
+static const char *secp256k1_iso_b = "6EB";
+/* 3-isogeny map constants k_(i,j) from RFC 9380 appendix E.1 */
+static const char *secp256k1_iso_k[4][4] = {
+	{ "8E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38DAAAAA8C7",
+	  "07D3D4C80BC321D5B9F315CEA7FD44C5D595D2FC0BF63B92DFFF1044F17C6581",
+	  "534C328D23F234E6E2A413DECA25CAECE4506144037C40314ECBD0B53D9DD262",
+	  "8E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38E38DAAAAA88C" },
+	{ "D35771193D94918A9CA34CCBB7B640DD86CD409542F8487D9FE6B745781EB49B",
+	  "EDADC6F64383DC1DF7C4B2D51B54225406D36B641F5E41BBC52A56612A8C6D14",
+	  "1", NULL },
+	{ "4BDA12F684BDA12F684BDA12F684BDA12F684BDA12F684BDA12F684B8E38E23C",
+	  "C75E0C32D5CB7C0FA9D0A54B12A0A6D5647AB046D686DA6FDFFC90FC201D71A3",
+	  "29A6194691F91A73715209EF6512E576722830A201BE2018A765E85A9ECEE931",
+	  "2F684BDA12F684BDA12F684BDA12F684BDA12F684BDA12F684BDA12F38E38D84" },
+	{ "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFF93B",
+	  "7A06534BB8BDB49FD5E9E6632722C2989467C1BFC8E8D978DFB425D2685C2573",
+	  "6484AA716545CA2CF3A70C3FA8FE337E0A3D21162F0D6299A7BF8192BFD2A76F",
+	  "1" },
+};
+
+static const SSWUSuite sswu_suites[] = {
+	{ NID_X9_62_prime256v1, "P256", "SHA-256", -10, 48, FALSE },
+	{ NID_secp384r1, "P384", "SHA-384", -12, 72, FALSE },
+	{ NID_secp521r1, "P521", "SHA-512", -4, 98, FALSE },
+	{ NID_secp256k1, "secp256k1", "SHA-256", -11, 48, TRUE },
+	{ 0, NULL, NULL, 0, 0, FALSE }
+};
+
+const SSWUSuite *get_sswu_suite(int nid)
+{
+	int i;
+	for(i = 0; sswu_suites[i].name != NULL; i++) {
+		if(sswu_suites[i].nid == nid) return &sswu_suites[i];
+	}
+	return NULL;
+}
+
+static const EVP_MD *sswu_md(const SSWUSuite *suite)
+{
+	if(strcmp(suite->hash_name, "SHA-384") == 0) return EVP_sha384();
+	if(strcmp(suite->hash_name, "SHA-512") == 0) return EVP_sha512();
+	return EVP_sha256();
+}
+
+/*
+ * expand_message_xmd (RFC 9380 section 5.3.1).
+ * @return TRUE on success, FALSE if the requested lengths are out of range.
+ */
+int expand_message_xmd(const EVP_MD *md, const uint8_t *msg, int msg_len, const uint8_t *dst, int dst_len, uint8_t *output, int output_len)
+{
+	int b_len = EVP_MD_size(md), r_len = EVP_MD_block_size(md);
+	int ell = (output_len + b_len - 1) / b_len, i, j;
+	uint8_t b0[EVP_MAX_MD_SIZE], bi[EVP_MAX_MD_SIZE], tmp[EVP_MAX_MD_SIZE];
+	uint8_t z_pad[r_len], lib_str[3], dst_len_byte, idx;
+	unsigned int md_len;
+
+	if(ell > 255 || output_len > 65535 || dst_len > 255) return FALSE;
+	memset(z_pad, 0, r_len);
+	lib_str[0] = (uint8_t) (output_len >> 8);
+	lib_str[1] = (uint8_t) (output_len & 0xff);
+	lib_str[2] = 0;
+	dst_len_byte = (uint8_t) dst_len;
+
+	EVP_MD_CTX *mdctx = EVP_MD_CTX_create();
+	if(mdctx == NULL) return FALSE;
+	// b_0 = H(Z_pad || msg || l_i_b_str || I2OSP(0, 1) || DST_prime)
+	EVP_DigestInit_ex(mdctx, md, NULL);
+	EVP_DigestUpdate(mdctx, z_pad, r_len);
+	EVP_DigestUpdate(mdctx, msg, msg_len);
+	EVP_DigestUpdate(mdctx, lib_str, 3);
+	EVP_DigestUpdate(mdctx, dst, dst_len);
+	EVP_DigestUpdate(mdctx, &dst_len_byte, 1);
+	EVP_DigestFinal_ex(mdctx, b0, &md_len);
+
+	memset(bi, 0, b_len);
+	for(i = 1; i <= ell; i++) {
+		// b_i = H(strxor(b_0, b_(i - 1)) || I2OSP(i, 1) || DST_prime), with b_0 || 1 for the first block
+		for(j = 0; j < b_len; j++) tmp[j] = b0[j] ^ bi[j];
+		idx = (uint8_t) i;
+		EVP_DigestInit_ex(mdctx, md, NULL);
+		EVP_DigestUpdate(mdctx, tmp, b_len);
+		EVP_DigestUpdate(mdctx, &idx, 1);
+		EVP_DigestUpdate(mdctx, dst, dst_len);
+		EVP_DigestUpdate(mdctx, &dst_len_byte, 1);
+		EVP_DigestFinal_ex(mdctx, bi, &md_len);
+		memcpy(output + (i - 1) * b_len, bi, (i < ell) ? b_len : output_len - (i - 1) * b_len);
+	}
+
+	EVP_MD_CTX_destroy(mdctx);
+	return TRUE;
+}
+
+/* per-curve values of the simplified SWU map that don't depend on the input */
+struct SSWUConsts {
+	const SSWUSuite *suite;
+	int nwords;		/* width of p in words, for BN_consttime_swap */
+	BIGNUM *p, *A, *B, *Z;
+	BIGNUM *c1;		/* -B / A */
+	BIGNUM *c2;		/* B / (Z * A), used when the denominator vanishes */
+	BIGNUM *c3;		/* sqrt(-Z) */
+	BIGNUM *e_inv;	/* p - 2 */
+	BIGNUM *e_sqrt;	/* (p + 1) / 4 */
+	BIGNUM *iso_k[4][4];	/* isogeny coefficients (NULL where unused) */
+};
+
+void sswu_consts_free(SSWUConsts *k)
+{
+	int i, j;
+	if(k == NULL) return;
+	BN_free(k->p); BN_free(k->A); BN_free(k->B); BN_free(k->Z);
+	BN_free(k->c1); BN_free(k->c2); BN_free(k->c3);
+	BN_free(k->e_inv); BN_free(k->e_sqrt);
+	for(i = 0; i < 4; i++) {
+		for(j = 0; j < 4; j++) BN_free(k->iso_k[i][j]);
+	}
+	free(k);
+}
+
+/* derives the map constants of a suite; curve values are public, so variable time is fine here */
+static SSWUConsts *sswu_consts_new(ECGroup *gobj, const SSWUSuite *suite, BN_CTX *ctx)
+{
+	SSWUConsts *k = (SSWUConsts *) calloc(1, sizeof(SSWUConsts));
+	int i, j, ok;
+
+	if(k == NULL) return NULL;
+	k->suite = suite;
+	k->p = BN_new(); k->A = BN_new(); k->B = BN_new(); k->Z = BN_new();
+	k->c1 = BN_new(); k->c2 = BN_new(); k->c3 = BN_new();
+	k->e_inv = BN_new(); k->e_sqrt = BN_new();
+	ok = k->p && k->A && k->B && k->Z && k->c1 && k->c2 && k->c3 && k->e_inv && k->e_sqrt &&
+		 EC_GROUP_get_curve_GFp(gobj->ec_group, k->p, k->A, k->B, ctx);
+	if(ok && suite->iso) {
+		// map onto the isogenous curve E' and carry the point back afterwards
+		ok = BN_hex2bn(&k->A, secp256k1_iso_a) && BN_hex2bn(&k->B, secp256k1_iso_b);
+		for(i = 0; i < 4 && ok; i++) {
+			for(j = 0; j < 4 && ok; j++) {
+				if(secp256k1_iso_k[i][j] != NULL) ok = BN_hex2bn(&k->iso_k[i][j], secp256k1_iso_k[i][j]);
+			}
+		}
+	}
+	if(ok) {
+		const BIGNUM *p = k->p;
+		k->nwords = (BN_num_bits(p) + BN_BITS2 - 1) / BN_BITS2;
+		ok = BN_set_word(k->Z, (BN_ULONG) -suite->z) &&
+			 BN_mod_sqrt(k->c3, k->Z, p, ctx) != NULL &&			// sqrt(-Z)
+			 BN_sub(k->Z, p, k->Z) &&
+			 BN_mod_inverse(k->c1, k->A, p, ctx) != NULL &&
+			 BN_mod_mul(k->c1, k->c1, k->B, p, ctx) &&				// B / A
+			 BN_mod_inverse(k->c2, k->Z, p, ctx) != NULL &&
+			 BN_mod_mul(k->c2, k->c2, k->c1, p, ctx) &&				// B / (Z * A)
+			 BN_mod_sub(k->c1, p, k->c1, p, ctx) &&					// -B / A
+			 BN_sub(k->e_inv, p, BN_value_one()) &&
+			 BN_sub(k->e_inv, k->e_inv, BN_value_one()) &&
+			 BN_add(k->e_sqrt, p, BN_value_one()) &&
+			 BN_rshift(k->e_sqrt, k->e_sqrt, 2);
+	}
+	if(!ok) {
+		sswu_consts_free(k);
+		return NULL;
+	}
+	return k;
+}
+
+/* evaluates k[0] + k[1]*x + ... over the coefficients that are set */
+static void sswu_iso_poly(BIGNUM *r, BIGNUM *const *k, const BIGNUM *x, const BIGNUM *p, BN_CTX *ctx)
+{
+	int i = 3;
+	while(k[i] == NULL) i--;
+	BN_copy(r, k[i]);
+	for(i = i - 1; i >= 0; i--) {
+		BN_mod_mul(r, r, x, p, ctx);
+		BN_mod_add(r, r, k[i], p, ctx);
+	}
+}
+
+/* grows a to hold nwords words; the bit set and cleared lies above any value reduced mod p */
+static int sswu_expand(BIGNUM *a, int nwords)
+{
+	return BN_set_bit(a, nwords * BN_BITS2) && BN_clear_bit(a, nwords * BN_BITS2);
+}
+
+/* r = cond ? a : r, exchanging whole words instead of branching on cond (0 or 1) */
+static int sswu_select(BIGNUM *r, const BIGNUM *a, BN_ULONG cond, int nwords, BN_CTX *ctx)
+{
+	BN_CTX_start(ctx);
+	BIGNUM *t = BN_CTX_get(ctx);
+	int ok = t != NULL && BN_copy(t, a) != NULL && sswu_expand(t, nwords) && sswu_expand(r, nwords);
+	if(ok) BN_consttime_swap(cond, r, t, nwords);
+	BN_CTX_end(ctx);
+	return ok;
+}
+
+/*
+ * Simplified SWU map (RFC 9380 section 6.6.2) of field element u to the curve y^2 = x^3 + A*x + B.
+ * There is no branch on u: inv0 and sqrt are constant time exponentiations, the three choices
+ * of the map are masked selects, and sqrt(gx2) is derived from the sqrt attempt on gx1
+ * (gx2 = (Z*u^2)^3 * gx1), so there are only two exponentiations per call. The BIGNUM
+ * multiplications underneath are OpenSSL's regular ones and not hardened themselves.
+ */
+static int sswu_map_to_curve(BIGNUM *x, BIGNUM *y, const BIGNUM *u, const SSWUConsts *k, const BIGNUM *p, BN_CTX *ctx)
+{
+	int result = FALSE;
+	BN_ULONG e1;
+	BN_CTX_start(ctx);
+	BIGNUM *tv1 = BN_CTX_get(ctx), *tv2 = BN_CTX_get(ctx), *x1 = BN_CTX_get(ctx), *x2 = BN_CTX_get(ctx);
+	BIGNUM *gx1 = BN_CTX_get(ctx), *y1 = BN_CTX_get(ctx), *y2 = BN_CTX_get(ctx);
+	if(y2 == NULL) goto cleanup;
+
+	// tv1 = inv0(Z^2 * u^4 + Z * u^2)
+	BN_mod_sqr(tv2, u, p, ctx);
+	BN_mod_mul(tv2, tv2, k->Z, p, ctx);		// Z * u^2
+	BN_mod_sqr(tv1, tv2, p, ctx);
+	BN_mod_add(tv1, tv1, tv2, p, ctx);
+	BN_mod_exp_mont_consttime(tv1, tv1, k->e_inv, p, ctx, NULL);
+
+	// x1 = (-B / A) * (1 + tv1), or B / (Z * A) if tv1 == 0
+	BN_mod_add(x1, tv1, BN_value_one(), p, ctx);
+	BN_mod_mul(x1, x1, k->c1, p, ctx);
+	if(!sswu_select(x1, k->c2, (BN_ULONG) BN_is_zero(tv1), k->nwords, ctx)) goto cleanup;
+
+	// gx1 = x1^3 + A * x1 + B
+	BN_mod_sqr(gx1, x1, p, ctx);
+	BN_mod_add(gx1, gx1, k->A, p, ctx);
+	BN_mod_mul(gx1, gx1, x1, p, ctx);
+	BN_mod_add(gx1, gx1, k->B, p, ctx);
+
+	// x2 = Z * u^2 * x1
+	BN_mod_mul(x2, tv2, x1, p, ctx);
+
+	// y1 = sqrt(gx1) if gx1 is square, sqrt(-gx1) otherwise since -1 is a non-square for p = 3 mod 4
+	BN_mod_exp_mont_consttime(y1, gx1, k->e_sqrt, p, ctx, NULL);
+	// y2 = sqrt(gx2) = y1 * sqrt(-Z) * Z * u^3
+	BN_mod_mul(y2, tv2, u, p, ctx);
+	BN_mod_mul(y2, y2, k->c3, p, ctx);
+	BN_mod_mul(y2, y2, y1, p, ctx);
+
+	// e1 = is_square(gx1), i.e. y1^2 == gx1
+	BN_mod_sqr(tv1, y1, p, ctx);
+	BN_mod_sub(tv1, tv1, gx1, p, ctx);
+	e1 = (BN_ULONG) BN_is_zero(tv1);
+	BN_copy(x, x2);
+	BN_copy(y, y2);
+	if(!sswu_select(x, x1, e1, k->nwords, ctx) || !sswu_select(y, y1, e1, k->nwords, ctx)) goto cleanup;
+
+	// sgn0(u) == sgn0(y)
+	BN_mod_sub(tv1, p, y, p, ctx);
+	if(!sswu_select(y, tv1, (BN_ULONG) (BN_is_odd(u) ^ BN_is_odd(y)), k->nwords, ctx)) goto cleanup;
+	result = TRUE;
+
+cleanup:
+	BN_CTX_end(ctx);
+	return result;
+}
+
+/*
+ * Hashes msg to a point of G following the suite registered for the curve.
+ * @return TRUE on success, FALSE otherwise (with a python error set).
+ */
+int set_element_from_hash_sswu(ECElement *self, const SSWUSuite *suite, uint8_t *msg, int msg_len, uint8_t *dst, int dst_len)
+{
+	ECGroup *gobj = self->group;
+	BN_CTX *ctx = thread_bn_ctx();
+	EC_POINT *Q = NULL;
+	int result = FALSE, i;
+	int L = suite->field_len;
+	uint8_t uniform_bytes[2 * L];
+
+	if(self->type != G) {
+		PyErr_SetString(PyECErrorObject, "element not of type G.");
+		return FALSE;
+	}
+
+	if(!expand_message_xmd(sswu_md(suite), msg, msg_len, dst, dst_len, uniform_bytes, 2 * L)) {
+		PyErr_SetString(PyECErrorObject, "expand_message_xmd: invalid length.");
+		return FALSE;
+	}
+
+	// the constants are derived once per group, on first use (callers hold the GIL)
+	if(gobj->sswu == NULL || gobj->sswu->suite != suite) {
+		SSWUConsts *fresh = sswu_consts_new(gobj, suite, ctx);
+		if(fresh == NULL) {
+			PyErr_SetString(PyECErrorObject, "could not set up the hash-to-curve constants.");
+			return FALSE;
+		}
+		sswu_consts_free(gobj->sswu);
+		gobj->sswu = fresh;
+	}
+	const SSWUConsts *k = gobj->sswu;
+	const BIGNUM *p = k->p;
+
+	BN_CTX_start(ctx);
+	BIGNUM *u = BN_CTX_get(ctx), *x = BN_CTX_get(ctx), *y = BN_CTX_get(ctx);
+	BIGNUM *num = BN_CTX_get(ctx), *den = BN_CTX_get(ctx), *num2 = BN_CTX_get(ctx), *den2 = BN_CTX_get(ctx);
+	if(den2 == NULL) goto cleanup;
+	Q = EC_POINT_new(gobj->ec_group);
+	if(Q == NULL) goto cleanup;
+
+	for(i = 0; i < 2; i++) {
+		// u_i = OS2IP(uniform_bytes[i*L : (i+1)*L]) mod p
+		BN_bin2bn(uniform_bytes + i * L, L, u);
+		BN_mod(u, u, p, ctx);
+		if(!sswu_map_to_curve(x, y, u, k, p, ctx)) goto cleanup;
+
+		if(suite->iso) {
+			// (x, y) = (x_num / x_den, y * y_num / y_den), sharing one inversion of x_den * y_den
+			BN_copy(u, x);
+			sswu_iso_poly(num, k->iso_k[0], u, p, ctx);
+			sswu_iso_poly(den, k->iso_k[1], u, p, ctx);
+			sswu_iso_poly(num2, k->iso_k[2], u, p, ctx);
+			sswu_iso_poly(den2, k->iso_k[3], u, p, ctx);
+			BN_mod_mul(u, den, den2, p, ctx);
+			BN_mod_exp_mont_consttime(u, u, k->e_inv, p, ctx, NULL);
+			BN_mod_mul(x, num, den2, p, ctx);
+			BN_mod_mul(x, x, u, p, ctx);
+			BN_mod_mul(y, y, num2, p, ctx);
+			BN_mod_mul(y, y, den, p, ctx);
+			BN_mod_mul(y, y, u, p, ctx);
+		}
+
+		// exceptional cases of the isogeny land on the point at infinity
+		EC_POINT *target = (i == 0) ? self->P : Q;
+		if(!EC_POINT_set_affine_coordinates_GFp(gobj->ec_group, target, x, y, ctx)) {
+			ERR_clear_error();
+			EC_POINT_set_to_infinity(gobj->ec_group, target);
+		}
+	}
+
+	// cofactor is 1 for every registered suite, so R = Q0 + Q1 is already in G
+	EC_POINT_add(gobj->ec_group, self->P, self->P, Q, ctx);
+	self->point_init = TRUE;
+	result = TRUE;
+
+cleanup:
+	BN_CTX_end(ctx);
+	if(Q != NULL) EC_POINT_free(Q);
+	if(result == FALSE && !PyErr_Occurred()) {
+		PyErr_SetString(PyECErrorObject, "could not hash to curve.");
+	}
+	return result;
+}
+
+static PyObject *ECE_hash_sswu(ECElement *self, PyObject *args) {
+
+	char *msg = NULL, *dst = NULL;
+	Py_ssize_t msg_len, dst_len = 0;
+	ECElement *hashObj = NULL;
+	ECGroup *gobj = NULL;
+	char default_dst[MAX_BUF];
+
+	if(PyArg_ParseTuple(args, "Os#|s#", &gobj, &msg, &msg_len, &dst, &dst_len)) {
+		VERIFY_GROUP(gobj);
+		const SSWUSuite *suite = get_sswu_suite(gobj->nid);
+		EXIT_IF(suite == NULL, "sswu hash-to-curve not supported for this curve.");
+		if(dst == NULL) {
+			dst_len = snprintf(default_dst, MAX_BUF, "CHARM-V01-CS02-with-%s_XMD:%s_SSWU_RO_", suite->name, suite->hash_name);
+			dst = default_dst;
+		}
+		EXIT_IF(dst_len == 0 || dst_len > 255, "domain separation tag must be between 1 and 255 bytes.");
+
+		hashObj = createNewPoint(G, gobj);
+		if(!set_element_from_hash_sswu(hashObj, suite, (uint8_t *) msg, (int) msg_len, (uint8_t *) dst, (int) dst_len)) {
+			Py_DECREF(hashObj);
+			return NULL;
+		}
+		return (PyObject *) hashObj;
+	}
+
+	EXIT_IF(TRUE, "invalid arguments");
+}
+
+/*
+ * Computes prod(points[i] ^ scalars[i]) with a single EC_POINTs_mul call (interleaved wNAF
+ * in OpenSSL) outside of the GIL. Scalars may be ZR elements or python ints. The wNAF path
+ * is not constant time, so this is meant for public scalars (verification, commitments).
+ */
+static PyObject *ECE_multiexp(ECElement *self, PyObject *args) {
+	ECGroup *gobj = NULL;
+	PyObject *points = NULL, *scalars = NULL;
+	ECElement *ans = NULL;
+	int i, n, valid = TRUE;
+
+	EXIT_IF(!PyArg_ParseTuple(args, "OOO", &gobj, &points, &scalars), "invalid arguments: group, list of points, list of scalars");
+	VERIFY_GROUP(gobj);
+	EXIT_IF(!PySequence_Check(points) || !PySequence_Check(scalars), "points and scalars must be lists.");
+	n = (int) PySequence_Length(points);
+	EXIT_IF(n <= 0, "list is empty.");
+	EXIT_IF(n != PySequence_Length(scalars), "unequal number of points and scalars.");
+
+	const EC_POINT **p = (const EC_POINT **) malloc(n * sizeof(EC_POINT *));
+	const BIGNUM **m = (const BIGNUM **) malloc(n * sizeof(BIGNUM *));
+	BIGNUM **tmp = (BIGNUM **) calloc(n, sizeof(BIGNUM *));
+	PyObject *seq_p = PySequence_Fast(points, "points must be a list.");
+	PyObject *seq_m = PySequence_Fast(scalars, "scalars must be a list.");
+	if(p == NULL || m == NULL || tmp == NULL || seq_p == NULL || seq_m == NULL) {
+		valid = FALSE;
+		goto cleanup;
+	}
+
+	for(i = 0; i < n; i++) {
+		PyObject *pt = PySequence_Fast_GET_ITEM(seq_p, i);
+		PyObject *sc = PySequence_Fast_GET_ITEM(seq_m, i);
+		if(!PyEC_Check(pt) || ((ECElement *) pt)->type != G || ((ECElement *) pt)->group->nid != gobj->nid) {
+			valid = FALSE;
+			break;
+		}
+		p[i] = ((ECElement *) pt)->P;
+		if(PyEC_Check(sc) && ((ECElement *) sc)->type == ZR) {
+			m[i] = ((ECElement *) sc)->elemZ;
+		}
+		else if(PyLongCheck(sc)) {
+			tmp[i] = BN_new();
+			setBigNum((PyLongObject *) sc, &tmp[i]);
+			m[i] = tmp[i];
+		}
+		else {
+			valid = FALSE;
+			break;
+		}
+	}
+
+	if(valid) {
+		int result;
+		ans = createNewPoint(G, gobj);
+		// the fast sequences hold references to every operand until we are done
+		Py_BEGIN_ALLOW_THREADS
+		result = EC_POINTs_mul(gobj->ec_group, ans->P, NULL, n, p, m, thread_bn_ctx());
+		Py_END_ALLOW_THREADS
+		if(!result) {
+			Py_CLEAR(ans);
+			PyErr_SetString(PyECErrorObject, "multi-scalar multiplication failed.");
+		}
+#ifdef BENCHMARK_ENABLED
+		if(ans != NULL) {
+			UPDATE_BENCH(EXPONENTIATION, ans->type, ans->group);
+		}
+#endif
+	}
+
+cleanup:
+	if(!valid && !PyErr_Occurred()) {
+		PyErr_SetString(PyECErrorObject, "points must be elements of G and scalars elements of ZR or integers.");
+	}
+	if(tmp != NULL) {
+		for(i = 0; i < n; i++) BN_free(tmp[i]);
+		free(tmp);
+	}
+	free(p);
+	free((void *) m);
+	Py_XDECREF(seq_p);
+	Py_XDECREF(seq_m);
+	return (PyObject *) ans;
+}
+
+/*
+ * Invert a list of ZR elements with Montgomery's trick: one modular inversion
+ * and three multiplications per element.
+ */
+static PyObject *ECE_batch_invert(ECElement *self, PyObject *args) {
+	ECGroup *gobj = NULL;
+	PyObject *elems = NULL, *seq = NULL, *result = NULL;
+	int i, n, valid = TRUE, inverted = FALSE;
+
+	EXIT_IF(!PyArg_ParseTuple(args, "OO", &gobj, &elems), "invalid arguments: group, list of ZR elements");
+	VERIFY_GROUP(gobj);
+	seq = PySequence_Fast(elems, "expected a list of ZR elements.");
+	if(seq == NULL) return NULL;
+	n = (int) PySequence_Fast_GET_SIZE(seq);
+
+	const BIGNUM **a = (const BIGNUM **) malloc((n + 1) * sizeof(BIGNUM *));
+	BIGNUM **out = (BIGNUM **) malloc((n + 1) * sizeof(BIGNUM *));
+	result = PyList_New(n);
+	if(a == NULL || out == NULL || result == NULL) {
+		valid = FALSE;
+		goto cleanup;
+	}
+
+	for(i = 0; i < n; i++) {
+		PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+		if(!PyEC_Check(item) || ((ECElement *) item)->type != ZR || ((ECElement *) item)->group->nid != gobj->nid) {
+			valid = FALSE;
+			goto cleanup;
+		}
+		a[i] = ((ECElement *) item)->elemZ;
+		ECElement *inv = createNewPoint(ZR, gobj);
+		PyList_SET_ITEM(result, i, (PyObject *) inv);
+		out[i] = inv->elemZ;
+	}
+
+	if(n > 0) {
+		// the fast sequence holds a reference to every operand until we are done
+		Py_BEGIN_ALLOW_THREADS
+		BIGNUM *acc = BN_new(), *acc_inv = NULL;
+		BN_one(acc);
+		// out[i] = a[0] * ... * a[i-1]
+		for(i = 0; i < n; i++) {
+			BN_copy(out[i], acc);
+			zr_mod_mul(acc, acc, a[i], gobj);
+		}
+		if(!BN_is_zero(acc)) {
+			acc_inv = BN_mod_inverse(NULL, acc, gobj->order, thread_bn_ctx());
+		}
+		if(acc_inv != NULL) {
+			for(i = n - 1; i >= 0; i--) {
+				// acc_inv = 1 / (a[0] * ... * a[i])
+				zr_mod_mul(out[i], out[i], acc_inv, gobj);
+				zr_mod_mul(acc_inv, acc_inv, a[i], gobj);
+			}
+			inverted = TRUE;
+			BN_free(acc_inv);
+		}
+		BN_free(acc);
+		Py_END_ALLOW_THREADS
+		if(!inverted) {
+			PyErr_SetString(PyECErrorObject, "could not find a modular inverse for every element.");
+			Py_CLEAR(result);
+		}
+	}
+#ifdef BENCHMARK_ENABLED
+	if(result != NULL) {
+		UPDATE_BENCH(DIVISION, ZR, gobj);
+	}
+#endif
+
+cleanup:
+	if(!valid) {
+		if(!PyErr_Occurred()) {
+			PyErr_SetString(PyECErrorObject, "can only invert a list of ZR elements.");
+		}
+		Py_CLEAR(result);
+	}
+	free((void *) a);
+	free(out);
+	Py_DECREF(seq);
+	return result;
+}
+
 /*
  * Encode a message as a group element
  */
@@ -1329,15 +2053,15 @@ static PyObject *ECE_encode(ECElement *self, PyObject *args) {
                 //char *xstr = BN_bn2dec(x);
                 //debug("gen x => %s\n", xstr);
                 //OPENSSL_free(xstr);
-                EC_POINT_set_compressed_coordinates_GFp(gobj->ec_group, encObj->P, x, 1, gobj->ctx);
-                EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, encObj->P, x, y, gobj->ctx);
+                EC_POINT_set_compressed_coordinates_GFp(gobj->ec_group, encObj->P, x, 1, thread_bn_ctx());
+                EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, encObj->P, x, y, thread_bn_ctx());
 
                 if(BN_is_zero(x) || BN_is_zero(y)) {
                     ctr++;
                     continue;
                 }
 
-                if(EC_POINT_is_on_curve(gobj->ec_group, encObj->P, gobj->ctx)) {
+                if(EC_POINT_is_on_curve(gobj->ec_group, encObj->P, thread_bn_ctx())) {
                     debug("point is on curve!\n");
                     debug("final hex msg => ");
                     // check if msg len is big enough to fit into length
@@ -1383,7 +2107,7 @@ static PyObject *ECE_decode(ECElement *self, PyObject *args) {
 		if(PyEC_Check(obj) && isPoint(obj)) {
 			BIGNUM *x = BN_new(), *y = BN_new();
 			// verifies that element is on the curve then gets coordinates
-			EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, obj->P, x, y, gobj->ctx);
+			EC_POINT_get_affine_coordinates_GFp(gobj->ec_group, obj->P, x, y, thread_bn_ctx());
 			int max_byte_len = BN_num_bytes(gobj->order);
 			int prepend_zeros = max_byte_len;
 			// by default we will strip out the counter part (unless specified otherwise by user)
@@ -1417,20 +2141,97 @@ static PyObject *ECE_decode(ECElement *self, PyObject *args) {
 	EXIT_IF(TRUE, "invalid argument");
 }
 
+/* raw format: a type byte followed by a fixed-length compressed point or scalar */
+static size_t raw_element_len(ECGroup *gobj, GroupType type)
+{
+	return 1 + (type == G ? compressed_point_len(gobj) : (size_t) BN_num_bytes(gobj->order));
+}
+
+static PyObject *serialize_raw(ECElement *obj)
+{
+	size_t len = raw_element_len(obj->group, obj->type);
+	int ok = FALSE;
+
+	PyObject *result = PyBytes_FromStringAndSize(NULL, len);
+	if(result == NULL) return NULL;
+	uint8_t *out = (uint8_t *) PyBytes_AS_STRING(result);
+	memset(out, 0, len);
+	out[0] = (uint8_t) obj->type;
+
+	if(obj->type == G) {
+		// the point at infinity stays all zero
+		ok = EC_POINT_is_at_infinity(obj->group->ec_group, obj->P) ||
+			 EC_POINT_point2oct(obj->group->ec_group, obj->P, POINT_CONVERSION_COMPRESSED, out + 1, len - 1, thread_bn_ctx()) == len - 1;
+	}
+	else if(obj->type == ZR) {
+		if(!BN_is_negative(obj->elemZ) && BN_cmp(obj->elemZ, obj->group->order) < 0) {
+			ok = BN_bn2binpad(obj->elemZ, out + 1, len - 1) == (int) (len - 1);
+		}
+		else {
+			BIGNUM *z = BN_new();
+			ok = z != NULL && BN_nnmod(z, obj->elemZ, obj->group->order, thread_bn_ctx()) &&
+				 BN_bn2binpad(z, out + 1, len - 1) == (int) (len - 1);
+			BN_free(z);
+		}
+	}
+
+	if(!ok) {
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "could not serialize element.");
+	}
+	return result;
+}
+
+/* decodes straight out of the caller's buffer; returns NULL with an error set on failure */
+static PyObject *deserialize_raw(ECGroup *gobj, const uint8_t *data, size_t data_len)
+{
+	GroupType type = (GroupType) data[0];
+	EXIT_IF(data_len != raw_element_len(gobj, type), "invalid length for raw element encoding.");
+	ECElement *newObj = createNewPoint(type, gobj);
+	int ok = FALSE;
+
+	if(type == G) {
+		size_t i = 1;
+		while(i < data_len && data[i] == 0) i++;
+		if(i == data_len) {
+			ok = EC_POINT_set_to_infinity(gobj->ec_group, newObj->P);
+		}
+		else {
+			ok = EC_POINT_oct2point(gobj->ec_group, newObj->P, data + 1, data_len - 1, thread_bn_ctx()) &&
+				 EC_POINT_is_on_curve(gobj->ec_group, newObj->P, thread_bn_ctx()) == 1;
+		}
+	}
+	else {
+		ok = BN_bin2bn(data + 1, data_len - 1, newObj->elemZ) != NULL &&
+			 BN_cmp(newObj->elemZ, gobj->order) < 0;
+	}
+
+	if(!ok) {
+		Py_DECREF(newObj);
+		EXIT_IF(TRUE, "invalid raw element encoding.");
+	}
+	return (PyObject *) newObj;
+}
+
 static PyObject *Serialize(ECElement *self, PyObject *args) {
 
 	ECElement *obj = NULL;
-	if(!PyArg_ParseTuple(args, "O", &obj)) {
+	int raw = FALSE;
+	if(!PyArg_ParseTuple(args, "O|p", &obj, &raw)) {
 		ErrorMsg("invalid argument.");
 		return NULL;
 	}
 
+	if(obj != NULL && PyEC_Check(obj) && obj->point_init && raw) {
+		return serialize_raw(obj);
+	}
+
 	if(obj != NULL && PyEC_Check(obj)) {
 		// allows export a compressed string
 		if(obj->point_init && obj->type == G) {
 			uint8_t p_buf[MAX_BUF+1];
 			memset(p_buf, 0, MAX_BUF);
-			size_t len = EC_POINT_point2oct(obj->group->ec_group, obj->P, POINT_CONVERSION_COMPRESSED,  p_buf, MAX_BUF, obj->group->ctx);
+			size_t len = EC_POINT_point2oct(obj->group->ec_group, obj->P, POINT_CONVERSION_COMPRESSED,  p_buf, MAX_BUF, thread_bn_ctx());
 			EXIT_IF(len == 0, "could not serialize point.");
 
 			debug("Serialized point => ");
@@ -1474,6 +2275,18 @@ static PyObject *Deserialize(ECElement *self, PyObject *args)
 
 	if(PyArg_ParseTuple(args, "OO", &gobj, &obj)) {
 		VERIFY_GROUP(gobj);
+		// raw encodings start with the type byte (0 or 1), the base64 ones with its ASCII digit
+		if(PyObject_CheckBuffer(obj)) {
+			Py_buffer view;
+			if(PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) != 0) return NULL;
+			const uint8_t *data = (const uint8_t *) view.buf;
+			if(view.len > 0 && (data[0] == ZR || data[0] == G)) {
+				PyObject *result = deserialize_raw(gobj, data, (size_t) view.len);
+				PyBuffer_Release(&view);
+				return result;
+			}
+			PyBuffer_Release(&view);
+		}
 		if(PyBytes_Check(obj)) {
 			unsigned char *serial_buf = (unsigned char *) PyBytes_AsString(obj);
 			GroupType type = atoi((const char *) &(serial_buf[0]));
@@ -1486,9 +2299,9 @@ static PyObject *Deserialize(ECElement *self, PyObject *args)
 			printf_buffer_as_hex(buf, len);
 			if(type == G) {
 				ECElement *newObj = createNewPoint(type, gobj); // ->group, gobj->ctx);
-				EC_POINT_oct2point(gobj->ec_group, newObj->P, (const uint8_t *) buf, len, gobj->ctx);
+				EC_POINT_oct2point(gobj->ec_group, newObj->P, (const uint8_t *) buf, len, thread_bn_ctx());
 
-				if(EC_POINT_is_on_curve(gobj->ec_group, newObj->P, gobj->ctx)) {
+				if(EC_POINT_is_on_curve(gobj->ec_group, newObj->P, thread_bn_ctx())) {
 					obj=(PyObject *) newObj;
 				}
 			}
@@ -1510,6 +2323,134 @@ static PyObject *Deserialize(ECElement *self, PyObject *args)
 	EXIT_IF(TRUE, "invalid argument");
 }
 
+/* length of a compressed point: a tag byte followed by the x-coordinate */
+size_t compressed_point_len(ECGroup *gobj)
+{
+	return 1 + (EC_GROUP_get_degree(gobj->ec_group) + 7) / BYTE;
+}
+
+/*
+ * Compressed encoding of a point already in affine form (Z = 1). Reading the Jacobian
+ * coordinates directly skips the inversion some point2oct implementations (e.g. the
+ * P-256 one) perform even for affine points.
+ */
+static int affine_point2oct(EC_GROUP *group, const EC_POINT *P, uint8_t *out, size_t width, BN_CTX *ctx)
+{
+	int ok = FALSE;
+	BN_CTX_start(ctx);
+	BIGNUM *x = BN_CTX_get(ctx), *y = BN_CTX_get(ctx), *z = BN_CTX_get(ctx);
+	if(z != NULL && EC_POINT_get_Jprojective_coordinates_GFp(group, P, x, y, z, ctx) && BN_is_one(z)) {
+		out[0] = POINT_CONVERSION_COMPRESSED + BN_is_odd(y);
+		ok = BN_bn2binpad(x, out + 1, width - 1) == (int) (width - 1);
+	}
+	BN_CTX_end(ctx);
+	if(!ok) {
+		ok = EC_POINT_point2oct(group, P, POINT_CONVERSION_COMPRESSED, out, width, ctx) == width;
+	}
+	return ok;
+}
+
+/*
+ * Serialize a list of points into one contiguous buffer of fixed-width compressed
+ * encodings. The points are brought to affine form together first, so the whole batch
+ * costs a single field inversion instead of one per point. The point at infinity is
+ * written as an all-zero slot.
+ */
+static PyObject *SerializePoints(ECElement *self, PyObject *args)
+{
+	ECGroup *gobj = NULL;
+	PyObject *points = NULL, *seq = NULL, *result = NULL;
+	EC_POINT **p = NULL;
+	int i, n, ok = TRUE;
+
+	EXIT_IF(!PyArg_ParseTuple(args, "OO", &gobj, &points), "invalid arguments: group, list of points");
+	VERIFY_GROUP(gobj);
+	seq = PySequence_Fast(points, "expected a list of points.");
+	if(seq == NULL) return NULL;
+	n = (int) PySequence_Fast_GET_SIZE(seq);
+	size_t width = compressed_point_len(gobj);
+
+	p = (EC_POINT **) calloc(n + 1, sizeof(EC_POINT *));
+	if(p == NULL) {
+		Py_DECREF(seq);
+		return PyErr_NoMemory();
+	}
+	for(i = 0; i < n && ok; i++) {
+		ECElement *pt = (ECElement *) PySequence_Fast_GET_ITEM(seq, i);
+		if(!PyEC_Check(pt) || !pt->point_init || pt->type != G || pt->group->nid != gobj->nid) {
+			PyErr_SetString(PyECErrorObject, "can only serialize a list of points in G.");
+			ok = FALSE;
+		}
+		// normalize copies: the caller's points may be in use by other threads
+		else if((p[i] = EC_POINT_dup(pt->P, gobj->ec_group)) == NULL) {
+			PyErr_SetString(PyECErrorObject, "could not copy point.");
+			ok = FALSE;
+		}
+	}
+
+	if(ok) {
+		result = PyBytes_FromStringAndSize(NULL, n * width);
+		ok = (result != NULL);
+	}
+	if(ok && n > 0) {
+		uint8_t *out = (uint8_t *) PyBytes_AS_STRING(result);
+		memset(out, 0, n * width);
+		Py_BEGIN_ALLOW_THREADS
+		BN_CTX *ctx = thread_bn_ctx();
+		ok = EC_POINTs_make_affine(gobj->ec_group, n, p, ctx);
+		for(i = 0; i < n && ok; i++, out += width) {
+			if(EC_POINT_is_at_infinity(gobj->ec_group, p[i])) continue;
+			ok = affine_point2oct(gobj->ec_group, p[i], out, width, ctx);
+		}
+		Py_END_ALLOW_THREADS
+		if(!ok) {
+			PyErr_SetString(PyECErrorObject, "could not serialize points.");
+			Py_CLEAR(result);
+		}
+	}
+
+	for(i = 0; i < n; i++) EC_POINT_free(p[i]);
+	free(p);
+	Py_DECREF(seq);
+	return result;
+}
+
+/* Inverse of serializePoints: split a contiguous buffer of compressed points */
+static PyObject *DeserializePoints(ECElement *self, PyObject *args)
+{
+	ECGroup *gobj = NULL;
+	PyObject *result = NULL;
+	const uint8_t *data = NULL;
+	Py_ssize_t data_len = 0;
+	int i, n;
+
+	EXIT_IF(!PyArg_ParseTuple(args, "Oy#", &gobj, &data, &data_len), "invalid arguments: group, bytes");
+	VERIFY_GROUP(gobj);
+	size_t width = compressed_point_len(gobj);
+	EXIT_IF(data_len % width != 0, "buffer is not a whole number of points.");
+	n = (int) (data_len / width);
+
+	result = PyList_New(n);
+	if(result == NULL) return NULL;
+	for(i = 0; i < n; i++, data += width) {
+		ECElement *newObj = createNewPoint(G, gobj);
+		PyList_SET_ITEM(result, i, (PyObject *) newObj);
+		if(data[0] == 0) {
+			// all-zero slot
+			size_t j = 1;
+			while(j < width && data[j] == 0) j++;
+			if(j == width && EC_POINT_set_to_infinity(gobj->ec_group, newObj->P)) continue;
+		}
+		else if(EC_POINT_oct2point(gobj->ec_group, newObj->P, data, width, thread_bn_ctx()) &&
+				EC_POINT_is_on_curve(gobj->ec_group, newObj->P, thread_bn_ctx()) == 1) {
+			continue;
+		}
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "invalid point encoding in buffer.");
+	}
+	return result;
+}
+
 #ifdef BENCHMARK_ENABLED
 
 #define BenchmarkIdentifier 2
@@ -1541,6 +2482,7 @@ PyMemberDef ECElement_members[] = {
 
 PyMethodDef ECElement_methods[] = {
 		{"isInf", (PyCFunction)ECE_is_infinity, METH_NOARGS, "Checks whether a point is at infinity."},
+		{"initPP", (PyCFunction)ECE_initPP, METH_NOARGS, "Initialize a table of precomputed multiples for a fixed base point."},
 		{NULL}
 };
 
@@ -1821,7 +2763,12 @@ static PyMethodDef ec_methods[] = {
 		{"bitsize", (PyCFunction)ECE_bitsize, METH_O, "Returns number of bytes to represent a message."},
 		{"serialize", (PyCFunction)Serialize, METH_VARARGS, "Serialize an element to a string"},
 		{"deserialize", (PyCFunction)Deserialize, METH_VARARGS, "Deserialize an element to G or ZR"},
+		{"serializePoints", (PyCFunction)SerializePoints, METH_VARARGS, "Serialize a list of points into one buffer of compressed points"},
+		{"deserializePoints", (PyCFunction)DeserializePoints, METH_VARARGS, "Deserialize a buffer of compressed points into a list of points"},
 		{"hashEC", (PyCFunction)ECE_hash, METH_VARARGS, "Perform a hash of a string to a group element of G."},
+		{"hashToCurve", (PyCFunction)ECE_hash_sswu, METH_VARARGS, "Hash a string to a group element of G (RFC 9380, simplified SWU)."},
+		{"multiexp", (PyCFunction)ECE_multiexp, METH_VARARGS, "Compute the product of points[i] ^ scalars[i] in a single call."},
+		{"batch_invert", (PyCFunction)ECE_batch_invert, METH_VARARGS, "Invert a list of ZR elements with a single modular inversion."},
 		{"encode", (PyCFunction)ECE_encode, METH_VARARGS, "Encode string as a group element of G"},
 		{"decode", (PyCFunction)ECE_decode, METH_VARARGS, "Decode group element to a string."},
 		{"getXY", (PyCFunction)ECE_convertToZR, METH_VARARGS, "Returns the x and/or y coordinates of point on an elliptic curve."},
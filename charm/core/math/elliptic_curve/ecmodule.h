@@ -38,8 +38,11 @@
 #include <structmember.h>
 #include <longintrepr.h>
 #include <math.h>
+#include <pthread.h>
 #include "benchmarkmodule.h"
 #include "base64.h"
+#include "drbg.h"
+#include "ec_secp256k1.h"
 
 /* Openssl header files */
 #include <openssl/ec.h>
@@ -49,6 +52,7 @@
 #include <openssl/rand.h>
 #include <openssl/bn.h>
 #include <openssl/sha.h>
+#include <openssl/evp.h>
 #ifdef BENCHMARK_ENABLED
 #include "benchmark_util.h"
 #endif
@@ -95,13 +99,17 @@ typedef struct {
 } Operations;
 #endif
 
+/* simplified SWU constants of a group, derived on first use */
+typedef struct SSWUConsts SSWUConsts;
+
 typedef struct {
 	PyObject_HEAD
 	EC_GROUP *ec_group;
 	int group_init;
 	int nid;
-	BN_CTX *ctx;
 	BIGNUM *order;
+	BN_MONT_CTX *mont;	/* Montgomery context for ZR arithmetic mod order (NULL if order is unknown) */
+	SSWUConsts *sswu;	/* hash-to-curve constants (NULL until the first sswu hash) */
 #ifdef BENCHMARK_ENABLED
     Benchmark *dBench;
     Operations *gBench;
@@ -116,6 +124,8 @@ typedef struct {
 	EC_POINT *P;
 	BIGNUM *elemZ;
 	int point_init;
+	EC_GROUP *pp_group;	/* copy of the curve with P as generator and its precomputed multiples */
+	int is_gen;			/* P was copied from the group generator, whose table OpenSSL keeps */
 } ECElement;
 
 #if PY_MAJOR_VERSION >= 3
@@ -169,6 +179,8 @@ typedef struct {
 #define ElementZR(a, b) a->type == ZR && b->type == ZR
 
 void setBigNum(PyLongObject *obj, BIGNUM **value);
+/* per-thread BN_CTX, created on first use and released when the thread exits */
+BN_CTX *thread_bn_ctx(void);
 PyObject *ECElement_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 int ECElement_init(ECElement *self, PyObject *args, PyObject *kwds);
 PyObject *ECElement_call(ECElement *intObject, PyObject *args, PyObject *kwds);
@@ -176,10 +188,29 @@ PyObject *ECElement_print(ECElement *self);
 void	ECElement_dealloc(ECElement* self);
 
 ECElement *negatePoint(ECElement *self);
+void point_mul(ECElement *ans, ECElement *base, const BIGNUM *m);
+void zr_mod_mul(BIGNUM *r, const BIGNUM *a, const BIGNUM *b, ECGroup *group);
+void zr_mod_exp(BIGNUM *r, const BIGNUM *a, const BIGNUM *e, ECGroup *group);
 ECElement *invertECElement(ECElement *self);
+size_t compressed_point_len(ECGroup *gobj);
 int hash_to_bytes(uint8_t *input_buf, int input_len, uint8_t *output_buf, int hash_len, uint8_t hash_prefix);
 void set_element_from_hash(ECElement *self, uint8_t *input, int input_len);
 
+/* RFC 9380 hash-to-curve suite parameters for a named curve */
+typedef struct {
+	int nid;
+	const char *name;		/* curve identifier used in the suite ID */
+	const char *hash_name;	/* hash used by expand_message_xmd */
+	int z;					/* non-square Z of the simplified SWU map */
+	int field_len;			/* L = ceil((ceil(log2(p)) + k) / 8) */
+	int iso;				/* map to a 3-isogenous curve first (A = 0 curves) */
+} SSWUSuite;
+
+const SSWUSuite *get_sswu_suite(int nid);
+int expand_message_xmd(const EVP_MD *md, const uint8_t *msg, int msg_len, const uint8_t *dst, int dst_len, uint8_t *output, int output_len);
+int set_element_from_hash_sswu(ECElement *self, const SSWUSuite *suite, uint8_t *msg, int msg_len, uint8_t *dst, int dst_len);
+void sswu_consts_free(SSWUConsts *k);
+
 #define EXIT_IF(check, msg) \
 	if(check) { 						\
 	PyErr_SetString(PyECErrorObject, msg); \
@@ -308,14 +308,70 @@ int hash_to_group_element(mpz_t x, int block_num, uint8_t *output_buf) {
 	return TRUE;
 }
 
+/* the shared "no modulus" context; never freed */
+static IntegerModulus no_modulus;
+
+/* a few recently used moduli, so elements built from the same Python modulus
+ * (e.g. integer(x, N) in a loop) end up sharing one context */
+#define MODULUS_CACHE_SIZE	8
+static IntegerModulus *modulus_cache[MODULUS_CACHE_SIZE];
+static int modulus_cache_next = 0;
+
+IntegerModulus *modulus_ref(IntegerModulus *mod) {
+	mod->refcount++;
+	return mod;
+}
+
+void modulus_release(IntegerModulus *mod) {
+	if (mod != NULL && --mod->refcount == 0) {
+		mpz_clear(mod->m);
+		free(mod);
+	}
+}
+
+IntegerModulus *modulus_get(const mpz_t m) {
+	IntegerModulus *mod;
+	size_t bits;
+	int i;
+
+	if (mpz_sgn(m) == 0)
+		return modulus_ref(&no_modulus);
+
+	bits = mpz_sizeinbase(m, 2);
+	for (i = 0; i < MODULUS_CACHE_SIZE; i++) {
+		mod = modulus_cache[i];
+		if (mod != NULL && mod->bits == bits && mpz_cmp(mod->m, m) == 0)
+			return modulus_ref(mod);
+	}
+
+	mod = (IntegerModulus *) malloc(sizeof(IntegerModulus));
+	mod->refcount = 1;
+	mpz_init_set(mod->m, m);
+	mod->bits = bits;
+	mod->odd = mpz_odd_p(m) ? TRUE : FALSE;
+
+	// the cache holds its own reference
+	modulus_release(modulus_cache[modulus_cache_next]);
+	modulus_cache[modulus_cache_next] = modulus_ref(mod);
+	modulus_cache_next = (modulus_cache_next + 1) % MODULUS_CACHE_SIZE;
+	return mod;
+}
+
+void set_modulus(Integer *obj, const mpz_t m) {
+	IntegerModulus *mod = modulus_get(m);
+	modulus_release(obj->mod);
+	obj->mod = mod;
+}
+
 void _reduce(Integer *object) {
-	if (object != NULL && mpz_sgn(object->m) > 0)
-		mpz_mod(object->e, object->e, object->m);
+	if (object != NULL && mpz_sgn(object->mod->m) > 0)
+		mpz_mod(object->e, object->e, object->mod->m);
 }
 
 void Integer_dealloc(Integer* self) {
 	/* clear structure */
-	mpz_clear(self->m);
+	modulus_release(self->mod);
+	pp_free(self->pp);
 	mpz_clear(self->e);
 	Py_TYPE(self)->tp_free((PyObject*) self);
 }
@@ -327,7 +383,8 @@ PyObject *Integer_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
 	if (self != NULL) {
 		/* initialize fields here */
 		mpz_init(self->e);
-		mpz_init(self->m);
+		self->mod = modulus_ref(&no_modulus);
+		self->pp = NULL;
 		self->initialized = TRUE;
 	}
 	return (PyObject *) self;
@@ -371,7 +428,7 @@ int Integer_init(Integer *self, PyObject *args, PyObject *kwds) {
 			mpz_t m;
 			mpz_init(m);
 			longObjToMPZ(m, mod);
-			if(mpz_sgn(m) > 0) mpz_set(self->m, m);
+			if(mpz_sgn(m) > 0) set_modulus(self, m);
 			else {
 				mpz_clear(m);
 				PyErr_SetString(IntegerError, "negative modulus not allowed.");
@@ -381,14 +438,14 @@ int Integer_init(Integer *self, PyObject *args, PyObject *kwds) {
 		}
 		else if(PyInteger_Check(mod)) {
 			Integer *mod1 = (Integer *) mod;
-			mpz_set(self->m, mod1->e);
+			set_modulus(self, mod1->e);
 		}
 		else {
 			PyErr_SetString(IntegerError, "invalid type for modulus");
 			return -1;
 		}
 	}
-	// else leave self->m set to 0.
+	// else leave self->mod->m set to 0.
 	return 0;
 }
 
@@ -408,37 +465,37 @@ static PyObject *Integer_equals(PyObject *o1, PyObject *o2, int opid) {
 	}
 	else if (foundLHS) {
 		debug("foundLHS\n");
-		if (mpz_sgn(rhs->m) == 0) {
+		if (mpz_sgn(rhs->mod->m) == 0) {
 			result = mpz_cmp(lhs_mpz, rhs->e);
 		} else {
 			mpz_init(r);
-			mpz_mod(r, rhs->e, rhs->m);
+			mpz_mod(r, rhs->e, rhs->mod->m);
 			result = mpz_cmp(r, lhs_mpz);
 			mpz_clear(r);
 		}
 	} else if (foundRHS) {
 		debug("foundRHS!\n");
 
-		if (mpz_sgn(lhs->m) == 0) {
+		if (mpz_sgn(lhs->mod->m) == 0) {
 			result = mpz_cmp(lhs->e, rhs_mpz);
 		} else {
 			mpz_init(l);
-			mpz_mod(l, lhs->e, lhs->m);
+			mpz_mod(l, lhs->e, lhs->mod->m);
 			result = mpz_cmp(l, rhs_mpz);
 			mpz_clear(l);
 		}
 	} else {
-		debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->m, rhs->m));
-		if (mpz_sgn(lhs->m) == 0 && mpz_sgn(rhs->m) == 0) {
+		debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->mod->m, rhs->mod->m));
+		if (mpz_sgn(lhs->mod->m) == 0 && mpz_sgn(rhs->mod->m) == 0) {
 			// comparing ints without a modulous
 			result = mpz_cmp(lhs->e, rhs->e);
 		}
-		else if (mpz_cmp(lhs->m, rhs->m) == 0) {
+		else if (modulus_cmp(lhs, rhs) == 0) {
 			// comparing ints with a modolus that are equal
 			mpz_init(l);
 			mpz_init(r);
-			mpz_mod(l, lhs->e, lhs->m);
-			mpz_mod(r, rhs->e, rhs->m);
+			mpz_mod(l, lhs->e, lhs->mod->m);
+			mpz_mod(r, rhs->e, rhs->mod->m);
 			result = mpz_cmp(l, r);
 			mpz_clear(l);
 			mpz_clear(r);
@@ -487,10 +544,10 @@ PyObject *Integer_print(Integer *self) {
 		char *e_str = (char *) malloc(e_size);
 		mpz_get_str(e_str, 10, self->e);
 
-		if (mpz_sgn(self->m) != 0) {
-			size_t m_size = mpz_sizeinbase(self->m, 10) + 2;
+		if (mpz_sgn(self->mod->m) != 0) {
+			size_t m_size = mpz_sizeinbase(self->mod->m, 10) + 2;
 			char *m_str = (char *) malloc(m_size);
-			mpz_get_str(m_str, 10, self->m);
+			mpz_get_str(m_str, 10, self->mod->m);
 			strObject = PyUnicode_FromFormat("%s mod %s", (const char *) e_str,
 					(const char *) m_str);
 			free(m_str);
@@ -513,6 +570,7 @@ Integer *createNewInteger() {
 	Integer *newObject = PyObject_New(Integer, &IntegerType);
 	//mpz_init(newObject->e);
 	//mpz_init_set(newObject->m, m);
+	newObject->pp = NULL;
 	newObject->initialized = TRUE;
 	return newObject;
 }
@@ -537,7 +595,10 @@ static PyObject *Integer_set(Integer *self, PyObject *args) {
 			intObj = (Integer *) obj;
 			self->initialized = TRUE;
 			mpz_set(self->e, intObj->e);
-			mpz_set(self->m, intObj->m);
+			pp_free(self->pp);
+			self->pp = NULL;
+			modulus_release(self->mod);
+			self->mod = modulus_ref(intObj->mod);
 			return Py_BuildValue("i", TRUE);
 		}
 	}
@@ -562,10 +623,10 @@ static PyObject *Integer_add(PyObject *o1, PyObject *o2) {
 	}
 	else if (foundLHS) {
 		//debug("foundLHS\n");
-		if(mpz_sgn(rhs->m) == 0) { // mpz_sgn(lhs_mpz) > 0
+		if(mpz_sgn(rhs->mod->m) == 0) { // mpz_sgn(lhs_mpz) > 0
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_add(rop->e, lhs_mpz, rhs->e);
 		}
 		else {
@@ -574,10 +635,10 @@ static PyObject *Integer_add(PyObject *o1, PyObject *o2) {
 		}
 	} else if (foundRHS) {
 		// debug("foundRHS!\n");
-		if(mpz_sgn(lhs->m) == 0) {
+		if(mpz_sgn(lhs->mod->m) == 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_add(rop->e, lhs->e, rhs_mpz);
 		}
 		else {
@@ -585,18 +646,18 @@ static PyObject *Integer_add(PyObject *o1, PyObject *o2) {
 			ErrorMsg("unsupported operation.");
 		}
 	} else {
-		// debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->m, rhs->m));
-		if (mpz_cmp(lhs->m, rhs->m) == 0) {
+		// debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->mod->m, rhs->mod->m));
+		if (modulus_cmp(lhs, rhs) == 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
+			rop->mod = modulus_ref(lhs->mod);
 			mpz_add(rop->e, lhs->e, rhs->e);
 		} else {
 			EXIT_IF(TRUE, "cannot add integers with different modulus.");
 		}
 	}
 
-//	if(mpz_sgn(rop->e) < 0 || mpz_cmp(rop->e, rop->m) > 0) {
+//	if(mpz_sgn(rop->e) < 0 || mpz_cmp(rop->e, rop->mod->m) > 0) {
 //		_reduce(rop);
 //	}
 
@@ -623,10 +684,10 @@ static PyObject *Integer_sub(PyObject *o1, PyObject *o2) {
 	}
 	else if (foundLHS) {
 		// debug("foundLHS\n");
-		if(mpz_sgn(rhs->m) == 0) { // mpz_sgn(lhs_mpz) > 0
+		if(mpz_sgn(rhs->mod->m) == 0) { // mpz_sgn(lhs_mpz) > 0
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_sub(rop->e, lhs_mpz, rhs->e);
 		}
 		else {
@@ -635,10 +696,10 @@ static PyObject *Integer_sub(PyObject *o1, PyObject *o2) {
 		}
 	} else if (foundRHS) {
 		// debug("foundRHS!\n");
-		if(mpz_sgn(lhs->m) == 0) {
+		if(mpz_sgn(lhs->mod->m) == 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_sub(rop->e, lhs->e, rhs_mpz);
 		}
 		else {
@@ -646,11 +707,11 @@ static PyObject *Integer_sub(PyObject *o1, PyObject *o2) {
 			ErrorMsg("unsupported operation.");
 		}
 	} else {
-		// debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->m, rhs->m));
-		if (mpz_cmp(lhs->m, rhs->m) == 0) {
+		// debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->mod->m, rhs->mod->m));
+		if (modulus_cmp(lhs, rhs) == 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
+			rop->mod = modulus_ref(lhs->mod);
 			mpz_sub(rop->e, lhs->e, rhs->e);
 		} else {
 			EXIT_IF(TRUE,"cannot subtract integers with different modulus.");
@@ -660,7 +721,7 @@ static PyObject *Integer_sub(PyObject *o1, PyObject *o2) {
 	mpz_clear(lhs_mpz);
 	mpz_clear(rhs_mpz);
 	if(mpz_sgn(rop->e) < 0) {
-		mpz_add(rop->e, rop->e, rop->m);
+		mpz_add(rop->e, rop->e, rop->mod->m);
 	}
 #ifdef BENCHMARK_ENABLED
 	UPDATE_BENCHMARK(SUBTRACTION, tmpBench);
@@ -686,10 +747,10 @@ static PyObject *Integer_mul(PyObject *o1, PyObject *o2) {
 	}
 	else if (foundLHS) {
 		//debug("foundLHS\n");
-		if(mpz_sgn(rhs->m) == 0) { // mpz_sgn(lhs_mpz) > 0
+		if(mpz_sgn(rhs->mod->m) == 0) { // mpz_sgn(lhs_mpz) > 0
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_mul(rop->e, lhs_mpz, rhs->e);
 		}
 		else {
@@ -698,10 +759,10 @@ static PyObject *Integer_mul(PyObject *o1, PyObject *o2) {
 		}
 	} else if (foundRHS) {
 		// debug("foundRHS!\n");
-		if(mpz_sgn(lhs->m) == 0) {
+		if(mpz_sgn(lhs->mod->m) == 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_mul(rop->e, lhs->e, rhs_mpz);
 		}
 		else {
@@ -709,13 +770,13 @@ static PyObject *Integer_mul(PyObject *o1, PyObject *o2) {
 			ErrorMsg("unsupported operation.");
 		}
 	} else {
-		// debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->m, rhs->m));
+		// debug("Modulus equal? %d =?= 0\n", mpz_cmp(lhs->mod->m, rhs->mod->m));
 		// if modulus is equal
-		if (mpz_cmp(lhs->m, rhs->m) == 0) {
+		if (modulus_cmp(lhs, rhs) == 0) {
 			// compute ((lhs % m) * (rhs % m)) % m (reduce before)
 			rop = createNewInteger();
 			mpz_init_set(rop->e, lhs->e);
-			mpz_init_set(rop->m, lhs->m);
+			rop->mod = modulus_ref(lhs->mod);
 			mpz_mul(rop->e, rop->e, rhs->e);
 		}
 		else {
@@ -740,8 +801,8 @@ static PyObject *Integer_invert(PyObject *o1) {
 		if (base->initialized) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, base->m);
-			int errcode = mpz_invert(rop->e, base->e, base->m);
+			rop->mod = modulus_ref(base->mod);
+			int errcode = mpz_invert(rop->e, base->e, base->mod->m);
 			if (errcode > 0) {
 				return (PyObject *) rop;
 			}
@@ -755,7 +816,7 @@ static PyObject *Integer_invert(PyObject *o1) {
 static PyObject *Integer_long(PyObject *o1) {
 	if (PyInteger_Check(o1)) {
 		Integer *value = (Integer *) o1;
-		if (mpz_sgn(value->m) != 0)
+		if (mpz_sgn(value->mod->m) != 0)
 			_reduce(value);
 		return mpzToLongObj(value->e);
 	}
@@ -769,8 +830,8 @@ static PyObject *Integer_reduce(PyObject *self, PyObject *args) {
 		if(in->initialized) {
 			Integer *rop = createNewInteger();
 			mpz_init_set(rop->e, in->e);
-			mpz_init_set(rop->m, in->m);
-			if (mpz_sgn(rop->m) != 0)
+			rop->mod = modulus_ref(in->mod);
+			if (mpz_sgn(rop->mod->m) != 0)
 				_reduce(rop);
 			return (PyObject *) rop;
 		}
@@ -803,18 +864,18 @@ static PyObject *Integer_div(PyObject *o1, PyObject *o2) {
 		 * in which case there are exactly d solutions between [0, n-1] these solutions are all congruent modulo n/d. */
 		rop = createNewInteger();
 		mpz_init_set(rop->e, lhs->e);
-		mpz_init_set(rop->m, lhs->m);
+		rop->mod = modulus_ref(lhs->mod);
 		if (mpz_divisible_p(lhs->e, rhs_mpz) != 0) {
-			if (mpz_sgn(lhs->m) == 0) {
+			if (mpz_sgn(lhs->mod->m) == 0) {
 				mpz_divexact(rop->e, lhs->e, rhs_mpz);
 			}
 		}
-		else if(mpz_sgn(rop->m) > 0 && mpz_cmp_ui(rhs_mpz, 1) == 0) {
-			mpz_mod(rop->e, rop->e, rop->m);
-			if(mpz_cmp(rop->e, rop->m) < 0) { // check if e < m, then divide e / rhs_value.
+		else if(mpz_sgn(rop->mod->m) > 0 && mpz_cmp_ui(rhs_mpz, 1) == 0) {
+			mpz_mod(rop->e, rop->e, rop->mod->m);
+			if(mpz_cmp(rop->e, rop->mod->m) < 0) { // check if e < m, then divide e / rhs_value.
 //				EXIT_IF(TRUE, "unimplemented operation.");
 //				mpz_init_set_ui(tmp, lhs_value);
-//				mpz_gcd(tmp, tmp, rop->m);
+//				mpz_gcd(tmp, tmp, rop->mod->m);
 //				mpz_div(rop->e, tmp, rop->e);
 //				mpz_clear(tmp);
 			}
@@ -822,10 +883,10 @@ static PyObject *Integer_div(PyObject *o1, PyObject *o2) {
 	} else if (foundLHS && mpz_sgn(lhs_mpz) > 0) {
 		rop = createNewInteger();
 		mpz_init(rop->e);
-		int rhs_mod = mpz_sgn(rhs->m);
+		int rhs_mod = mpz_sgn(rhs->mod->m);
 		if(rhs_mod > 0) {
-			mpz_init_set(rop->m, rhs->m);
-			int errcode = mpz_invert(rop->e, rhs->e, rhs->m);
+			rop->mod = modulus_ref(rhs->mod);
+			int errcode = mpz_invert(rop->e, rhs->e, rhs->mod->m);
 			if(errcode == 0) {
 				Py_DECREF(rop);
 				mpz_clear(lhs_mpz);
@@ -835,34 +896,34 @@ static PyObject *Integer_div(PyObject *o1, PyObject *o2) {
 
 			if(mpz_cmp_ui(lhs_mpz, 1) != 0) {
 				mpz_mul(rop->e, lhs_mpz, rop->e);
-				mpz_mod(rop->e, rop->e, rop->m);
+				mpz_mod(rop->e, rop->e, rop->mod->m);
 			}
 		}
 		else if(rhs_mod == 0 && mpz_divisible_p(lhs_mpz, rhs->e) != 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, rhs->m);
+			rop->mod = modulus_ref(rhs->mod);
 			mpz_divexact(rop->e, lhs_mpz, rhs->e);
 		}
 	} else {
 		//		printf("lhs and rhs init? => ");
-		if (mpz_cmp(lhs->m, rhs->m) == 0 && mpz_sgn(lhs->m) > 0) {
+		if (modulus_cmp(lhs, rhs) == 0 && mpz_sgn(lhs->mod->m) > 0) {
 			mpz_t rhs_inv;
 			mpz_init(rhs_inv);
-			mpz_invert(rhs_inv, rhs->e, rhs->m);
+			mpz_invert(rhs_inv, rhs->e, rhs->mod->m);
 			debug("rhs_inv...\n");
 			print_mpz(rhs_inv, 10);
 
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
+			rop->mod = modulus_ref(lhs->mod);
 			mpz_mul(rop->e, lhs->e, rhs_inv);
-			mpz_mod(rop->e, rop->e, rop->m);
+			mpz_mod(rop->e, rop->e, rop->mod->m);
 			mpz_clear(rhs_inv);
-		} else if (mpz_cmp(lhs->m, rhs->m) == 0 && mpz_sgn(lhs->m) == 0) {
+		} else if (modulus_cmp(lhs, rhs) == 0 && mpz_sgn(lhs->mod->m) == 0) {
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
+			rop->mod = modulus_ref(lhs->mod);
 			mpz_div(rop->e, lhs->e, rhs->e);
 		}
 	}
@@ -880,6 +941,222 @@ static PyObject *Integer_div(PyObject *o1, PyObject *o2) {
 	return (PyObject *) rop;
 }
 
+/* START: Montgomery residues */
+
+/* n-limb residues mod m. Odd moduli use Montgomery form (x * R mod m, R = 2^(GMP_NUMB_BITS * n))
+ * with word-by-word REDC, which is cheaper than dividing after every product; even moduli keep
+ * plain residues and divide. */
+typedef struct {
+	mpz_srcptr mz;
+	const mp_limb_t *m;
+	mp_size_t n;
+	mp_limb_t minv;		/* -m^-1 mod 2^GMP_NUMB_BITS (odd m only) */
+	int mont;
+	mp_limb_t *t, *q;	/* scratch: 2n-limb product and (n + 1)-limb quotient */
+} Residues;
+
+/* FALSE without memory, and then there is nothing to clear */
+static int res_init(Residues *ctx, const mpz_t m) {
+	mp_limb_t inv;
+	int i;
+
+	ctx->mz = m;
+	ctx->m = mpz_limbs_read(m);
+	ctx->n = (mp_size_t) mpz_size(m);
+	ctx->mont = mpz_odd_p(m) ? TRUE : FALSE;
+	ctx->t = (mp_limb_t *) malloc(2 * ctx->n * sizeof(mp_limb_t));
+	ctx->q = (mp_limb_t *) malloc((ctx->n + 1) * sizeof(mp_limb_t));
+	if (ctx->t == NULL || ctx->q == NULL) {
+		free(ctx->t);
+		free(ctx->q);
+		return FALSE;
+	}
+	if (ctx->mont) {
+		// Newton iteration: each step doubles the number of correct low bits
+		inv = ctx->m[0];
+		for (i = 0; i < 6; i++) inv *= 2 - ctx->m[0] * inv;
+		ctx->minv = -inv;
+	}
+	return TRUE;
+}
+
+static void res_clear(Residues *ctx) {
+	free(ctx->t);
+	free(ctx->q);
+}
+
+/* r = t / R mod m for t < m * R held in 2n limbs; destroys t */
+static void res_redc(const Residues *ctx, mp_limb_t *r, mp_limb_t *t) {
+	mp_size_t i, n = ctx->n;
+	mp_limb_t cy;
+	for (i = 0; i < n; i++) {
+		// zeroes t[i]; the carry belongs at t[i + n] and is parked in t[i] until the end
+		t[i] = mpn_addmul_1(t + i, ctx->m, n, t[i] * ctx->minv);
+	}
+	cy = mpn_add_n(r, t + n, t, n);
+	// subtract m when r >= m, without branching on it
+	mpn_cnd_sub_n(cy | (mpn_sub_n(t, r, ctx->m, n) == 0), r, r, ctx->m, n);
+}
+
+/* r = a * b in the residue representation; r may alias a or b */
+static void res_mul(const Residues *ctx, mp_limb_t *r, const mp_limb_t *a, const mp_limb_t *b) {
+	if (a == b) mpn_sqr(ctx->t, a, ctx->n);
+	else mpn_mul_n(ctx->t, a, b, ctx->n);
+	if (ctx->mont) res_redc(ctx, r, ctx->t);
+	else mpn_tdiv_qr(ctx->q, r, 0, ctx->t, 2 * ctx->n, ctx->m, ctx->n);
+}
+
+/* r = representation of x, 0 <= x < m */
+static void res_from_mpz(const Residues *ctx, mp_limb_t *r, const mpz_t x) {
+	mpz_t y;
+	mpz_init(y);
+	if (ctx->mont) {
+		mpz_mul_2exp(y, x, GMP_NUMB_BITS * ctx->n);
+		mpz_mod(y, y, ctx->mz);
+	}
+	else {
+		mpz_set(y, x);
+	}
+	mpn_zero(r, ctx->n);
+	mpn_copyi(r, mpz_limbs_read(y), (mp_size_t) mpz_size(y));
+	mpz_clear(y);
+}
+
+static void res_to_mpz(const Residues *ctx, mpz_t r, const mp_limb_t *x) {
+	mpz_t y;
+	if (ctx->mont) {
+		mpn_zero(ctx->t, 2 * ctx->n);
+		mpn_copyi(ctx->t, x, ctx->n);
+		res_redc(ctx, mpz_limbs_write(r, ctx->n), ctx->t);
+		mpz_limbs_finish(r, ctx->n);
+	}
+	else {
+		mpz_set(r, mpz_roinit_n(y, x, ctx->n));
+	}
+}
+
+/* END: Montgomery residues */
+
+/* START: fixed-base tables */
+
+void pp_free(IntegerPP *pp) {
+	if (pp != NULL) {
+		free(pp->table);
+		free(pp);
+	}
+}
+
+/* table entry j of window i is base^(j * 2^(PP_WINDOW * i)) mod m in Montgomery form (m is odd) */
+static IntegerPP *pp_build(const mpz_t base, const mpz_t m, size_t exp_bits) {
+	IntegerPP *pp = (IntegerPP *) malloc(sizeof(IntegerPP));
+	Residues ctx;
+	mpz_t b, x;
+	int i, j;
+
+	if (pp == NULL) return NULL;
+	pp->nlimbs = (mp_size_t) mpz_size(m);
+	pp->exp_bits = exp_bits;
+	pp->windows = (int) ((exp_bits + PP_WINDOW - 1) / PP_WINDOW);
+	pp->table = (mp_limb_t *) malloc((size_t) pp->windows * PP_ENTRIES * pp->nlimbs * sizeof(mp_limb_t));
+	if (pp->table == NULL || !res_init(&ctx, m)) {
+		free(pp->table);
+		free(pp);
+		return NULL;
+	}
+
+	mpz_init(b);
+	mpz_init(x);
+	mpz_mod(b, base, m);
+	for (i = 0; i < pp->windows; i++) {
+		mpz_set_ui(x, 1);
+		for (j = 0; j < PP_ENTRIES; j++) {
+			res_from_mpz(&ctx, pp->table + ((size_t) i * PP_ENTRIES + j) * pp->nlimbs, x);
+			mpz_mul(x, x, b);
+			mpz_mod(x, x, m);
+		}
+		// x = b^PP_ENTRIES: the base of the next window
+		mpz_set(b, x);
+	}
+	mpz_clear(b);
+	mpz_clear(x);
+	res_clear(&ctx);
+	return pp;
+}
+
+/* rop = base^e mod m from the table. Each window costs one mpn_sec_tabselect and one
+ * fixed-width Montgomery multiplication, so neither the memory access pattern nor the running
+ * time depends on e. Returns FALSE if e is out of the table's range. */
+static int pp_powm(mpz_t rop, const IntegerPP *pp, const mpz_t e, const mpz_t m) {
+	Residues ctx;
+	mp_limb_t *sel, *acc;
+	mpz_t one;
+	int i, k, digit;
+
+	if (mpz_sgn(e) < 0 || mpz_sizeinbase(e, 2) > pp->exp_bits)
+		return FALSE;
+
+	sel = (mp_limb_t *) malloc(pp->nlimbs * sizeof(mp_limb_t));
+	acc = (mp_limb_t *) malloc(pp->nlimbs * sizeof(mp_limb_t));
+	if (sel == NULL || acc == NULL || !res_init(&ctx, m)) {
+		free(sel);
+		free(acc);
+		return FALSE;
+	}
+	mpz_init_set_ui(one, 1);
+	res_from_mpz(&ctx, acc, one);
+	mpz_clear(one);
+	for (i = 0; i < pp->windows; i++) {
+		digit = 0;
+		for (k = 0; k < PP_WINDOW; k++) {
+			digit |= mpz_tstbit(e, i * PP_WINDOW + k) << k;
+		}
+		mpn_sec_tabselect(sel, pp->table + (size_t) i * PP_ENTRIES * pp->nlimbs, pp->nlimbs, PP_ENTRIES, digit);
+		res_mul(&ctx, acc, acc, sel);
+	}
+	res_to_mpz(&ctx, rop, acc);
+	// m = 1: the representation of 1 is not reduced
+	mpz_mod(rop, rop, m);
+	free(sel);
+	free(acc);
+	res_clear(&ctx);
+	return TRUE;
+}
+
+/* rop = base^e mod base's modulus: the fixed-base table when there is one, mpz_powm_sec otherwise */
+static void integer_powm(mpz_t rop, Integer *base, const mpz_t e) {
+	if (base->pp == NULL || !pp_powm(rop, base->pp, e, base->mod->m)) {
+		mpz_powm_sec(rop, base->e, e, base->mod->m);
+	}
+}
+
+static PyObject *Integer_initPP(Integer *self, PyObject *args) {
+	int exp_bits = 0;
+	IntegerPP *pp = NULL;
+
+	if (!PyArg_ParseTuple(args, "|i", &exp_bits)) {
+		ErrorMsg("invalid argument: expected the exponent size in bits.");
+	}
+	EXIT_IF(!self->initialized, "integer object not initialized.");
+	EXIT_IF(mpz_sgn(self->mod->m) <= 0 || !self->mod->odd, "fixed-base tables need an odd modulus.");
+	if (self->pp != NULL) {
+		PyErr_SetString(PyExc_ValueError, "Pre-processing table alreay initialized.");
+		return NULL;
+	}
+	// default to exponents as large as the modulus
+	if (exp_bits <= 0) exp_bits = (int) self->mod->bits;
+
+	Py_BEGIN_ALLOW_THREADS
+	pp = pp_build(self->e, self->mod->m, (size_t) exp_bits);
+	Py_END_ALLOW_THREADS
+	if (pp == NULL) {
+		return PyErr_NoMemory();
+	}
+	self->pp = pp;
+	Py_RETURN_TRUE;
+}
+
+/* END: fixed-base tables */
+
 static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 	Integer *lhs = NULL, *rhs = NULL, *rop = NULL;
 	int foundLHS = FALSE, foundRHS = FALSE;
@@ -903,17 +1180,17 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 			//PyErr_Print(); // for debug purposes
 			PyErr_Clear();
 			debug("exponent is positive\n");
-			int sgn = mpz_sgn(lhs->m);
+			int sgn = mpz_sgn(lhs->mod->m);
 			if(sgn > 0)  {
-				if(mpz_odd_p(lhs->m) > 0) {
+				if(lhs->mod->odd) {
 //					mpz_t exp;
 // 					mpz_init(exp);
 //					longObjToMPZ(exp, o2);
 //					print_mpz(exp, 10);
 					rop = createNewInteger();
 					mpz_init(rop->e);
-					mpz_init_set(rop->m, lhs->m);
-					mpz_powm_sec(rop->e, lhs->e, exponent, rop->m);
+					rop->mod = modulus_ref(lhs->mod);
+					integer_powm(rop->e, lhs, exponent);
 				 }
 			}
 			else if(sgn == 0) { // no modulus
@@ -921,7 +1198,7 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 				EXIT_IF(PyErr_Occurred(), "integer too large to exponentiate without modulus.");
 				rop = createNewInteger();
 				mpz_init(rop->e);
-				mpz_init_set(rop->m, lhs->m);
+				rop->mod = modulus_ref(lhs->mod);
 				mpz_pow_ui(rop->e, lhs->e, exp);
 			}
 			else {
@@ -933,8 +1210,8 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 			debug("find modular inverse.\n");
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
-			int errcode = mpz_invert(rop->e, lhs->e, lhs->m);
+			rop->mod = modulus_ref(lhs->mod);
+			int errcode = mpz_invert(rop->e, lhs->e, lhs->mod->m);
 			if(errcode == 0) {
 				Py_XDECREF(rop);
 				mpz_clear(exponent);
@@ -945,11 +1222,11 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 			// less than -1.
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
-			int errcode = mpz_invert(rop->e, lhs->e, rop->m);
+			rop->mod = modulus_ref(lhs->mod);
+			int errcode = mpz_invert(rop->e, lhs->e, rop->mod->m);
 			if(errcode > 0) {
 				mpz_neg(exponent, exponent);
-				mpz_powm_sec(rop->e, rop->e, exponent, rop->m);
+				mpz_powm_sec(rop->e, rop->e, exponent, rop->mod->m);
 			}
 			else {
 				mpz_clear(exponent);
@@ -964,17 +1241,17 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 	} else {
 		// if rhs has negative exponent
 		if (mpz_sgn(rhs->e) < 0) {
-			if(mpz_sgn(lhs->m) > 0) {
+			if(mpz_sgn(lhs->mod->m) > 0) {
 				// base modulus is positive
 				rop = createNewInteger();
 				mpz_init(rop->e);
-				mpz_init_set(rop->m, lhs->m);
-				int errcode = mpz_invert(rop->e, lhs->e, rop->m);
+				rop->mod = modulus_ref(lhs->mod);
+				int errcode = mpz_invert(rop->e, lhs->e, rop->mod->m);
 				if(errcode > 0) {
 					mpz_t exp;
 					mpz_init_set(exp, rhs->e);
 					mpz_neg(exp, exp);
-					mpz_powm_sec(rop->e, rop->e, exp, rop->m);
+					mpz_powm_sec(rop->e, rop->e, exp, rop->mod->m);
 					mpz_clear(exp);
 					goto leave;
 				}
@@ -988,12 +1265,12 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 
 		// result takes modulus of base
 		debug("both integer objects: ");
-		if (mpz_sgn(lhs->m) > 0) {
+		if (mpz_sgn(lhs->mod->m) > 0) {
 			// common case for modular exponentiation
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init_set(rop->m, lhs->m);
-			mpz_powm_sec(rop->e, lhs->e, rhs->e, rop->m);
+			rop->mod = modulus_ref(lhs->mod);
+			integer_powm(rop->e, lhs, rhs->e);
 		}
 		// lhs is a reg int
 		else if (mpz_fits_ulong_p(lhs->e) && mpz_fits_ulong_p(rhs->e)) {
@@ -1002,7 +1279,7 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 			unsigned long int exp = mpz_get_ui(rhs->e);
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_ui_pow_ui(rop->e, base, exp);
 		}
 		// lhs reg int and rhs can be represented as ulong
@@ -1010,7 +1287,7 @@ static PyObject *Integer_pow(PyObject *o1, PyObject *o2, PyObject *o3) {
 			unsigned long int exp = mpz_get_ui(rhs->e);
 			rop = createNewInteger();
 			mpz_init(rop->e);
-			mpz_init(rop->m);
+			rop->mod = modulus_ref(&no_modulus);
 			mpz_pow_ui(rop->e, lhs->e, exp);
 		} else { // last option...
 			// cannot represent reg ints as ulong's, so error out.
@@ -1025,6 +1302,62 @@ leave:
 	return (PyObject *) rop;
 }
 
+/* rop = value of an integer object or python int; returns FALSE for any other type */
+static int objectToMPZ(mpz_t rop, PyObject *obj) {
+	if (PyInteger_Check(obj)) {
+		mpz_set(rop, ((Integer *) obj)->e);
+		return TRUE;
+	}
+	else if (_PyLong_Check(obj)) {
+		longObjToMPZ(rop, obj);
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/*
+ * Description: x^e mod n with mpz_powm (sliding window, variable time). Integer_pow uses
+ * mpz_powm_sec so that secret exponents don't leak through timing; this is for exponents
+ * that are public anyway, e.g. an RSA public exponent or a Paillier modulus n.
+ * inputs: modular integer x and exponent e (integer object or python int)
+ */
+static PyObject *powm_public(PyObject *self, PyObject *args) {
+	PyObject *base = NULL, *exp = NULL;
+	Integer *lhs = NULL, *rop = NULL;
+	mpz_t e;
+
+	if (!PyArg_ParseTuple(args, "OO", &base, &exp)) {
+		ErrorMsg("invalid argument types: expected base and exponent.");
+	}
+	EXIT_IF(!PyInteger_Check(base) || mpz_sgn(((Integer *) base)->mod->m) <= 0,
+			"base must be an integer with a positive modulus.");
+	lhs = (Integer *) base;
+
+	mpz_init(e);
+	if (!objectToMPZ(e, exp)) {
+		mpz_clear(e);
+		ErrorMsg("exponent must be an integer.");
+	}
+
+	rop = createNewInteger();
+	mpz_init(rop->e);
+	rop->mod = modulus_ref(lhs->mod);
+	if (mpz_sgn(e) < 0) {
+		// mpz_powm would raise a division by zero if the inverse doesn't exist
+		if (mpz_invert(rop->e, lhs->e, rop->mod->m) == 0) {
+			mpz_clear(e);
+			Py_DECREF(rop);
+			ErrorMsg("failed to find modular inverse.");
+		}
+		mpz_neg(e, e);
+		mpz_powm(rop->e, rop->e, e, rop->mod->m);
+	} else {
+		mpz_powm(rop->e, lhs->e, e, rop->mod->m);
+	}
+	mpz_clear(e);
+	return (PyObject *) rop;
+}
+
 /*
  * Description: hash elements into a group element
  * inputs: group elements, p, q, and True or False
@@ -1162,7 +1495,7 @@ static PyObject *Integer_hash(PyObject *self, PyObject *args) {
 			print_mpz(v, 10);
 			Integer *rop = createNewInteger();
 			mpz_init_set(rop->e, v);
-			mpz_init_set(rop->m, modulus);
+			rop->mod = modulus_get(modulus);
 			mpz_clear(p);
 			mpz_clear(q);
 			mpz_clear(v);
@@ -1178,7 +1511,7 @@ static PyObject *Integer_hash(PyObject *self, PyObject *args) {
 				goto cleanup;
 			}
 			// not a group element
-			if (mpz_cmp(p, obj->m) != 0) {
+			if (mpz_cmp(p, obj->mod->m) != 0) {
 				PyErr_SetString(IntegerError,
 						"integer object not a group element.");
 				goto cleanup;
@@ -1241,7 +1574,7 @@ static PyObject *Integer_hash(PyObject *self, PyObject *args) {
 			print_mpz(v, 10);
 			Integer *rop = createNewInteger();
 			mpz_init_set(rop->e, v);
-			mpz_init_set(rop->e, modulus);
+			rop->mod = modulus_get(modulus);
 			mpz_clear(v);
 			mpz_clear(p);
 			mpz_clear(q);
@@ -1285,41 +1618,41 @@ static PyObject *Integer_remainder(PyObject *o1, PyObject *o2) {
 	if (foundLHS) {
 		rop = createNewInteger();
 		mpz_init(rop->e);
-		mpz_init_set(rop->m, rhs->m);
+		rop->mod = modulus_ref(rhs->mod);
 		if (_PyLong_Check(o1)) {
 			PyObject *tmp = PyNumber_Long(o1);
 			mpz_t e;
 			mpz_init(e);
 			longObjToMPZ(e, tmp);
 			mpz_mod(rop->e, e, rhs->e);
-			mpz_set(rop->m, rhs->e);
+			set_modulus(rop, rhs->e);
 			mpz_clear(e);
 			Py_XDECREF(tmp);
 		} else if (PyInteger_Check(o1)) {
 			Integer *tmp_mod = (Integer *) o1;
 			// ignore the modulus of tmp_mod
 			mpz_mod(rop->e, rhs->e, tmp_mod->e);
-			mpz_set(rop->m, tmp_mod->e);
+			set_modulus(rop, tmp_mod->e);
 		}
 	} else if (foundRHS) {
 		rop = createNewInteger();
 		mpz_init(rop->e);
-		mpz_init_set(rop->m, lhs->m);
+		rop->mod = modulus_ref(lhs->mod);
 		if (_PyLong_Check(o2)) {
 			PyObject *tmp = PyNumber_Long(o2);
 			mpz_t modulus;
 			mpz_init(modulus);
 			longObjToMPZ(modulus, tmp);
 			mpz_mod(rop->e, lhs->e, modulus);
-			mpz_set(rop->m, modulus);
+			set_modulus(rop, modulus);
 			mpz_clear(modulus);
 			Py_XDECREF(tmp);
 		}
 	} else {
 		rop = createNewInteger();
 		mpz_init(rop->e);
-		mpz_init_set(rop->m, rhs->e);
-		mpz_mod(rop->e, lhs->e, rop->m);
+		rop->mod = modulus_get(rhs->e);
+		mpz_mod(rop->e, lhs->e, rop->mod->m);
 	}
 	return (PyObject *) rop;
 }
@@ -1362,40 +1695,43 @@ static PyObject *testPrimality(PyObject *self, PyObject *arg) {
 	}
 }
 
+/* r = uniformly random in [0, n) for n > 0, by rejection on bitsize(n)-bit draws */
+static int random_below(mpz_t r, const mpz_t n) {
+	size_t bits = mpz_sizeinbase(n, 2), len = (bits + 7) / 8;
+	unsigned char *buf = (unsigned char *) malloc(len);
+	int ok;
+
+	do {
+		ok = drbg_bytes(buf, len);
+		mpz_import(r, len, 1, 1, 0, 0, buf);
+		mpz_fdiv_r_2exp(r, r, bits);
+	} while (ok && mpz_cmp(r, n) >= 0);
+	OPENSSL_cleanse(buf, len);
+	free(buf);
+	return ok;
+}
+
 static PyObject *genRandomBits(PyObject *self, PyObject *args) {
-	unsigned int bits;
+	int bits;
 
 	if (PyArg_ParseTuple(args, "i", &bits)) {
 		if (bits > 0) {
 			// generate random number that is in 0 to 2^n-1 range.
-			// TODO: fix code very very soon!
-			PyLongObject *v;
-			unsigned char buff[sizeof(long)];
-			long t;
-			int ndigits = (bits + PyLong_SHIFT - 1) / PyLong_SHIFT;
-			int digitsleft = ndigits;
-			int bitsleft = bits;
-
-			v = _PyLong_New(ndigits);
-			if (v != NULL) {
-				digit *p = v->ob_digit;
-				while (digitsleft > 1) {
-					RAND_bytes(buff, sizeof(long));
-					memcpy(&t, buff, sizeof(long));
-					*p++ = (digit)(t & PyLong_MASK);
-					digitsleft--;
-					bitsleft -= PyLong_SHIFT;
-				}
-
-				if (digitsleft == 1) {
-					RAND_bytes(buff, sizeof(long));
-					memcpy(&t, buff, sizeof(long));
-					unsigned long mask = (1 << bitsleft) - 1;
-					*p++ = (digit)(t & PyLong_MASK & mask);
-				}
-
+			size_t len = (bits + 7) / 8;
+			unsigned char *buf = (unsigned char *) malloc(len);
+			PyObject *v = NULL;
+
+			if (drbg_bytes(buf, len)) {
+				// little endian: the excess bits are in the last byte
+				buf[len - 1] &= 0xff >> (8 * len - bits);
+				v = _PyLong_FromByteArray(buf, len, 1, 0);
 			}
-			return (PyObject *) v;
+			else {
+				PyErr_SetString(IntegerError, "failed to seed the random generator.");
+			}
+			OPENSSL_cleanse(buf, len);
+			free(buf);
+			return v;
 		}
 	}
 
@@ -1420,51 +1756,205 @@ static PyObject *genRandom(PyObject *self, PyObject *args) {
 			EXIT_IF(TRUE, "invalid object type.");
 		}
 
-		BIGNUM *s = BN_new(), *bN = BN_new();
-		BN_one(s);
-		mpzToBN(N, bN);
+		if (mpz_sgn(N) <= 0) {
+			mpz_clear(N);
+			EXIT_IF(TRUE, "range must be > 0.");
+		}
 		rop = createNewInteger();
 		mpz_init(rop->e);
-		mpz_init_set(rop->m, N);
+		rop->mod = modulus_get(N);
 
-		BN_rand_range(s, bN);
-		bnToMPZ(s, rop->e);
-		print_bn_dec(s);
-		BN_free(s);
-		BN_free(bN);
+		if (!random_below(rop->e, N)) {
+			mpz_clear(N);
+			Py_DECREF(rop);
+			EXIT_IF(TRUE, "failed to seed the random generator.");
+		}
 		mpz_clear(N);
 		return (PyObject *) rop;
 	}
 	EXIT_IF(TRUE, "invalid arguments.");
 }
 
-/* takes as input the number of bits and produces a prime number of that size. */
-static PyObject *genRandomPrime(PyObject *self, PyObject *args) {
-	int bits, safe = FALSE;
+/* odd primes below SIEVE_LIMIT, filled in by the first randomPrime call */
+static unsigned int *sieve_primes = NULL;
+static int sieve_count = 0;
+static pthread_once_t sieve_once = PTHREAD_ONCE_INIT;
+
+static void sieve_init(void) {
+	char *composite = (char *) calloc(SIEVE_LIMIT, 1);
+	unsigned long i, j;
+	sieve_primes = (unsigned int *) malloc(SIEVE_LIMIT / 8 * sizeof(unsigned int));
+	for (i = 3; i < SIEVE_LIMIT; i += 2) {
+		if (composite[i]) continue;
+		sieve_primes[sieve_count++] = (unsigned int) i;
+		for (j = i * i; j < SIEVE_LIMIT; j += 2 * i) composite[j] = 1;
+	}
+	free(composite);
+}
 
-	if (PyArg_ParseTuple(args, "i|i", &bits, &safe)) {
-		if (bits > 0) {
-			// mpz_t tmp;
-			Integer *rop = createNewInteger();
-			mpz_init(rop->e);
-			mpz_init(rop->m);
-
-			BIGNUM *bn = BN_new();
-			/* This routine generates safe prime only when safe=TRUE in which prime, p is selected
-			 * iff (p-1)/2 is also prime.
-			 */
-			if(safe == TRUE) // safe is non-zero
-				BN_generate_prime(bn, bits, safe, NULL, NULL, NULL, NULL);
-			else
-				/* generate strong primes only */
-				BN_generate_prime(bn, bits, FALSE, NULL, NULL, NULL, NULL);
+static int prime_search_done(PrimeSearch *s) {
+	int found;
+	pthread_mutex_lock(&s->lock);
+	found = s->found;
+	pthread_mutex_unlock(&s->lock);
+	return found;
+}
 
-			debug("Safe prime => ");
-			print_bn_dec(bn);
-			bnToMPZ(bn, rop->e);
-			BN_free(bn);
-			return (PyObject *) rop;
+/* stops every thread: a prime from an unseeded start must not be returned */
+static void prime_search_fail(PrimeSearch *s) {
+	pthread_mutex_lock(&s->lock);
+	s->found = s->failed = TRUE;
+	pthread_mutex_unlock(&s->lock);
+}
+
+/* a base-2 Fermat test first since it rejects nearly every sieve survivor with a single
+ * exponentiation; the final word is mpz_probab_prime_p */
+static int fermat2(const mpz_t c, mpz_t t, mpz_t e) {
+	mpz_set_ui(t, 2);
+	mpz_sub_ui(e, c, 1);
+	mpz_powm_sec(t, t, e, c);
+	return mpz_cmp_ui(t, 1) == 0;
+}
+
+/* c (and p = 2c + 1 for safe primes) passed the sieve */
+static int prime_candidate(PrimeSearch *s, const mpz_t c, mpz_t p, mpz_t t, mpz_t e) {
+	if (!fermat2(c, t, e)) return FALSE;
+	if (s->safe) {
+		mpz_mul_2exp(p, c, 1);
+		mpz_add_ui(p, p, 1);
+		if (!fermat2(p, t, e)) return FALSE;
+	}
+	if (mpz_probab_prime_p(c, MAX_RUN) == 0) return FALSE;
+	return !s->safe || mpz_probab_prime_p(p, MAX_RUN) > 0;
+}
+
+/* search thread: starting from a random odd x, sieve the window x, x + 2, ..., x + 2(SIEVE_WINDOW - 1)
+ * and test the survivors, then move x past the window and update the residues x mod pr in place.
+ * A new random x is drawn only when the candidates outgrow the requested size. */
+static void *prime_search(void *arg) {
+	PrimeSearch *s = (PrimeSearch *) arg;
+	int cbits = s->safe ? s->bits - 1 : s->bits, len = (cbits + 7) / 8, nprimes = 0, fresh = TRUE, i;
+	unsigned char *buf = (unsigned char *) malloc(len);
+	char *composite = (char *) malloc(SIEVE_WINDOW);
+	unsigned int *residue = (unsigned int *) malloc(sieve_count * sizeof(unsigned int));
+	unsigned long pr, r, k, half, limit;
+	mpz_t x, c, p, t, e;
+
+	mpz_init(x);
+	mpz_init(c);
+	mpz_init(p);
+	mpz_init(t);
+	mpz_init(e);
+	// only sieve by primes below every candidate, or small candidates would strike themselves
+	limit = (cbits - 1 < 32) ? (1UL << (cbits - 1)) : SIEVE_LIMIT;
+	while (nprimes < sieve_count && sieve_primes[nprimes] < limit) nprimes++;
+	if (buf == NULL || composite == NULL || residue == NULL) prime_search_fail(s);
+
+	while (!prime_search_done(s)) {
+		if (fresh) {
+			if (!drbg_bytes(buf, len)) {
+				prime_search_fail(s);
+				break;
+			}
+			mpz_import(x, len, 1, 1, 0, 0, buf);
+			mpz_fdiv_r_2exp(x, x, cbits);
+			mpz_setbit(x, cbits - 1);
+			mpz_setbit(x, 0);
+			for (i = 0; i < nprimes; i++) residue[i] = (unsigned int) mpz_fdiv_ui(x, sieve_primes[i]);
+			fresh = FALSE;
+		}
+
+		memset(composite, 0, SIEVE_WINDOW);
+		for (i = 0; i < nprimes; i++) {
+			pr = sieve_primes[i];
+			half = (pr + 1) / 2;	// inverse of 2 mod pr
+			r = residue[i];
+			// pr | x + 2k
+			for (k = (pr - r) % pr * half % pr; k < SIEVE_WINDOW; k += pr) composite[k] = 1;
+			if (s->safe) {
+				// pr | 2(x + 2k) + 1, i.e. x + 2k = (pr - 1) / 2 mod pr
+				for (k = ((pr - 1) / 2 + pr - r) % pr * half % pr; k < SIEVE_WINDOW; k += pr) composite[k] = 1;
+			}
+			residue[i] = (unsigned int) ((r + 2 * SIEVE_WINDOW) % pr);
+		}
+
+		for (k = 0; k < SIEVE_WINDOW; k++) {
+			if (composite[k]) continue;
+			mpz_add_ui(c, x, 2 * k);
+			if (mpz_sizeinbase(c, 2) > (size_t) cbits) {
+				fresh = TRUE;
+				break;
+			}
+			if (prime_search_done(s)) break;
+			if (!prime_candidate(s, c, p, t, e)) continue;
+
+			pthread_mutex_lock(&s->lock);
+			if (!s->found) {
+				mpz_set(s->result, s->safe ? p : c);
+				s->found = TRUE;
+			}
+			pthread_mutex_unlock(&s->lock);
+			break;
+		}
+		mpz_add_ui(x, x, 2 * SIEVE_WINDOW);
+	}
+
+	if (buf != NULL) OPENSSL_cleanse(buf, len);
+	free(buf);
+	free(composite);
+	free(residue);
+	mpz_clear(x);
+	mpz_clear(c);
+	mpz_clear(p);
+	mpz_clear(t);
+	mpz_clear(e);
+	return NULL;
+}
+
+/* takes as input the number of bits and produces a prime number of that size. The optional
+ * arguments ask for a safe prime p = 2q + 1 and set the number of search threads (default:
+ * one per online CPU). */
+static PyObject *genRandomPrime(PyObject *self, PyObject *args) {
+	int bits, safe = FALSE, threads = 0, i, started = 0;
+	pthread_t tid[PRIME_MAX_THREADS];
+	PrimeSearch s;
+	Integer *rop = NULL;
+
+	if (PyArg_ParseTuple(args, "i|ii", &bits, &safe, &threads)) {
+		EXIT_IF(bits < (safe ? 3 : 2), "number of bits too small for a prime.");
+		EXIT_IF(threads < 0, "number of threads must be >= 0.");
+		if (threads == 0) threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+		if (threads < 1) threads = 1;
+		if (threads > PRIME_MAX_THREADS) threads = PRIME_MAX_THREADS;
+
+		pthread_once(&sieve_once, sieve_init);
+		s.bits = bits;
+		s.safe = safe ? TRUE : FALSE;
+		s.found = s.failed = FALSE;
+		pthread_mutex_init(&s.lock, NULL);
+		mpz_init(s.result);
+
+		Py_BEGIN_ALLOW_THREADS
+		for (i = 1; i < threads; i++) {
+			if (pthread_create(&tid[started], NULL, prime_search, &s) != 0) break;
+			started++;
+		}
+		// the calling thread searches too, so a failed pthread_create only costs parallelism
+		prime_search(&s);
+		for (i = 0; i < started; i++) pthread_join(tid[i], NULL);
+		Py_END_ALLOW_THREADS
+
+		if (s.failed) {
+			mpz_clear(s.result);
+			pthread_mutex_destroy(&s.lock);
+			EXIT_IF(TRUE, "failed to seed the random generator.");
 		}
+		rop = createNewInteger();
+		mpz_init_set(rop->e, s.result);
+		rop->mod = modulus_ref(&no_modulus);
+		mpz_clear(s.result);
+		pthread_mutex_destroy(&s.lock);
+		return (PyObject *) rop;
 	}
 
 	EXIT_IF(TRUE, "invalid input.");
@@ -1556,7 +2046,7 @@ static PyObject *encode_message(PyObject *self, PyObject *args) {
 
 			rop2 = createNewInteger();
 			mpz_init(rop2->e);
-			mpz_init_set(rop2->m, p);
+			rop2->mod = modulus_get(p);
 			mpz_set(rop2->e, tmp);
 		} else {
 			// debug("Order of group => '%zd'\n", mpz_sizeinbase(p, 2));
@@ -1571,7 +2061,7 @@ static PyObject *encode_message(PyObject *self, PyObject *args) {
 
 			rop2 = createNewInteger();
 			mpz_init(rop2->e);
-			mpz_init_set(rop2->m, p);
+			rop2->mod = modulus_get(p);
 			mpz_set(rop2->e, tmp);
 		}
 		mpz_clear(rop);
@@ -1682,7 +2172,7 @@ static PyObject *testCoPrime(Integer *self, PyObject *arg) {
 		}
 
 	} else {
-		mpz_gcd(rop, self->e, self->m);
+		mpz_gcd(rop, self->e, self->mod->m);
 		print_mpz(rop, 1);
 		result = (mpz_cmp_ui(rop, 1) == 0) ? TRUE : FALSE;
 	}
@@ -1716,7 +2206,7 @@ static PyObject *testCongruency(Integer *self, PyObject *args) {
 				mpz_init(rop);
 				longObjToMPZ(rop, obj2);
 				Py_XDECREF(obj2);
-				if (mpz_congruent_p(rop, self->e, self->m) != 0) {
+				if (mpz_congruent_p(rop, self->e, self->mod->m) != 0) {
 					mpz_clear(rop);
 					Py_INCREF(Py_True);
 					return Py_True;
@@ -1728,7 +2218,7 @@ static PyObject *testCongruency(Integer *self, PyObject *args) {
 			}
 		} else if (PyInteger_Check(obj)) {
 			Integer *obj2 = (Integer *) obj;
-			if (obj2->initialized && mpz_congruent_p(obj2->e, self->e, self->m)
+			if (obj2->initialized && mpz_congruent_p(obj2->e, self->e, self->mod->m)
 					!= 0) {
 				Py_INCREF(Py_True);
 				return Py_True;
@@ -1809,7 +2299,7 @@ static PyObject *gcdCall(PyObject *self, PyObject *args) {
 
 		Integer *rop = createNewInteger();
 		mpz_init(rop->e);
-		mpz_init(rop->m);
+		rop->mod = modulus_ref(&no_modulus);
 		mpz_gcd(rop->e, op1, op2);
 		mpz_clear(op1);
 		mpz_clear(op2);
@@ -1849,7 +2339,7 @@ static PyObject *lcmCall(PyObject *self, PyObject *args) {
 
 		Integer *rop = createNewInteger();
 		mpz_init(rop->e);
-		mpz_init(rop->m);
+		rop->mod = modulus_ref(&no_modulus);
 		mpz_lcm(rop->e, op1, op2);
 		mpz_clear(op1);
 		mpz_clear(op2);
@@ -1859,200 +2349,2274 @@ static PyObject *lcmCall(PyObject *self, PyObject *args) {
 	EXIT_IF(TRUE, "invalid input.");
 }
 
-static PyObject *serialize(PyObject *self, PyObject *args) {
-	Integer *obj = NULL;
-	int isNeg;
-
-	if (!PyArg_ParseTuple(args, "O", &obj)) {
-		ErrorMsg("invalid argument");
+/*
+ * Invert a list of modular integers sharing the same modulus using Montgomery's
+ * trick: one mpz_invert plus three multiplications per element.
+ */
+static PyObject *batch_invert(PyObject *self, PyObject *arg) {
+	PyObject *seq = NULL, *result = NULL;
+	Integer *first = NULL;
+	int i, n;
+
+	seq = PySequence_Fast(arg, "expected a list of modular integers.");
+	if (seq == NULL) return NULL;
+	n = (int) PySequence_Fast_GET_SIZE(seq);
+
+	for (i = 0; i < n; i++) {
+		Integer *item = (Integer *) PySequence_Fast_GET_ITEM(seq, i);
+		if (!PyInteger_Check(item) || !item->initialized || mpz_sgn(item->mod->m) <= 0
+				|| (first != NULL && modulus_cmp(item, first) != 0)) {
+			Py_DECREF(seq);
+			EXIT_IF(TRUE, "can only invert a list of integers with the same modulus.");
+		}
+		if (first == NULL) first = item;
 	}
-	if(!PyInteger_Check(obj)) EXIT_IF(TRUE, "not a valid element object.");
-
-	// export the object first
-	size_t count1 = 0, count2 = 0;
-	char *base64_rop = NULL, *base64_rop2 = NULL;
-	PyObject *bytes1 = NULL, *bytes2 = NULL;
-//	if (mpz_sgn(obj->e) > 0) {
-		uint8_t *rop = (uint8_t *) mpz_export(NULL, &count1, 1, sizeof(char),
-				0, 0, obj->e);
-		// convert string to base64 encoding
-		size_t length = 0;
-		base64_rop = NewBase64Encode(rop, count1, FALSE, &length);
-		isNeg = mpz_sgn(obj->e) < 0 ? TRUE : FALSE;
-		// convert to bytes (length : base64 integer)
-		bytes1 = PyBytes_FromFormat("%d:%d:%s:", isNeg, (int) length,
-				(const char *) base64_rop);
-		free(base64_rop);
-		free(rop);
-//	}
 
-	if (mpz_sgn(obj->m) > 0) {
-		uint8_t *rop2 = (uint8_t *) mpz_export(NULL, &count2, 1, sizeof(char),
-				0, 0, obj->m);
-		size_t length2 = 0;
-		base64_rop2 = NewBase64Encode(rop2, count2, FALSE, &length2);
-		// convert to bytes
-		bytes2 = PyBytes_FromFormat("%d:%s:", (int) length2,
-				(const char *) base64_rop2);
-		free(base64_rop2);
-		free(rop2);
+	result = PyList_New(n);
+	if (result == NULL || n == 0) {
+		Py_DECREF(seq);
+		return result;
 	}
 
-	if (bytes2 != NULL && bytes1 != NULL) {
-		PyBytes_ConcatAndDel(&bytes1, bytes2);
-		return bytes1;
-	} else if (bytes1 != NULL) {
-		return bytes1;
-	} else {
-		EXIT_IF(TRUE, "invalid integer object.");
+	mpz_t acc;
+	mpz_init_set_ui(acc, 1);
+	// result[i] = a[0] * ... * a[i-1] mod m
+	for (i = 0; i < n; i++) {
+		Integer *item = (Integer *) PySequence_Fast_GET_ITEM(seq, i);
+		Integer *rop = createNewInteger();
+		mpz_init_set(rop->e, acc);
+		rop->mod = modulus_ref(first->mod);
+		PyList_SET_ITEM(result, i, (PyObject *) rop);
+		mpz_mul(acc, acc, item->e);
+		mpz_mod(acc, acc, first->mod->m);
 	}
-}
-
-void deserialize_helper(int length, char *encoded_value, mpz_t target)
-{
-	debug("encoded_value len => '%zd'", strlen(encoded_value));
 
-	size_t deserialized_len = 0;
-	uint8_t *buf = NewBase64Decode((const char *) encoded_value, length, &deserialized_len);
+	if (mpz_invert(acc, acc, first->mod->m) == 0) {
+		mpz_clear(acc);
+		Py_DECREF(result);
+		Py_DECREF(seq);
+		EXIT_IF(TRUE, "could not find a modular inverse");
+	}
 
-	mpz_import(target, deserialized_len, 1, sizeof(buf[0]), 0, 0, buf);
-	free(buf);
+	for (i = n - 1; i >= 0; i--) {
+		// acc = 1 / (a[0] * ... * a[i]) mod m
+		Integer *item = (Integer *) PySequence_Fast_GET_ITEM(seq, i);
+		Integer *rop = (Integer *) PyList_GET_ITEM(result, i);
+		mpz_mul(rop->e, rop->e, acc);
+		mpz_mod(rop->e, rop->e, first->mod->m);
+		mpz_mul(acc, acc, item->e);
+		mpz_mod(acc, acc, first->mod->m);
+	}
+	mpz_clear(acc);
+	Py_DECREF(seq);
+	return result;
 }
 
-static PyObject *deserialize(PyObject *self, PyObject *args) {
-	PyObject *bytesObj = NULL;
+/* START: multi-exponentiation */
 
-	if (!PyArg_ParseTuple(args, "O", &bytesObj)) {
-		EXIT_IF(TRUE, "invalid argument.");
+/* bits [pos, pos + w) of e */
+static unsigned int exp_digit(const mpz_t e, size_t pos, int w) {
+	unsigned int d = 0;
+	int k;
+	for (k = 0; k < w; k++) {
+		d |= (unsigned int) mpz_tstbit(e, pos + k) << k;
 	}
+	return d;
+}
 
-	uint8_t *serial_buf2 = (uint8_t *) PyBytes_AsString(bytesObj);
-	int serial_buf2_len = strlen((char *) serial_buf2);
-	uint8_t serial_buf[serial_buf2_len + 1];
-	memset(serial_buf, 0, serial_buf2_len + 1);
-	memcpy(serial_buf, serial_buf2, serial_buf2_len);
-	/* get integer value */
-	char delim[] = ":";
-	char *token = NULL;
-	token = strtok((char *) serial_buf, delim);
-	// positive or negative
-	int isNeg = atoi((const char *) token);
-	token = strtok(NULL, delim);
-	// length
-	int int_len = atoi((const char *) token);
-	debug("length => '%d'\n", int_len);
-	mpz_t x,m;
-	mpz_init(x);
-	mpz_init(m);
-
-	// parse the first half of the bytes/str object
-	token = strtok(NULL, delim);
-	debug("encoded value x => '%s'\n", token);
-	if(token != NULL) {
-		deserialize_helper(int_len, token, x);
-		debug("decoded value x => ");
-		print_mpz(x, 10);
+/* table[j] = b^j for j < size, each n limbs */
+static void res_powers(const Residues *ctx, mp_limb_t *table, const mpz_t b, int size) {
+	mpz_t one;
+	int j;
+	mpz_init_set_ui(one, 1);
+	res_from_mpz(ctx, table, one);
+	if (size > 1) res_from_mpz(ctx, table + ctx->n, b);
+	for (j = 2; j < size; j++) {
+		res_mul(ctx, table + j * ctx->n, table + (j - 1) * ctx->n, table + ctx->n);
 	}
+	mpz_clear(one);
+}
 
-	// parse modulus (if indeed modular integer)
-	token = strtok(NULL, delim);
-	if(token != NULL) {
-		int_len = atoi((const char *) token);
-		token = strtok(NULL, delim);
-		deserialize_helper(int_len, token, m);
-		debug("decoded value m => ");
-		print_mpz(m, 10);
+/* Straus: interleaved fixed windows over per-base tables of b^0 .. b^(2^w - 1). With secret set,
+ * every digit multiplies (digit 0 selects b^0 = 1) and entries are read with mpn_sec_tabselect.
+ * FALSE without memory for the tables. */
+static int multiexp_straus(const Residues *ctx, mp_limb_t *acc, mpz_t *b, mpz_t *e, int count, size_t bits, int w, int secret) {
+	mp_size_t n = ctx->n;
+	int size = 1 << w, windows = (int) ((bits + w - 1) / w), i, j, k;
+	mp_limb_t *table = (mp_limb_t *) malloc((size_t) count * size * n * sizeof(mp_limb_t));
+	mp_limb_t *sel = (mp_limb_t *) malloc(n * sizeof(mp_limb_t));
+	unsigned int d;
+	mpz_t one;
+
+	if (table == NULL || sel == NULL) {
+		free(table);
+		free(sel);
+		return FALSE;
 	}
-
-	Integer *obj = NULL;
-	if(mpz_sgn(m) > 0) {
-		obj = createNewInteger();
-		mpz_init(obj->e);
-		mpz_init_set(obj->m, m);
+	for (i = 0; i < count; i++) {
+		res_powers(ctx, table + (size_t) i * size * n, b[i], size);
 	}
-	else {
-		obj = createNewInteger();
-		mpz_init(obj->e);
-		mpz_init(obj->m);
+	mpz_init_set_ui(one, 1);
+	res_from_mpz(ctx, acc, one);
+	mpz_clear(one);
+	for (k = windows - 1; k >= 0; k--) {
+		if (secret || k != windows - 1) {
+			for (j = 0; j < w; j++) res_mul(ctx, acc, acc, acc);
+		}
+		for (i = 0; i < count; i++) {
+			d = exp_digit(e[i], (size_t) k * w, w);
+			if (secret) {
+				mpn_sec_tabselect(sel, table + (size_t) i * size * n, n, size, d);
+				res_mul(ctx, acc, acc, sel);
+			}
+			else if (d != 0) {
+				res_mul(ctx, acc, acc, table + ((size_t) i * size + d) * n);
+			}
+		}
 	}
-	mpz_set(obj->e, x);
-	if(isNeg) mpz_neg(obj->e, obj->e);
-
-	mpz_clear(x);
-	mpz_clear(m);
-	return (PyObject *) obj;
+	free(sel);
+	free(table);
+	return TRUE;
 }
 
-// class method for conversion
+/* Pippenger: per window, multiply each base into the bucket of its digit, then get
+ * prod_d bucket[d]^d as the product of the running products bucket[d] * ... * bucket[2^c - 1].
+ * FALSE without memory for the buckets. */
+static int multiexp_pippenger(const Residues *ctx, mp_limb_t *acc, mpz_t *b, mpz_t *e, int count, size_t bits, int c) {
+	mp_size_t n = ctx->n;
+	int size = 1 << c, windows = (int) ((bits + c - 1) / c), i, j, k;
+	mp_limb_t *base = (mp_limb_t *) malloc((size_t) count * n * sizeof(mp_limb_t));
+	mp_limb_t *bucket = (mp_limb_t *) malloc((size_t) size * n * sizeof(mp_limb_t));
+	mp_limb_t *sum = (mp_limb_t *) malloc(n * sizeof(mp_limb_t));
+	mp_limb_t *tot = (mp_limb_t *) malloc(n * sizeof(mp_limb_t));
+	int *used = (int *) malloc(size * sizeof(int));
+	int sum_used, tot_used, acc_used = FALSE;
+	unsigned int d;
+	mpz_t one;
+
+	if (base == NULL || bucket == NULL || sum == NULL || tot == NULL || used == NULL) {
+		free(base);
+		free(bucket);
+		free(sum);
+		free(tot);
+		free(used);
+		return FALSE;
+	}
+	for (i = 0; i < count; i++) {
+		res_from_mpz(ctx, base + (size_t) i * n, b[i]);
+	}
+	for (k = windows - 1; k >= 0; k--) {
+		if (acc_used) {
+			for (j = 0; j < c; j++) res_mul(ctx, acc, acc, acc);
+		}
+		memset(used, 0, size * sizeof(int));
+		for (i = 0; i < count; i++) {
+			d = exp_digit(e[i], (size_t) k * c, c);
+			if (d == 0) continue;
+			if (used[d]) res_mul(ctx, bucket + d * n, bucket + d * n, base + (size_t) i * n);
+			else mpn_copyi(bucket + d * n, base + (size_t) i * n, n);
+			used[d] = TRUE;
+		}
+		sum_used = tot_used = FALSE;
+		for (j = size - 1; j > 0; j--) {
+			if (used[j]) {
+				if (sum_used) res_mul(ctx, sum, sum, bucket + j * n);
+				else mpn_copyi(sum, bucket + j * n, n);
+				sum_used = TRUE;
+			}
+			if (sum_used) {
+				if (tot_used) res_mul(ctx, tot, tot, sum);
+				else mpn_copyi(tot, sum, n);
+				tot_used = TRUE;
+			}
+		}
+		if (tot_used) {
+			if (acc_used) res_mul(ctx, acc, acc, tot);
+			else mpn_copyi(acc, tot, n);
+			acc_used = TRUE;
+		}
+	}
+	if (!acc_used) {
+		mpz_init_set_ui(one, 1);
+		res_from_mpz(ctx, acc, one);
+		mpz_clear(one);
+	}
+	free(base);
+	free(bucket);
+	free(sum);
+	free(tot);
+	free(used);
+	return TRUE;
+}
+
+/* modular multiplications for count bases and bits-bit exponents: Straus with a 2^w table per base
+ * against Pippenger with 2^c buckets per window. Returns w for Straus or -c for Pippenger. */
+static int multiexp_choose(int count, size_t bits) {
+	double cost, best = -1;
+	int w, c, choice = 1;
+	for (w = 1; w <= 8; w++) {
+		cost = (double) count * ((1 << w) - 2) + (double) bits * count / w;
+		if (best < 0 || cost < best) { best = cost; choice = w; }
+	}
+	for (c = 2; c <= 16; c++) {
+		cost = (double) bits / c * (count + (2 << c));
+		if (cost < best) { best = cost; choice = -c; }
+	}
+	return choice;
+}
+
+static PyObject *multiexp_common(PyObject *args, int secret) {
+	PyObject *bases = NULL, *exps = NULL, *modulus = NULL, *bseq = NULL, *eseq = NULL;
+	IntegerModulus *mod = NULL;
+	Integer *rop = NULL, *first = NULL;
+	mp_limb_t *acc = NULL;
+	mpz_t *b = NULL, *e = NULL, m;
+	Residues ctx;
+	size_t bits = 0;
+	int i, count, algo, ok = FALSE;
+
+	if (!PyArg_ParseTuple(args, "OO|O", &bases, &exps, &modulus)) {
+		ErrorMsg("invalid arguments: expected lists of bases and exponents and an optional modulus.");
+	}
+	bseq = PySequence_Fast(bases, "expected a list of bases.");
+	if (bseq == NULL) return NULL;
+	eseq = PySequence_Fast(exps, "expected a list of exponents.");
+	if (eseq == NULL) {
+		Py_DECREF(bseq);
+		return NULL;
+	}
+	count = (int) PySequence_Fast_GET_SIZE(bseq);
+
+	mpz_init(m);
+	if (count != (int) PySequence_Fast_GET_SIZE(eseq)) {
+		PyErr_SetString(IntegerError, "need as many exponents as bases.");
+		goto cleanup;
+	}
+	// the modulus is either given or shared by all the bases
+	if (modulus != NULL && modulus != Py_None) {
+		if (!objectToMPZ(m, modulus) || mpz_sgn(m) <= 0) {
+			PyErr_SetString(IntegerError, "modulus must be a positive integer.");
+			goto cleanup;
+		}
+		mod = modulus_get(m);
+	}
+	else {
+		for (i = 0; i < count; i++) {
+			Integer *item = (Integer *) PySequence_Fast_GET_ITEM(bseq, i);
+			if (!PyInteger_Check(item) || mpz_sgn(item->mod->m) <= 0
+					|| (first != NULL && modulus_cmp(item, first) != 0)) {
+				PyErr_SetString(IntegerError, "bases must share a modulus, or pass one explicitly.");
+				goto cleanup;
+			}
+			if (first == NULL) first = item;
+		}
+		if (first == NULL) {
+			PyErr_SetString(IntegerError, "need a modulus for an empty product.");
+			goto cleanup;
+		}
+		mod = modulus_ref(first->mod);
+		mpz_set(m, mod->m);
+	}
+
+	b = (mpz_t *) malloc((count + 1) * sizeof(mpz_t));
+	e = (mpz_t *) malloc((count + 1) * sizeof(mpz_t));
+	if (b == NULL || e == NULL) {
+		free(b);
+		free(e);
+		b = e = NULL;
+		PyErr_NoMemory();
+		goto cleanup;
+	}
+	for (i = 0; i < count; i++) {
+		mpz_init(b[i]);
+		mpz_init(e[i]);
+	}
+	for (i = 0; i < count; i++) {
+		if (!objectToMPZ(b[i], PySequence_Fast_GET_ITEM(bseq, i)) ||
+			!objectToMPZ(e[i], PySequence_Fast_GET_ITEM(eseq, i))) {
+			PyErr_SetString(IntegerError, "bases and exponents must be integers.");
+			goto cleanup;
+		}
+		mpz_mod(b[i], b[i], m);
+		if (mpz_sgn(e[i]) < 0) {
+			if (mpz_invert(b[i], b[i], m) == 0) {
+				PyErr_SetString(IntegerError, "failed to find modular inverse.");
+				goto cleanup;
+			}
+			mpz_neg(e[i], e[i]);
+		}
+		if (mpz_sizeinbase(e[i], 2) > bits) bits = mpz_sizeinbase(e[i], 2);
+	}
+
+	rop = createNewInteger();
+	mpz_init(rop->e);
+	rop->mod = modulus_ref(mod);
+	Py_BEGIN_ALLOW_THREADS
+	if (res_init(&ctx, m)) {
+		acc = (mp_limb_t *) malloc(ctx.n * sizeof(mp_limb_t));
+		if (acc != NULL) {
+			if (secret) {
+				ok = multiexp_straus(&ctx, acc, b, e, count, bits, PP_WINDOW, TRUE);
+			}
+			else {
+				algo = multiexp_choose(count, bits);
+				if (algo > 0) ok = multiexp_straus(&ctx, acc, b, e, count, bits, algo, FALSE);
+				else ok = multiexp_pippenger(&ctx, acc, b, e, count, bits, -algo);
+			}
+		}
+		if (ok) {
+			res_to_mpz(&ctx, rop->e, acc);
+			// m = 1: the representation of 1 is not reduced
+			mpz_mod(rop->e, rop->e, m);
+		}
+		free(acc);
+		res_clear(&ctx);
+	}
+	Py_END_ALLOW_THREADS
+	if (!ok) {
+		// the tables grow with count * 2^w * limbs
+		Py_CLEAR(rop);
+		PyErr_NoMemory();
+	}
+
+cleanup:
+	if (b != NULL) {
+		for (i = 0; i < count; i++) {
+			mpz_clear(b[i]);
+			mpz_clear(e[i]);
+		}
+		free(b);
+		free(e);
+	}
+	mpz_clear(m);
+	modulus_release(mod);
+	Py_DECREF(bseq);
+	Py_DECREF(eseq);
+	return ok ? (PyObject *) rop : NULL;
+}
+
+/*
+ * Description: prod bases[i]^exponents[i] mod n in a single pass (Straus for few bases,
+ * Pippenger for many). Variable time: for public exponents, e.g. verification equations.
+ * inputs: list of bases, list of exponents and optionally the modulus (defaults to the bases' shared modulus)
+ */
+static PyObject *multiexp(PyObject *self, PyObject *args) {
+	return multiexp_common(args, FALSE);
+}
+
+/*
+ * Description: multiexp for secret exponents: fixed windows and table reads that don't
+ * depend on the exponents (constant time for odd moduli)
+ */
+static PyObject *multiexp_sec(PyObject *self, PyObject *args) {
+	return multiexp_common(args, TRUE);
+}
+
+/* END: multi-exponentiation */
+
+/* raw format: big-endian throughout, values are sign + fixed-width magnitude
+ *   element: flags [context index] [modulus length (4) | modulus] width (4) | value (width)
+ *   list:    flags [context index] [modulus length (4) | modulus] count (4) | width (4) | count x (sign | value)
+ * The width is the byte length of the modulus unless a value is larger (elements aren't
+ * always reduced), so any element round-trips exactly. */
+
+/* finds m among the context moduli (None, one modulus or a sequence of them); returns its
+ * index, -1 if absent or -2 with an error set */
+static int raw_context_index(PyObject *context, const mpz_t m) {
+	PyObject *seq = NULL;
+	mpz_t c;
+	int i, count, found = -1;
+
+	if (context == NULL || context == Py_None || mpz_sgn(m) == 0) return -1;
+	if (PyInteger_Check(context) || _PyLong_Check(context)) {
+		seq = PyTuple_Pack(1, context);
+	}
+	else {
+		seq = PySequence_Fast(context, "context must be a modulus or a sequence of moduli.");
+	}
+	if (seq == NULL) return -2;
+	count = (int) PySequence_Fast_GET_SIZE(seq);
+	mpz_init(c);
+	for (i = 0; i < count && i < 256; i++) {
+		if (!objectToMPZ(c, PySequence_Fast_GET_ITEM(seq, i))) {
+			PyErr_SetString(IntegerError, "context moduli must be integers.");
+			found = -2;
+			break;
+		}
+		if (mpz_cmp(c, m) == 0) {
+			found = i;
+			break;
+		}
+	}
+	mpz_clear(c);
+	Py_DECREF(seq);
+	return found;
+}
+
+static int raw_context_modulus(PyObject *context, int index, mpz_t m) {
+	PyObject *item = NULL;
+	int ok;
+
+	if (context == NULL || context == Py_None) return FALSE;
+	if (PyInteger_Check(context) || _PyLong_Check(context)) {
+		return index == 0 && objectToMPZ(m, context);
+	}
+	if (!PySequence_Check(context) || index >= PySequence_Size(context)) return FALSE;
+	item = PySequence_GetItem(context, index);
+	if (item == NULL) {
+		PyErr_Clear();
+		return FALSE;
+	}
+	ok = objectToMPZ(m, item);
+	Py_DECREF(item);
+	return ok;
+}
+
+static size_t raw_bytes(const mpz_t x) {
+	return mpz_sgn(x) == 0 ? 0 : (mpz_sizeinbase(x, 2) + 7) / 8;
+}
+
+static uint8_t *raw_put_u32(uint8_t *out, size_t v) {
+	out[0] = (uint8_t) (v >> 24);
+	out[1] = (uint8_t) (v >> 16);
+	out[2] = (uint8_t) (v >> 8);
+	out[3] = (uint8_t) v;
+	return out + 4;
+}
+
+/* |x| right-aligned in width bytes */
+static uint8_t *raw_put_mpz(uint8_t *out, size_t width, const mpz_t x) {
+	size_t len = raw_bytes(x);
+	memset(out, 0, width - len);
+	if (len > 0) mpz_export(out + width - len, NULL, 1, 1, 0, 0, x);
+	return out + width;
+}
+
+/* the modulus part of the header: a context index or the modulus itself */
+static size_t raw_modulus_len(int index, const mpz_t m) {
+	if (index >= 0) return 1;
+	return mpz_sgn(m) > 0 ? 4 + raw_bytes(m) : 0;
+}
+
+static uint8_t *raw_put_modulus(uint8_t *out, int index, const mpz_t m) {
+	if (index >= 0) {
+		*out++ = (uint8_t) index;
+	}
+	else if (mpz_sgn(m) > 0) {
+		out = raw_put_u32(out, raw_bytes(m));
+		out = raw_put_mpz(out, raw_bytes(m), m);
+	}
+	return out;
+}
+
+static uint8_t raw_modulus_flag(int index, const mpz_t m) {
+	if (index >= 0) return RAW_CONTEXT;
+	return mpz_sgn(m) > 0 ? RAW_MODULUS : 0;
+}
+
+static PyObject *serialize_raw(Integer *obj, PyObject *context) {
+	int index = raw_context_index(context, obj->mod->m);
+	size_t width, len;
+	PyObject *result;
+	uint8_t *out;
+
+	if (index == -2) return NULL;
+	width = raw_bytes(obj->mod->m);
+	if (raw_bytes(obj->e) > width) width = raw_bytes(obj->e);
+	len = 1 + raw_modulus_len(index, obj->mod->m) + 4 + width;
+
+	result = PyBytes_FromStringAndSize(NULL, len);
+	if (result == NULL) return NULL;
+	out = (uint8_t *) PyBytes_AS_STRING(result);
+	*out++ = RAW_TAG | raw_modulus_flag(index, obj->mod->m) | (mpz_sgn(obj->e) < 0 ? RAW_NEGATIVE : 0);
+	out = raw_put_modulus(out, index, obj->mod->m);
+	out = raw_put_u32(out, width);
+	raw_put_mpz(out, width, obj->e);
+	return result;
+}
+
+/* bounds-checked reader over a raw encoding */
+typedef struct {
+	const uint8_t *p;
+	size_t left;
+} RawReader;
+
+static int raw_get_u32(RawReader *r, size_t *v) {
+	if (r->left < 4) return FALSE;
+	*v = ((size_t) r->p[0] << 24) | ((size_t) r->p[1] << 16) | ((size_t) r->p[2] << 8) | r->p[3];
+	r->p += 4;
+	r->left -= 4;
+	return TRUE;
+}
+
+static int raw_get_mpz(RawReader *r, size_t width, mpz_t x) {
+	if (r->left < width) return FALSE;
+	mpz_import(x, width, 1, 1, 0, 0, r->p);
+	r->p += width;
+	r->left -= width;
+	return TRUE;
+}
+
+static int raw_get_modulus(RawReader *r, uint8_t flags, PyObject *context, mpz_t m) {
+	size_t len;
+
+	mpz_set_ui(m, 0);
+	if ((flags & RAW_CONTEXT) && (flags & RAW_MODULUS)) return FALSE;
+	if (flags & RAW_CONTEXT) {
+		if (r->left < 1) return FALSE;
+		r->p++;
+		r->left--;
+		return raw_context_modulus(context, r->p[-1], m) && mpz_sgn(m) > 0;
+	}
+	if (flags & RAW_MODULUS) {
+		return raw_get_u32(r, &len) && raw_get_mpz(r, len, m) && mpz_sgn(m) > 0;
+	}
+	return TRUE;
+}
+
+static PyObject *deserialize_raw(const uint8_t *data, size_t data_len, PyObject *context) {
+	RawReader r = { data + 1, data_len - 1 };
+	uint8_t flags = data[0];
+	Integer *obj = NULL;
+	size_t width;
+	mpz_t m;
+
+	EXIT_IF(flags & RAW_LIST, "use deserializeList for a list encoding.");
+	EXIT_IF(flags & ~(RAW_TAG | RAW_NEGATIVE | RAW_MODULUS | RAW_CONTEXT), "invalid raw integer encoding (unknown flags).");
+	mpz_init(m);
+	if (!raw_get_modulus(&r, flags, context, m) || !raw_get_u32(&r, &width) || r.left != width) {
+		mpz_clear(m);
+		EXIT_IF(TRUE, "invalid raw integer encoding (or missing context modulus).");
+	}
+	obj = createNewInteger();
+	mpz_init(obj->e);
+	obj->mod = mpz_sgn(m) > 0 ? modulus_get(m) : modulus_ref(&no_modulus);
+	raw_get_mpz(&r, width, obj->e);
+	if (flags & RAW_NEGATIVE) mpz_neg(obj->e, obj->e);
+	mpz_clear(m);
+	return (PyObject *) obj;
+}
+
+/*
+ * Description: serializes a list of integers that share a modulus (or all have none) into a
+ * single raw buffer: the modulus, or its index in the context, is written once.
+ * inputs: list of integers and an optional context (a modulus or a sequence of moduli)
+ */
+static PyObject *serializeList(PyObject *self, PyObject *args) {
+	PyObject *elems = NULL, *context = NULL, *seq = NULL, *result = NULL;
+	Integer *first = NULL, *item = NULL;
+	size_t width = 0, len;
+	int i, count, index = -1;
+	uint8_t *out;
+
+	if (!PyArg_ParseTuple(args, "O|O", &elems, &context)) {
+		EXIT_IF(TRUE, "invalid arguments: expected a list of integers and an optional context.");
+	}
+	seq = PySequence_Fast(elems, "expected a list of integers.");
+	if (seq == NULL) return NULL;
+	count = (int) PySequence_Fast_GET_SIZE(seq);
+
+	for (i = 0; i < count; i++) {
+		item = (Integer *) PySequence_Fast_GET_ITEM(seq, i);
+		if (!PyInteger_Check(item) || (first != NULL && modulus_cmp(item, first) != 0)) {
+			Py_DECREF(seq);
+			EXIT_IF(TRUE, "list elements must be integers with the same modulus.");
+		}
+		if (first == NULL) first = item;
+		if (raw_bytes(item->e) > width) width = raw_bytes(item->e);
+	}
+	if (first != NULL) {
+		index = raw_context_index(context, first->mod->m);
+		if (index == -2) {
+			Py_DECREF(seq);
+			return NULL;
+		}
+		if (raw_bytes(first->mod->m) > width) width = raw_bytes(first->mod->m);
+	}
+
+	len = 1 + (first != NULL ? raw_modulus_len(index, first->mod->m) : 0) + 8 + (size_t) count * (1 + width);
+	result = PyBytes_FromStringAndSize(NULL, len);
+	if (result != NULL) {
+		out = (uint8_t *) PyBytes_AS_STRING(result);
+		*out++ = RAW_TAG | RAW_LIST | (first != NULL ? raw_modulus_flag(index, first->mod->m) : 0);
+		if (first != NULL) out = raw_put_modulus(out, index, first->mod->m);
+		out = raw_put_u32(out, count);
+		out = raw_put_u32(out, width);
+		for (i = 0; i < count; i++) {
+			item = (Integer *) PySequence_Fast_GET_ITEM(seq, i);
+			*out++ = mpz_sgn(item->e) < 0 ? 1 : 0;
+			out = raw_put_mpz(out, width, item->e);
+		}
+	}
+	Py_DECREF(seq);
+	return result;
+}
+
+/*
+ * Description: inverse of serializeList
+ * inputs: bytes-like object and the context used when serializing (if any)
+ */
+static PyObject *deserializeList(PyObject *self, PyObject *args) {
+	PyObject *data = NULL, *context = NULL, *result = NULL;
+	IntegerModulus *mod = NULL;
+	Integer *obj = NULL;
+	Py_buffer view;
+	RawReader r;
+	size_t count, width, i;
+	uint8_t flags, sign;
+	int ok = FALSE;
+	mpz_t m;
+
+	if (!PyArg_ParseTuple(args, "O|O", &data, &context)) {
+		EXIT_IF(TRUE, "invalid arguments: expected a bytes object and an optional context.");
+	}
+	if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) != 0) return NULL;
+	r.p = (const uint8_t *) view.buf;
+	r.left = (size_t) view.len;
+	mpz_init(m);
+
+	if (r.left < 1 || (r.p[0] & (RAW_TAG | RAW_LIST)) != (RAW_TAG | RAW_LIST)) goto cleanup;
+	flags = r.p[0];
+	r.p++;
+	r.left--;
+	if (flags & ~(RAW_TAG | RAW_LIST | RAW_MODULUS | RAW_CONTEXT)) goto cleanup;
+	if (!raw_get_modulus(&r, flags, context, m) || !raw_get_u32(&r, &count) || !raw_get_u32(&r, &width)) goto cleanup;
+	if (width + 1 == 0 || r.left / (width + 1) != count || r.left % (width + 1) != 0) goto cleanup;
+
+	result = PyList_New(count);
+	if (result == NULL) goto cleanup;
+	mod = mpz_sgn(m) > 0 ? modulus_get(m) : modulus_ref(&no_modulus);
+	for (i = 0; i < count; i++) {
+		obj = createNewInteger();
+		mpz_init(obj->e);
+		obj->mod = modulus_ref(mod);
+		PyList_SET_ITEM(result, i, (PyObject *) obj);
+		sign = r.p[0];
+		r.p++;
+		r.left--;
+		raw_get_mpz(&r, width, obj->e);
+		if (sign > 1) {
+			Py_CLEAR(result);
+			goto cleanup;
+		}
+		if (sign) mpz_neg(obj->e, obj->e);
+	}
+	ok = TRUE;
+
+cleanup:
+	modulus_release(mod);
+	mpz_clear(m);
+	PyBuffer_Release(&view);
+	if (!ok && !PyErr_Occurred()) {
+		PyErr_SetString(IntegerError, "invalid raw integer list encoding (or missing context modulus).");
+	}
+	return ok ? result : NULL;
+}
+
+static PyObject *serialize(PyObject *self, PyObject *args) {
+	Integer *obj = NULL;
+	PyObject *context = NULL;
+	int isNeg, raw = FALSE;
+
+	if (!PyArg_ParseTuple(args, "O|pO", &obj, &raw, &context)) {
+		ErrorMsg("invalid argument");
+	}
+	if(!PyInteger_Check(obj)) EXIT_IF(TRUE, "not a valid element object.");
+	if (raw) return serialize_raw(obj, context);
+
+	// export the object first
+	size_t count1 = 0, count2 = 0;
+	char *base64_rop = NULL, *base64_rop2 = NULL;
+	PyObject *bytes1 = NULL, *bytes2 = NULL;
+//	if (mpz_sgn(obj->e) > 0) {
+		uint8_t *rop = (uint8_t *) mpz_export(NULL, &count1, 1, sizeof(char),
+				0, 0, obj->e);
+		// convert string to base64 encoding
+		size_t length = 0;
+		base64_rop = NewBase64Encode(rop, count1, FALSE, &length);
+		isNeg = mpz_sgn(obj->e) < 0 ? TRUE : FALSE;
+		// convert to bytes (length : base64 integer)
+		bytes1 = PyBytes_FromFormat("%d:%d:%s:", isNeg, (int) length,
+				(const char *) base64_rop);
+		free(base64_rop);
+		free(rop);
+//	}
+
+	if (mpz_sgn(obj->mod->m) > 0) {
+		uint8_t *rop2 = (uint8_t *) mpz_export(NULL, &count2, 1, sizeof(char),
+				0, 0, obj->mod->m);
+		size_t length2 = 0;
+		base64_rop2 = NewBase64Encode(rop2, count2, FALSE, &length2);
+		// convert to bytes
+		bytes2 = PyBytes_FromFormat("%d:%s:", (int) length2,
+				(const char *) base64_rop2);
+		free(base64_rop2);
+		free(rop2);
+	}
+
+	if (bytes2 != NULL && bytes1 != NULL) {
+		PyBytes_ConcatAndDel(&bytes1, bytes2);
+		return bytes1;
+	} else if (bytes1 != NULL) {
+		return bytes1;
+	} else {
+		EXIT_IF(TRUE, "invalid integer object.");
+	}
+}
+
+void deserialize_helper(int length, char *encoded_value, mpz_t target)
+{
+	debug("encoded_value len => '%zd'", strlen(encoded_value));
+
+	size_t deserialized_len = 0;
+	uint8_t *buf = NewBase64Decode((const char *) encoded_value, length, &deserialized_len);
+
+	mpz_import(target, deserialized_len, 1, sizeof(buf[0]), 0, 0, buf);
+	free(buf);
+}
+
+static PyObject *deserialize(PyObject *self, PyObject *args) {
+	PyObject *bytesObj = NULL, *context = NULL;
+
+	if (!PyArg_ParseTuple(args, "O|O", &bytesObj, &context)) {
+		EXIT_IF(TRUE, "invalid argument.");
+	}
+	// raw encodings start with a byte that has RAW_TAG set, the base64 ones with an ASCII digit
+	if (PyObject_CheckBuffer(bytesObj)) {
+		Py_buffer view;
+		if (PyObject_GetBuffer(bytesObj, &view, PyBUF_SIMPLE) != 0) return NULL;
+		if (view.len > 0 && (((const uint8_t *) view.buf)[0] & RAW_TAG)) {
+			PyObject *result = deserialize_raw((const uint8_t *) view.buf, (size_t) view.len, context);
+			PyBuffer_Release(&view);
+			return result;
+		}
+		PyBuffer_Release(&view);
+	}
+	EXIT_IF(!PyBytes_Check(bytesObj), "expected a bytes object.");
+
+	uint8_t *serial_buf2 = (uint8_t *) PyBytes_AsString(bytesObj);
+	int serial_buf2_len = strlen((char *) serial_buf2);
+	uint8_t serial_buf[serial_buf2_len + 1];
+	memset(serial_buf, 0, serial_buf2_len + 1);
+	memcpy(serial_buf, serial_buf2, serial_buf2_len);
+	/* get integer value */
+	char delim[] = ":";
+	char *token = NULL;
+	token = strtok((char *) serial_buf, delim);
+	// positive or negative
+	int isNeg = atoi((const char *) token);
+	token = strtok(NULL, delim);
+	// length
+	int int_len = atoi((const char *) token);
+	debug("length => '%d'\n", int_len);
+	mpz_t x,m;
+	mpz_init(x);
+	mpz_init(m);
+
+	// parse the first half of the bytes/str object
+	token = strtok(NULL, delim);
+	debug("encoded value x => '%s'\n", token);
+	if(token != NULL) {
+		deserialize_helper(int_len, token, x);
+		debug("decoded value x => ");
+		print_mpz(x, 10);
+	}
+
+	// parse modulus (if indeed modular integer)
+	token = strtok(NULL, delim);
+	if(token != NULL) {
+		int_len = atoi((const char *) token);
+		token = strtok(NULL, delim);
+		deserialize_helper(int_len, token, m);
+		debug("decoded value m => ");
+		print_mpz(m, 10);
+	}
+
+	Integer *obj = NULL;
+	if(mpz_sgn(m) > 0) {
+		obj = createNewInteger();
+		mpz_init(obj->e);
+		obj->mod = modulus_get(m);
+	}
+	else {
+		obj = createNewInteger();
+		mpz_init(obj->e);
+		obj->mod = modulus_ref(&no_modulus);
+	}
+	mpz_set(obj->e, x);
+	if(isNeg) mpz_neg(obj->e, obj->e);
+
+	mpz_clear(x);
+	mpz_clear(m);
+	return (PyObject *) obj;
+}
+
+// class method for conversion
 // integer.toBytes(x) => b'blah blah'
 static PyObject *toBytes(PyObject *self, PyObject *args) {
 	Integer *intObj = NULL;
 
-	if (PyInteger_Check(args)) {
-		intObj = (Integer *) args;
-		size_t count = 0;
-		unsigned char *Rop = (unsigned char *) mpz_export(NULL, &count, 1,
-				sizeof(char), 0, 0, intObj->e);
-		debug("Rop => '%s', len =>'%zd'\n", Rop, count);
-		PyObject *newObj = PyBytes_FromStringAndSize((const char *) Rop, (Py_ssize_t) count);
-		free(Rop);
-		return newObj;
+	if (PyInteger_Check(args)) {
+		intObj = (Integer *) args;
+		size_t count = 0;
+		unsigned char *Rop = (unsigned char *) mpz_export(NULL, &count, 1,
+				sizeof(char), 0, 0, intObj->e);
+		debug("Rop => '%s', len =>'%zd'\n", Rop, count);
+		PyObject *newObj = PyBytes_FromStringAndSize((const char *) Rop, (Py_ssize_t) count);
+		free(Rop);
+		return newObj;
+	}
+
+	EXIT_IF(TRUE, "invalid type.");
+}
+
+// class method for conversion for modular integer to an integer
+// integer.toInt(x mod Y) => x
+static PyObject *toInt(PyObject *self, PyObject *args) {
+	Integer *intObj = NULL;
+
+	if (PyInteger_Check(args)) {
+		intObj = (Integer *) args;
+		Integer *rop = createNewInteger();
+		mpz_init_set(rop->e, intObj->e);
+		rop->mod = modulus_ref(&no_modulus);
+
+		return (PyObject *) rop;
+	}
+
+	EXIT_IF(TRUE, "not a charm integer type.");
+}
+
+static PyObject *getMod(PyObject *self, PyObject *args) {
+	Integer *intObj = NULL;
+
+	if (PyInteger_Check(args)) {
+		intObj = (Integer *) args;
+		Integer *rop = createNewInteger();
+		mpz_init_set(rop->e, intObj->mod->m);
+		rop->mod = modulus_ref(&no_modulus);
+		return (PyObject *) rop;
+	}
+
+	EXIT_IF(TRUE, "not a charm integer type.");
+}
+
+static PyObject *Integer_xor(PyObject *self, PyObject *other) {
+	Integer *rop = NULL, *op1 = NULL, *op2 = NULL;
+
+	if (PyInteger_Check(self))
+		op1 = (Integer *) self;
+	if (PyInteger_Check(other))
+		op2 = (Integer *) other;
+
+	EXIT_IF(op1 == NULL || op2 == NULL, "both types are not of charm integer types.");
+	if (PyInteger_Init(op1, op2)) {
+		rop = createNewInteger();
+		mpz_init(rop->e);
+		rop->mod = modulus_ref(&no_modulus);
+		mpz_xor(rop->e, op1->e, op2->e);
+		return (PyObject *) rop;
+	}
+
+	EXIT_IF(TRUE, "objects not initialized properly.");
+}
+
+/* START: CRT context */
+
+void CRT_dealloc(CRT *self) {
+	if (self->initialized) {
+		mpz_clear(self->p);
+		mpz_clear(self->q);
+		mpz_clear(self->p2);
+		mpz_clear(self->q2);
+		mpz_clear(self->ord_p);
+		mpz_clear(self->ord_q);
+		mpz_clear(self->ord_p2);
+		mpz_clear(self->ord_q2);
+		mpz_clear(self->q_inv);
+		mpz_clear(self->q2_inv);
+		modulus_release(self->n);
+		modulus_release(self->n2);
+	}
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+PyObject *CRT_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+	CRT *self = (CRT *) type->tp_alloc(type, 0);
+	if (self != NULL) {
+		self->initialized = FALSE;
+	}
+	return (PyObject *) self;
+}
+
+int CRT_init(CRT *self, PyObject *args, PyObject *kwds) {
+	PyObject *p = NULL, *q = NULL;
+	mpz_t n;
+	static char *kwlist[] = { "p", "q", NULL };
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &p, &q)) {
+		return -1;
+	}
+	if (self->initialized) {
+		PyErr_SetString(IntegerError, "CRT context already initialized.");
+		return -1;
+	}
+
+	mpz_init(self->p);
+	mpz_init(self->q);
+	if (!objectToMPZ(self->p, p) || !objectToMPZ(self->q, q) || mpz_cmp_ui(self->p, 2) <= 0
+			|| mpz_cmp_ui(self->q, 2) <= 0 || !mpz_odd_p(self->p) || !mpz_odd_p(self->q)
+			|| mpz_cmp(self->p, self->q) == 0) {
+		mpz_clear(self->p);
+		mpz_clear(self->q);
+		PyErr_SetString(IntegerError, "p and q must be distinct odd primes.");
+		return -1;
+	}
+
+	mpz_init(self->p2);
+	mpz_init(self->q2);
+	mpz_init(self->ord_p);
+	mpz_init(self->ord_q);
+	mpz_init(self->ord_p2);
+	mpz_init(self->ord_q2);
+	mpz_init(self->q_inv);
+	mpz_init(self->q2_inv);
+	mpz_mul(self->p2, self->p, self->p);
+	mpz_mul(self->q2, self->q, self->q);
+	// exponents reduce mod phi(p) = p - 1 and phi(p^2) = p(p - 1)
+	mpz_sub_ui(self->ord_p, self->p, 1);
+	mpz_sub_ui(self->ord_q, self->q, 1);
+	mpz_mul(self->ord_p2, self->ord_p, self->p);
+	mpz_mul(self->ord_q2, self->ord_q, self->q);
+	mpz_invert(self->q_inv, self->q, self->p);
+	mpz_invert(self->q2_inv, self->q2, self->p2);
+
+	mpz_init(n);
+	mpz_mul(n, self->p, self->q);
+	self->n = modulus_get(n);
+	mpz_mul(n, n, n);
+	self->n2 = modulus_get(n);
+	mpz_clear(n);
+	self->initialized = TRUE;
+	return 0;
+}
+
+/* rop = x^d mod a with the exponent reduced mod ord = phi(a) */
+static void crt_half_powm(mpz_t rop, const mpz_t x, const mpz_t d, const mpz_t a, const mpz_t ord) {
+	mpz_t e;
+	mpz_init(e);
+	mpz_mod(e, d, ord);
+	// x^ord (not x^0) keeps non-units at 0
+	if (mpz_sgn(e) == 0) mpz_set(e, ord);
+	mpz_mod(rop, x, a);
+	mpz_powm_sec(rop, rop, e, a);
+	mpz_clear(e);
+}
+
+/* x^d mod (a * b) from the two half-size exponentiations and Garner's recombination,
+ * where b_inv = b^-1 mod a */
+static void crt_powm(mpz_t rop, const mpz_t x, const mpz_t d, const mpz_t a, const mpz_t ord_a,
+		const mpz_t b, const mpz_t ord_b, const mpz_t b_inv) {
+	mpz_t xa, xb;
+	mpz_init(xa);
+	mpz_init(xb);
+	crt_half_powm(xa, x, d, a, ord_a);
+	crt_half_powm(xb, x, d, b, ord_b);
+	// rop = xb + b * ((xa - xb) * b_inv mod a)
+	mpz_sub(xa, xa, xb);
+	mpz_mul(xa, xa, b_inv);
+	mpz_mod(xa, xa, a);
+	mpz_mul(rop, xa, b);
+	mpz_add(rop, rop, xb);
+	mpz_clear(xa);
+	mpz_clear(xb);
+}
+
+static PyObject *CRT_pow(CRT *self, PyObject *args, int square) {
+	PyObject *x = NULL, *d = NULL;
+	Integer *rop = NULL;
+	mpz_t base, exp;
+
+	EXIT_IF(!self->initialized, "CRT context not initialized.");
+	if (!PyArg_ParseTuple(args, "OO", &x, &d)) {
+		ErrorMsg("invalid argument types: expected base and exponent.");
+	}
+
+	mpz_init(base);
+	mpz_init(exp);
+	if (!objectToMPZ(base, x) || !objectToMPZ(exp, d) || mpz_sgn(exp) < 0) {
+		mpz_clear(base);
+		mpz_clear(exp);
+		ErrorMsg("base and exponent must be integers and the exponent non-negative.");
+	}
+
+	rop = createNewInteger();
+	mpz_init(rop->e);
+	rop->mod = modulus_ref(square ? self->n2 : self->n);
+	if (mpz_sgn(exp) == 0) {
+		mpz_set_ui(rop->e, 1);
+	}
+	else if (square) {
+		crt_powm(rop->e, base, exp, self->p2, self->ord_p2, self->q2, self->ord_q2, self->q2_inv);
+	}
+	else {
+		crt_powm(rop->e, base, exp, self->p, self->ord_p, self->q, self->ord_q, self->q_inv);
+	}
+	mpz_clear(base);
+	mpz_clear(exp);
+	return (PyObject *) rop;
+}
+
+static PyObject *CRT_powm(CRT *self, PyObject *args) {
+	return CRT_pow(self, args, FALSE);
+}
+
+static PyObject *CRT_powm_n2(CRT *self, PyObject *args) {
+	return CRT_pow(self, args, TRUE);
+}
+
+PyMethodDef CRT_methods[] = {
+	{ "powm", (PyCFunction) CRT_powm, METH_VARARGS, "compute x^d mod n = p*q with two half-size exponentiations." },
+	{ "powm_n2", (PyCFunction) CRT_powm_n2, METH_VARARGS, "compute x^d mod n^2 by exponentiating mod p^2 and q^2." },
+	{ NULL }
+};
+
+PyTypeObject CRTType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"integer.CRT", /*tp_name*/
+	sizeof(CRT), /*tp_basicsize*/
+	0, /*tp_itemsize*/
+	(destructor)CRT_dealloc, /*tp_dealloc*/
+	0, /*tp_print*/
+	0, /*tp_getattr*/
+	0, /*tp_setattr*/
+	0, /*tp_reserved*/
+	0, /*tp_repr*/
+	0, /*tp_as_number*/
+	0, /*tp_as_sequence*/
+	0, /*tp_as_mapping*/
+	0, /*tp_hash */
+	0, /*tp_call*/
+	0, /*tp_str*/
+	0, /*tp_getattro*/
+	0, /*tp_setattro*/
+	0, /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT, /*tp_flags*/
+	"private-key exponentiation mod p*q (and its square) via the CRT", /* tp_doc */
+	0, /* tp_traverse */
+	0, /* tp_clear */
+	0, /* tp_richcompare */
+	0, /* tp_weaklistoffset */
+	0, /* tp_iter */
+	0, /* tp_iternext */
+	CRT_methods, /* tp_methods */
+	0, /* tp_members */
+	0, /* tp_getset */
+	0, /* tp_base */
+	0, /* tp_dict */
+	0, /* tp_descr_get */
+	0, /* tp_descr_set */
+	0, /* tp_dictoffset */
+	(initproc)CRT_init, /* tp_init */
+	0, /* tp_alloc */
+	CRT_new, /* tp_new */
+};
+
+/* END: CRT context */
+
+/* START: Paillier engine */
+
+/* rop = r^n mod n^2 for a fresh random r in [1, n). Touches no Python objects, so it runs
+ * on the pool workers and without the GIL. */
+static int paillier_rn(Paillier *self, mpz_t rop) {
+	mpz_t r;
+	int ok;
+
+	mpz_init(r);
+	do {
+		ok = random_below(r, self->n);
+	} while (ok && mpz_sgn(r) == 0);
+	if (ok) {
+		if (self->has_key) {
+			crt_powm(rop, r, self->n, self->p2, self->ord_p2, self->q2, self->ord_q2, self->q2_inv);
+		}
+		else {
+			// n is public, so the faster variable-time exponentiation is fine
+			mpz_powm(rop, r, self->n, self->n2);
+		}
+	}
+	mpz_clear(r);
+	return ok;
+}
+
+static void *paillier_worker(void *arg) {
+	Paillier *self = (Paillier *) arg;
+	mpz_t rn;
+	int ok = TRUE;
+
+	mpz_init(rn);
+	pthread_mutex_lock(&self->lock);
+	while (ok && !self->stop) {
+		if (self->count == self->capacity) {
+			pthread_cond_wait(&self->wake, &self->lock);
+			continue;
+		}
+		pthread_mutex_unlock(&self->lock);
+		ok = paillier_rn(self, rn);
+		pthread_mutex_lock(&self->lock);
+		if (ok && self->count < self->capacity) {
+			mpz_swap(self->pool[(self->head + self->count) % self->capacity], rn);
+			self->count++;
+		}
+	}
+	pthread_mutex_unlock(&self->lock);
+	mpz_clear(rn);
+	return NULL;
+}
+
+static void paillier_start(Paillier *self, int threads) {
+	int i;
+
+	self->pid = getpid();
+	self->stop = FALSE;
+	self->nthreads = 0;
+	for (i = 0; i < threads; i++) {
+		if (pthread_create(&self->threads[i], NULL, paillier_worker, self) != 0) break;
+		self->nthreads++;
+	}
+}
+
+static void paillier_stop(Paillier *self) {
+	int i;
+
+	pthread_mutex_lock(&self->lock);
+	self->stop = TRUE;
+	pthread_cond_broadcast(&self->wake);
+	pthread_mutex_unlock(&self->lock);
+	for (i = 0; i < self->nthreads; i++) {
+		pthread_join(self->threads[i], NULL);
+	}
+	self->nthreads = 0;
+}
+
+/* A forked child has the parent's pooled values but none of its workers: handing out the
+ * same r^n in both processes would leak plaintext relations, so the child starts over. */
+static void paillier_check_fork(Paillier *self) {
+	if (self->capacity == 0 || self->pid == getpid()) return;
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_cond_init(&self->wake, NULL);
+	self->head = self->count = 0;
+	paillier_start(self, self->nthreads);
+}
+
+/* takes a pooled r^n into rop; FALSE when the pool is empty */
+static int paillier_take(Paillier *self, mpz_t rop) {
+	int found = FALSE;
+
+	if (self->capacity == 0) return FALSE;
+	pthread_mutex_lock(&self->lock);
+	if (self->count > 0) {
+		mpz_swap(rop, self->pool[self->head]);
+		self->head = (self->head + 1) % self->capacity;
+		self->count--;
+		found = TRUE;
+	}
+	pthread_cond_signal(&self->wake);
+	pthread_mutex_unlock(&self->lock);
+	return found;
+}
+
+/* rop = a pooled r^n, or a fresh one computed without the GIL */
+static int paillier_randomness(Paillier *self, mpz_t rop) {
+	int ok = TRUE;
+
+	paillier_check_fork(self);
+	if (!paillier_take(self, rop)) {
+		Py_BEGIN_ALLOW_THREADS
+		ok = paillier_rn(self, rop);
+		Py_END_ALLOW_THREADS
+	}
+	return ok;
+}
+
+/* rop = c * (1 + k*n) mod n^2 = c + n * (k*c mod n), which only multiplies mod n */
+static void paillier_shift(Paillier *self, mpz_t rop, const mpz_t c, const mpz_t k) {
+	mpz_t t;
+
+	mpz_init(t);
+	mpz_mod(t, c, self->n);
+	mpz_mul(t, t, k);
+	mpz_mod(t, t, self->n);
+	mpz_mul(t, t, self->n);
+	mpz_mod(rop, c, self->n2);
+	mpz_add(rop, rop, t);
+	if (mpz_cmp(rop, self->n2) >= 0) mpz_sub(rop, rop, self->n2);
+	mpz_clear(t);
+}
+
+/* m_p = L_p(c^(p - 1) mod p^2) * h_p mod p */
+static void paillier_decrypt_half(mpz_t rop, const mpz_t c, const mpz_t p, const mpz_t p2, const mpz_t h) {
+	mpz_t e;
+
+	mpz_init(e);
+	mpz_sub_ui(e, p, 1);
+	mpz_mod(rop, c, p2);
+	mpz_powm_sec(rop, rop, e, p2);
+	mpz_sub_ui(rop, rop, 1);
+	mpz_fdiv_q(rop, rop, p);
+	mpz_mul(rop, rop, h);
+	mpz_mod(rop, rop, p);
+	mpz_clear(e);
+}
+
+/* the value of an integer object, or of a python int converted into tmp */
+static mpz_srcptr paillier_value(PyObject *obj, mpz_t tmp) {
+	if (PyInteger_Check(obj)) return ((Integer *) obj)->e;
+	if (objectToMPZ(tmp, obj)) return tmp;
+	return NULL;
+}
+
+static Integer *paillier_ciphertext(Paillier *self) {
+	Integer *rop = createNewInteger();
+	mpz_init(rop->e);
+	rop->mod = modulus_ref(self->mod_n2);
+	return rop;
+}
+
+void Paillier_dealloc(Paillier *self) {
+	int i;
+
+	if (self->initialized) {
+		// workers of a parent process are not ours to join; a worker may be mid-exponentiation
+		if (self->pid == getpid()) {
+			Py_BEGIN_ALLOW_THREADS
+			paillier_stop(self);
+			Py_END_ALLOW_THREADS
+		}
+		for (i = 0; i < self->capacity; i++) {
+			mpz_clear(self->pool[i]);
+		}
+		free(self->pool);
+		pthread_mutex_destroy(&self->lock);
+		pthread_cond_destroy(&self->wake);
+		mpz_clear(self->n);
+		mpz_clear(self->n2);
+		if (self->has_key) {
+			mpz_clear(self->p);
+			mpz_clear(self->q);
+			mpz_clear(self->p2);
+			mpz_clear(self->q2);
+			mpz_clear(self->ord_p2);
+			mpz_clear(self->ord_q2);
+			mpz_clear(self->q_inv);
+			mpz_clear(self->q2_inv);
+			mpz_clear(self->h_p);
+			mpz_clear(self->h_q);
+		}
+		modulus_release(self->mod_n);
+		modulus_release(self->mod_n2);
+	}
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+PyObject *Paillier_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+	Paillier *self = (Paillier *) type->tp_alloc(type, 0);
+	if (self != NULL) {
+		self->initialized = FALSE;
+	}
+	return (PyObject *) self;
+}
+
+int Paillier_init(Paillier *self, PyObject *args, PyObject *kwds) {
+	PyObject *n = NULL, *p = Py_None, *q = Py_None;
+	int pool = 0, threads = 1, i;
+	mpz_t t;
+	static char *kwlist[] = { "n", "p", "q", "pool", "threads", NULL };
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOii", kwlist, &n, &p, &q, &pool, &threads)) {
+		return -1;
+	}
+	if (self->initialized) {
+		PyErr_SetString(IntegerError, "Paillier context already initialized.");
+		return -1;
+	}
+	if (pool < 0 || threads < 0 || threads > PAILLIER_MAX_THREADS) {
+		PyErr_Format(IntegerError, "pool must be non-negative and threads between 0 and %d.", PAILLIER_MAX_THREADS);
+		return -1;
+	}
+	if ((p == Py_None) != (q == Py_None)) {
+		PyErr_SetString(IntegerError, "give both p and q or neither.");
+		return -1;
+	}
+
+	self->pool = (mpz_t *) malloc(sizeof(mpz_t) * (pool > 0 ? pool : 1));
+	if (self->pool == NULL) {
+		PyErr_NoMemory();
+		return -1;
+	}
+
+	mpz_init(self->n);
+	if (!objectToMPZ(self->n, n) || mpz_cmp_ui(self->n, 2) <= 0 || !mpz_odd_p(self->n)) {
+		mpz_clear(self->n);
+		free(self->pool);
+		PyErr_SetString(IntegerError, "n must be an odd integer greater than 2.");
+		return -1;
+	}
+
+	self->has_key = (p != Py_None);
+	if (self->has_key) {
+		mpz_init(self->p);
+		mpz_init(self->q);
+		mpz_init(t);
+		if (objectToMPZ(self->p, p) && objectToMPZ(self->q, q)) mpz_mul(t, self->p, self->q);
+		// distinct primes are coprime, which the CRT inverses below rely on
+		if (mpz_cmp(t, self->n) != 0 || mpz_cmp_ui(self->p, 2) <= 0 || mpz_cmp_ui(self->q, 2) <= 0
+				|| mpz_cmp(self->p, self->q) == 0
+				|| mpz_probab_prime_p(self->p, MAX_RUN) == 0 || mpz_probab_prime_p(self->q, MAX_RUN) == 0) {
+			mpz_clear(t);
+			mpz_clear(self->p);
+			mpz_clear(self->q);
+			mpz_clear(self->n);
+			free(self->pool);
+			PyErr_SetString(IntegerError, "p and q must be distinct odd primes with p * q = n.");
+			return -1;
+		}
+		mpz_init(self->p2);
+		mpz_init(self->q2);
+		mpz_init(self->ord_p2);
+		mpz_init(self->ord_q2);
+		mpz_init(self->q_inv);
+		mpz_init(self->q2_inv);
+		mpz_init(self->h_p);
+		mpz_init(self->h_q);
+		mpz_mul(self->p2, self->p, self->p);
+		mpz_mul(self->q2, self->q, self->q);
+		mpz_sub_ui(t, self->p, 1);
+		mpz_mul(self->ord_p2, t, self->p);
+		mpz_sub_ui(t, self->q, 1);
+		mpz_mul(self->ord_q2, t, self->q);
+		mpz_invert(self->q_inv, self->q, self->p);
+		mpz_invert(self->q2_inv, self->q2, self->p2);
+		// with g = n + 1, L_p(g^(p - 1) mod p^2) = (p - 1) * q = -q mod p
+		mpz_sub(self->h_p, self->p, self->q_inv);
+		mpz_invert(self->h_q, self->p, self->q);
+		mpz_sub(self->h_q, self->q, self->h_q);
+		mpz_clear(t);
+	}
+
+	mpz_init(self->n2);
+	mpz_mul(self->n2, self->n, self->n);
+	self->mod_n = modulus_get(self->n);
+	self->mod_n2 = modulus_get(self->n2);
+
+	self->capacity = pool;
+	self->head = self->count = 0;
+	for (i = 0; i < pool; i++) {
+		mpz_init(self->pool[i]);
+	}
+	pthread_mutex_init(&self->lock, NULL);
+	pthread_cond_init(&self->wake, NULL);
+	paillier_start(self, pool > 0 ? threads : 0);
+	self->initialized = TRUE;
+	return 0;
+}
+
+static PyObject *Paillier_encrypt(Paillier *self, PyObject *args) {
+	PyObject *m = NULL;
+	Integer *rop = NULL;
+	mpz_t k;
+
+	EXIT_IF(!self->initialized, "Paillier context not initialized.");
+	if (!PyArg_ParseTuple(args, "O", &m)) {
+		ErrorMsg("invalid argument type: expected the message.");
+	}
+	mpz_init(k);
+	if (!objectToMPZ(k, m)) {
+		mpz_clear(k);
+		ErrorMsg("message must be an integer.");
+	}
+
+	rop = paillier_ciphertext(self);
+	if (!paillier_randomness(self, rop->e)) {
+		mpz_clear(k);
+		Py_DECREF(rop);
+		ErrorMsg("could not generate randomness.");
+	}
+	// g^m = (1 + n)^m = 1 + m*n mod n^2
+	mpz_mod(k, k, self->n);
+	paillier_shift(self, rop->e, rop->e, k);
+	mpz_clear(k);
+	return (PyObject *) rop;
+}
+
+static PyObject *Paillier_decrypt(Paillier *self, PyObject *args) {
+	PyObject *c = NULL;
+	Integer *rop = NULL;
+	mpz_srcptr cv;
+	mpz_t tmp, mq;
+
+	EXIT_IF(!self->initialized, "Paillier context not initialized.");
+	EXIT_IF(!self->has_key, "decryption requires p and q.");
+	if (!PyArg_ParseTuple(args, "O", &c)) {
+		ErrorMsg("invalid argument type: expected a ciphertext.");
+	}
+	mpz_init(tmp);
+	if ((cv = paillier_value(c, tmp)) == NULL) {
+		mpz_clear(tmp);
+		ErrorMsg("ciphertext must be an integer.");
+	}
+
+	rop = createNewInteger();
+	mpz_init(rop->e);
+	rop->mod = modulus_ref(self->mod_n);
+	mpz_init(mq);
+	Py_BEGIN_ALLOW_THREADS
+	paillier_decrypt_half(rop->e, cv, self->p, self->p2, self->h_p);
+	paillier_decrypt_half(mq, cv, self->q, self->q2, self->h_q);
+	// m = m_q + q * ((m_p - m_q) * q^-1 mod p)
+	mpz_sub(rop->e, rop->e, mq);
+	mpz_mul(rop->e, rop->e, self->q_inv);
+	mpz_mod(rop->e, rop->e, self->p);
+	mpz_mul(rop->e, rop->e, self->q);
+	mpz_add(rop->e, rop->e, mq);
+	Py_END_ALLOW_THREADS
+	mpz_clear(mq);
+	mpz_clear(tmp);
+	return (PyObject *) rop;
+}
+
+/* parses two operands: a ciphertext and a ciphertext or plaintext */
+#define PAILLIER_OPERANDS(what)											\
+	PyObject *a = NULL, *b = NULL;										\
+	mpz_srcptr av, bv;													\
+	mpz_t ta, tb;														\
+	Integer *rop = NULL;												\
+	EXIT_IF(!self->initialized, "Paillier context not initialized.");	\
+	if (!PyArg_ParseTuple(args, "OO", &a, &b)) {						\
+		ErrorMsg("invalid argument types: expected a ciphertext and " what ".");	\
+	}																	\
+	mpz_init(ta);														\
+	mpz_init(tb);														\
+	if ((av = paillier_value(a, ta)) == NULL || (bv = paillier_value(b, tb)) == NULL) {	\
+		mpz_clear(ta);													\
+		mpz_clear(tb);													\
+		ErrorMsg("operands must be integers.");							\
+	}
+
+static PyObject *Paillier_add(Paillier *self, PyObject *args) {
+	PAILLIER_OPERANDS("a ciphertext");
+	rop = paillier_ciphertext(self);
+	mpz_mul(rop->e, av, bv);
+	mpz_mod(rop->e, rop->e, self->n2);
+	mpz_clear(ta);
+	mpz_clear(tb);
+	return (PyObject *) rop;
+}
+
+static PyObject *Paillier_add_plain(Paillier *self, PyObject *args) {
+	PAILLIER_OPERANDS("a plaintext");
+	rop = paillier_ciphertext(self);
+	mpz_mod(tb, bv, self->n);
+	paillier_shift(self, rop->e, av, tb);
+	mpz_clear(ta);
+	mpz_clear(tb);
+	return (PyObject *) rop;
+}
+
+static PyObject *Paillier_mul_plain(Paillier *self, PyObject *args) {
+	PAILLIER_OPERANDS("a plaintext");
+	rop = paillier_ciphertext(self);
+	mpz_mod(rop->e, av, self->n2);
+	if (mpz_sgn(bv) < 0) {
+		// mpz_powm would raise a division by zero if the inverse doesn't exist
+		if (mpz_invert(rop->e, rop->e, self->n2) == 0) {
+			mpz_clear(ta);
+			mpz_clear(tb);
+			Py_DECREF(rop);
+			ErrorMsg("ciphertext is not invertible.");
+		}
+		mpz_neg(tb, bv);
+		bv = tb;
+	}
+	if (mpz_sgn(bv) == 0) {
+		mpz_set_ui(rop->e, 1);
+	}
+	else {
+		mpz_powm_sec(rop->e, rop->e, bv, self->n2);
+	}
+	mpz_clear(ta);
+	mpz_clear(tb);
+	return (PyObject *) rop;
+}
+
+static PyObject *Paillier_rerandomize(Paillier *self, PyObject *args) {
+	PyObject *c = NULL;
+	Integer *rop = NULL;
+	mpz_srcptr cv;
+	mpz_t tmp;
+
+	EXIT_IF(!self->initialized, "Paillier context not initialized.");
+	if (!PyArg_ParseTuple(args, "O", &c)) {
+		ErrorMsg("invalid argument type: expected a ciphertext.");
+	}
+	mpz_init(tmp);
+	if ((cv = paillier_value(c, tmp)) == NULL) {
+		mpz_clear(tmp);
+		ErrorMsg("ciphertext must be an integer.");
+	}
+	rop = paillier_ciphertext(self);
+	if (!paillier_randomness(self, rop->e)) {
+		mpz_clear(tmp);
+		Py_DECREF(rop);
+		ErrorMsg("could not generate randomness.");
+	}
+	mpz_mul(rop->e, rop->e, cv);
+	mpz_mod(rop->e, rop->e, self->n2);
+	mpz_clear(tmp);
+	return (PyObject *) rop;
+}
+
+/* fills up to count free pool slots on the calling thread, e.g. in an offline phase */
+static PyObject *Paillier_precompute(Paillier *self, PyObject *args) {
+	int count = -1, filled = 0, ok = TRUE, level;
+	mpz_t rn;
+
+	EXIT_IF(!self->initialized, "Paillier context not initialized.");
+	if (!PyArg_ParseTuple(args, "|i", &count)) {
+		ErrorMsg("invalid argument type: expected a count.");
+	}
+	EXIT_IF(self->capacity == 0, "the context has no pool.");
+	paillier_check_fork(self);
+
+	mpz_init(rn);
+	Py_BEGIN_ALLOW_THREADS
+	pthread_mutex_lock(&self->lock);
+	while (ok && self->count < self->capacity && (count < 0 || filled < count)) {
+		pthread_mutex_unlock(&self->lock);
+		ok = paillier_rn(self, rn);
+		pthread_mutex_lock(&self->lock);
+		if (ok && self->count < self->capacity) {
+			mpz_swap(self->pool[(self->head + self->count) % self->capacity], rn);
+			self->count++;
+			filled++;
+		}
+	}
+	level = self->count;
+	pthread_mutex_unlock(&self->lock);
+	Py_END_ALLOW_THREADS
+	mpz_clear(rn);
+	EXIT_IF(!ok, "could not generate randomness.");
+	return PyLong_FromLong(level);
+}
+
+static PyObject *Paillier_pooled(Paillier *self, PyObject *args) {
+	int level = 0;
+
+	EXIT_IF(!self->initialized, "Paillier context not initialized.");
+	paillier_check_fork(self);
+	if (self->capacity > 0) {
+		pthread_mutex_lock(&self->lock);
+		level = self->count;
+		pthread_mutex_unlock(&self->lock);
 	}
+	return PyLong_FromLong(level);
+}
 
-	EXIT_IF(TRUE, "invalid type.");
+PyMethodDef Paillier_methods[] = {
+	{ "encrypt", (PyCFunction) Paillier_encrypt, METH_VARARGS, "encrypt m as (1 + m*n) * r^n mod n^2 with a pooled r^n." },
+	{ "decrypt", (PyCFunction) Paillier_decrypt, METH_VARARGS, "decrypt a ciphertext mod p^2 and q^2 and recombine (requires p and q)." },
+	{ "add", (PyCFunction) Paillier_add, METH_VARARGS, "ciphertext of the sum of two ciphertexts' plaintexts." },
+	{ "add_plain", (PyCFunction) Paillier_add_plain, METH_VARARGS, "ciphertext of the plaintext plus k." },
+	{ "mul_plain", (PyCFunction) Paillier_mul_plain, METH_VARARGS, "ciphertext of the plaintext times k." },
+	{ "rerandomize", (PyCFunction) Paillier_rerandomize, METH_VARARGS, "multiply a ciphertext by a fresh r^n." },
+	{ "precompute", (PyCFunction) Paillier_precompute, METH_VARARGS, "fill (up to count) pool slots on this thread; returns the pool level." },
+	{ "pooled", (PyCFunction) Paillier_pooled, METH_NOARGS, "number of r^n values waiting in the pool." },
+	{ NULL }
+};
+
+PyTypeObject PaillierType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"integer.Paillier", /*tp_name*/
+	sizeof(Paillier), /*tp_basicsize*/
+	0, /*tp_itemsize*/
+	(destructor)Paillier_dealloc, /*tp_dealloc*/
+	0, /*tp_print*/
+	0, /*tp_getattr*/
+	0, /*tp_setattr*/
+	0, /*tp_reserved*/
+	0, /*tp_repr*/
+	0, /*tp_as_number*/
+	0, /*tp_as_sequence*/
+	0, /*tp_as_mapping*/
+	0, /*tp_hash */
+	0, /*tp_call*/
+	0, /*tp_str*/
+	0, /*tp_getattro*/
+	0, /*tp_setattro*/
+	0, /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT, /*tp_flags*/
+	"Paillier encryption with g = n + 1 and a pool of precomputed r^n", /* tp_doc */
+	0, /* tp_traverse */
+	0, /* tp_clear */
+	0, /* tp_richcompare */
+	0, /* tp_weaklistoffset */
+	0, /* tp_iter */
+	0, /* tp_iternext */
+	Paillier_methods, /* tp_methods */
+	0, /* tp_members */
+	0, /* tp_getset */
+	0, /* tp_base */
+	0, /* tp_dict */
+	0, /* tp_descr_get */
+	0, /* tp_descr_set */
+	0, /* tp_dictoffset */
+	(initproc)Paillier_init, /* tp_init */
+	0, /* tp_alloc */
+	Paillier_new, /* tp_new */
+};
+
+/* END: Paillier engine */
+
+/* START: integer vectors */
+
+#define VECTOR_MUL		0
+#define VECTOR_ADD		1
+#define VECTOR_POW		2
+#define VECTOR_PROD		3
+#define VECTOR_SUM		4
+#define VECTOR_EXPORT	5
+#define VECTOR_IMPORT	6
+
+#define PyIntegerVector_Check(obj) PyObject_TypeCheck(obj, &IntegerVectorType)
+
+/* rop = v[lo] * ... * v[hi - 1] (hi > lo) as a balanced product tree, which keeps the
+ * operands of each multiplication the same size */
+static void vector_prod_tree(mpz_t rop, mpz_t *v, Py_ssize_t lo, Py_ssize_t hi, mpz_srcptr m) {
+	Py_ssize_t mid = lo + (hi - lo) / 2;
+	mpz_t t;
+
+	if (hi - lo == 1) {
+		mpz_set(rop, v[lo]);
+		return;
+	}
+	mpz_init(t);
+	vector_prod_tree(rop, v, lo, mid, m);
+	vector_prod_tree(t, v, mid, hi, m);
+	mpz_mul(rop, rop, t);
+	if (mpz_sgn(m) > 0) mpz_mod(rop, rop, m);
+	mpz_clear(t);
 }
 
-// class method for conversion for modular integer to an integer
-// integer.toInt(x mod Y) => x
-static PyObject *toInt(PyObject *self, PyObject *args) {
-	Integer *intObj = NULL;
+/* Modular products of a share without any division: REDC-multiplying k residues gives their
+ * product times R^-(k - 1), which one final multiplication by R^(k - 1) mod m undoes */
+static void vector_prod_mont(VectorTask *t) {
+	Residues ctx;
+	mp_limb_t *acc, *b;
+	Py_ssize_t i;
+	mpz_t r, y;
+
+	if (!res_init(&ctx, t->m)) {
+		t->error = "out of memory.";
+		return;
+	}
+	acc = (mp_limb_t *) calloc(ctx.n, sizeof(mp_limb_t));
+	b = (mp_limb_t *) malloc(ctx.n * sizeof(mp_limb_t));
+	if (acc == NULL || b == NULL) {
+		free(acc);
+		free(b);
+		res_clear(&ctx);
+		t->error = "out of memory.";
+		return;
+	}
+	mpn_copyi(acc, mpz_limbs_read(t->a[t->start]), (mp_size_t) mpz_size(t->a[t->start]));
+	for (i = t->start + 1; i < t->end; i++) {
+		mpn_zero(b, ctx.n);
+		mpn_copyi(b, mpz_limbs_read(t->a[i]), (mp_size_t) mpz_size(t->a[i]));
+		res_mul(&ctx, acc, acc, b);
+	}
 
-	if (PyInteger_Check(args)) {
-		intObj = (Integer *) args;
-		Integer *rop = createNewInteger();
-		mpz_init_set(rop->e, intObj->e);
-		mpz_init(rop->m);
+	mpz_init_set_ui(r, 1);
+	mpz_mul_2exp(r, r, GMP_NUMB_BITS * ctx.n);
+	mpz_mod(r, r, t->m);
+	mpz_powm_ui(r, r, (unsigned long) (t->end - t->start - 1), t->m);
+	mpz_mul(t->partial, r, mpz_roinit_n(y, acc, ctx.n));
+	mpz_mod(t->partial, t->partial, t->m);
+	mpz_clear(r);
+	free(acc);
+	free(b);
+	res_clear(&ctx);
+}
 
-		return (PyObject *) rop;
+/* runs one share of an operation; touches no Python objects */
+static void *vector_task(void *arg) {
+	VectorTask *t = (VectorTask *) arg;
+	int reduce = mpz_sgn(t->m) > 0;
+	size_t size;
+	Py_ssize_t i;
+	mpz_t e;
+
+	switch (t->op) {
+	case VECTOR_MUL:
+	case VECTOR_ADD:
+		for (i = t->start; i < t->end; i++) {
+			if (t->op == VECTOR_MUL) mpz_mul(t->rop[i], t->a[i], t->b ? t->b[i] : t->s);
+			else mpz_add(t->rop[i], t->a[i], t->b ? t->b[i] : t->s);
+			if (reduce) mpz_mod(t->rop[i], t->rop[i], t->m);
+		}
+		break;
+	case VECTOR_POW:
+		mpz_init(e);
+		for (i = t->start; i < t->end && t->error == NULL; i++) {
+			mpz_set(e, t->b ? t->b[i] : t->s);
+			if (mpz_sgn(e) < 0) {
+				// mpz_powm would raise a division by zero if the inverse doesn't exist
+				if (mpz_invert(t->rop[i], t->a[i], t->m) == 0) {
+					t->error = "element is not invertible.";
+					break;
+				}
+				mpz_neg(e, e);
+			}
+			else {
+				mpz_set(t->rop[i], t->a[i]);
+			}
+			if (mpz_sgn(e) == 0) mpz_set_ui(t->rop[i], 1);
+			else if (mpz_odd_p(t->m)) mpz_powm_sec(t->rop[i], t->rop[i], e, t->m);
+			else mpz_powm(t->rop[i], t->rop[i], e, t->m);
+		}
+		mpz_clear(e);
+		break;
+	case VECTOR_PROD:
+		if (t->end == t->start) mpz_set_ui(t->partial, 1);
+		else if (mpz_odd_p(t->m)) vector_prod_mont(t);
+		else vector_prod_tree(t->partial, t->a, t->start, t->end, t->m);
+		break;
+	case VECTOR_SUM:
+		mpz_set_ui(t->partial, 0);
+		for (i = t->start; i < t->end; i++) {
+			mpz_add(t->partial, t->partial, t->a[i]);
+		}
+		if (reduce) mpz_mod(t->partial, t->partial, t->m);
+		break;
+	case VECTOR_EXPORT:
+		for (i = t->start; i < t->end; i++) {
+			memset(t->buf + i * t->width, 0, t->width);
+			if (mpz_sgn(t->a[i]) == 0) continue;
+			size = (mpz_sizeinbase(t->a[i], 2) + 7) / 8;
+			if (mpz_sgn(t->a[i]) < 0 || size > t->width) {
+				t->error = "element does not fit the width (or is negative).";
+				break;
+			}
+			mpz_export(t->buf + i * t->width + (t->width - size), NULL, 1, 1, 1, 0, t->a[i]);
+		}
+		break;
+	case VECTOR_IMPORT:
+		for (i = t->start; i < t->end; i++) {
+			mpz_import(t->rop[i], t->width, 1, 1, 1, 0, t->buf + i * t->width);
+			if (reduce && mpz_cmp(t->rop[i], t->m) >= 0) {
+				t->error = "element is not reduced mod the modulus.";
+				break;
+			}
+		}
+		break;
+	}
+	return NULL;
+}
+
+/* Runs task over [0, len). Jobs worth at least VECTOR_GRAIN limb multiplications (cost per
+ * element times len) release the GIL and split over up to one thread per online CPU.
+ * Reductions leave their result in task->partial. Returns the error of a failed share. */
+static const char *vector_run(VectorTask *task, Py_ssize_t len, double cost) {
+	VectorTask tasks[VECTOR_MAX_THREADS];
+	pthread_t tid[VECTOR_MAX_THREADS];
+	PyThreadState *state = NULL;
+	const char *error = NULL;
+	int threads = 1, started = 0, i;
+
+	if (cost * len >= VECTOR_GRAIN) {
+		threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+		if (threads > cost * len / VECTOR_GRAIN) threads = (int) (cost * len / VECTOR_GRAIN);
+		if (threads > len) threads = (int) len;
+		if (threads > VECTOR_MAX_THREADS) threads = VECTOR_MAX_THREADS;
+		if (threads < 1) threads = 1;
+		state = PyEval_SaveThread();
+	}
+	for (i = 0; i < threads; i++) {
+		tasks[i] = *task;
+		tasks[i].start = len * i / threads;
+		tasks[i].end = len * (i + 1) / threads;
+		tasks[i].error = NULL;
+		mpz_init(tasks[i].partial);
+	}
+	for (i = 1; i < threads; i++) {
+		if (pthread_create(&tid[i], NULL, vector_task, &tasks[i]) != 0) break;
+		started++;
 	}
+	// the calling thread takes the first share and any share whose thread did not start
+	vector_task(&tasks[0]);
+	for (i = started + 1; i < threads; i++) vector_task(&tasks[i]);
+	for (i = 1; i <= started; i++) pthread_join(tid[i], NULL);
+
+	if (task->op == VECTOR_PROD) mpz_set_ui(task->partial, 1);
+	if (task->op == VECTOR_SUM) mpz_set_ui(task->partial, 0);
+	for (i = 0; i < threads; i++) {
+		if (task->op == VECTOR_PROD) mpz_mul(task->partial, task->partial, tasks[i].partial);
+		if (task->op == VECTOR_SUM) mpz_add(task->partial, task->partial, tasks[i].partial);
+		if ((task->op == VECTOR_PROD || task->op == VECTOR_SUM) && mpz_sgn(task->m) > 0) {
+			mpz_mod(task->partial, task->partial, task->m);
+		}
+		if (error == NULL) error = tasks[i].error;
+		mpz_clear(tasks[i].partial);
+	}
+	if (state != NULL) PyEval_RestoreThread(state);
+	return error;
+}
 
-	EXIT_IF(TRUE, "not a charm integer type.");
+/* size of the vector's values in limbs, from the modulus or else the first element */
+static double vector_limbs(IntegerVector *self) {
+	size_t limbs = mpz_size(self->mod->m);
+	if (limbs == 0 && self->len > 0) limbs = mpz_size(self->v[0]);
+	return limbs > 0 ? (double) limbs : 1.0;
 }
 
-static PyObject *getMod(PyObject *self, PyObject *args) {
-	Integer *intObj = NULL;
+static void vector_clear(IntegerVector *self) {
+	Py_ssize_t i;
 
-	if (PyInteger_Check(args)) {
-		intObj = (Integer *) args;
-		Integer *rop = createNewInteger();
-		mpz_init_set(rop->e, intObj->m);
-		mpz_init(rop->m);
-		return (PyObject *) rop;
+	for (i = 0; i < self->len; i++) {
+		mpz_clear(self->v[i]);
 	}
+	free(self->v);
+	self->v = NULL;
+	self->len = 0;
+}
 
-	EXIT_IF(TRUE, "not a charm integer type.");
+/* allocates len zero values (and takes a reference to mod); FALSE without memory */
+static int vector_resize(IntegerVector *self, Py_ssize_t len, IntegerModulus *mod) {
+	Py_ssize_t i;
+
+	vector_clear(self);
+	modulus_release(self->mod);
+	self->mod = modulus_ref(mod);
+	if (len > 0) {
+		self->v = (mpz_t *) malloc(sizeof(mpz_t) * len);
+		if (self->v == NULL) {
+			PyErr_NoMemory();
+			return FALSE;
+		}
+		for (i = 0; i < len; i++) {
+			mpz_init(self->v[i]);
+		}
+	}
+	self->len = len;
+	return TRUE;
 }
 
-static PyObject *Integer_xor(PyObject *self, PyObject *other) {
-	Integer *rop = NULL, *op1 = NULL, *op2 = NULL;
+static IntegerVector *vector_alloc(Py_ssize_t len, IntegerModulus *mod) {
+	IntegerVector *self = PyObject_New(IntegerVector, &IntegerVectorType);
 
-	if (PyInteger_Check(self))
-		op1 = (Integer *) self;
-	if (PyInteger_Check(other))
-		op2 = (Integer *) other;
+	if (self == NULL) return NULL;
+	self->v = NULL;
+	self->len = 0;
+	self->mod = modulus_ref(&no_modulus);
+	self->initialized = TRUE;
+	if (!vector_resize(self, len, mod)) {
+		Py_DECREF(self);
+		return NULL;
+	}
+	return self;
+}
 
-	EXIT_IF(op1 == NULL || op2 == NULL, "both types are not of charm integer types.");
-	if (PyInteger_Init(op1, op2)) {
-		rop = createNewInteger();
-		mpz_init(rop->e);
-		mpz_init(rop->m);
-		mpz_xor(rop->e, op1->e, op2->e);
-		return (PyObject *) rop;
+void IntegerVector_dealloc(IntegerVector *self) {
+	vector_clear(self);
+	modulus_release(self->mod);
+	Py_TYPE(self)->tp_free((PyObject *) self);
+}
+
+PyObject *IntegerVector_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+	IntegerVector *self = (IntegerVector *) type->tp_alloc(type, 0);
+	if (self != NULL) {
+		self->v = NULL;
+		self->len = 0;
+		self->mod = modulus_ref(&no_modulus);
+		self->initialized = FALSE;
+	}
+	return (PyObject *) self;
+}
+
+int IntegerVector_init(IntegerVector *self, PyObject *args, PyObject *kwds) {
+	PyObject *values = NULL, *modulus = Py_None, *seq = NULL, *item;
+	IntegerModulus *mod = NULL;
+	Py_ssize_t len, i;
+	mpz_t m;
+	static char *kwlist[] = { "values", "modulus", NULL };
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &values, &modulus)) {
+		return -1;
 	}
+	// a worker thread may still be reading the values of a vector in use
+	if (self->initialized) {
+		PyErr_SetString(IntegerError, "IntegerVector already initialized.");
+		return -1;
+	}
+	seq = values != NULL ? PySequence_Fast(values, "values must be iterable.") : PyTuple_New(0);
+	if (seq == NULL) return -1;
+	len = PySequence_Fast_GET_SIZE(seq);
 
-	EXIT_IF(TRUE, "objects not initialized properly.");
+	mpz_init(m);
+	if (modulus != Py_None) {
+		if (!objectToMPZ(m, modulus) || mpz_sgn(m) < 0) {
+			mpz_clear(m);
+			Py_DECREF(seq);
+			PyErr_SetString(IntegerError, "modulus must be a non-negative integer.");
+			return -1;
+		}
+		mod = modulus_get(m);
+	}
+	else {
+		// without an explicit modulus the vector adopts its first element's
+		for (i = 0; i < len && mod == NULL; i++) {
+			item = PySequence_Fast_GET_ITEM(seq, i);
+			if (PyInteger_Check(item) && mpz_sgn(((Integer *) item)->mod->m) > 0) {
+				mod = modulus_ref(((Integer *) item)->mod);
+			}
+		}
+		if (mod == NULL) mod = modulus_ref(&no_modulus);
+	}
+	mpz_clear(m);
+
+	if (!vector_resize(self, len, mod)) {
+		modulus_release(mod);
+		Py_DECREF(seq);
+		return -1;
+	}
+	modulus_release(mod);
+	for (i = 0; i < len; i++) {
+		item = PySequence_Fast_GET_ITEM(seq, i);
+		if (PyInteger_Check(item) && mpz_sgn(((Integer *) item)->mod->m) > 0
+				&& modulus_cmp((Integer *) item, self) != 0) {
+			PyErr_SetString(IntegerError, "elements must share the vector's modulus.");
+			break;
+		}
+		if (!objectToMPZ(self->v[i], item)) {
+			PyErr_SetString(IntegerError, "elements must be integers.");
+			break;
+		}
+		if (mpz_sgn(self->mod->m) > 0) mpz_mod(self->v[i], self->v[i], self->mod->m);
+	}
+	Py_DECREF(seq);
+	if (i < len) {
+		vector_clear(self);
+		return -1;
+	}
+	self->initialized = TRUE;
+	return 0;
+}
+
+static Py_ssize_t IntegerVector_length(IntegerVector *self) {
+	return self->len;
+}
+
+static PyObject *IntegerVector_item(IntegerVector *self, Py_ssize_t i) {
+	Integer *rop = NULL;
+
+	if (i < 0 || i >= self->len) {
+		PyErr_SetString(PyExc_IndexError, "vector index out of range.");
+		return NULL;
+	}
+	rop = createNewInteger();
+	mpz_init_set(rop->e, self->v[i]);
+	rop->mod = modulus_ref(self->mod);
+	return (PyObject *) rop;
+}
+
+/* element-wise lhs op rhs where one side (the base for pow) is a vector and the other a
+ * vector of the same length or a scalar broadcast to every element */
+static PyObject *vector_binary(PyObject *lhs, PyObject *rhs, int op) {
+	IntegerVector *vec = NULL, *rop = NULL, *other = NULL;
+	VectorTask task;
+	const char *error;
+	double cost;
+	mpz_t s;
+
+	if (!PyIntegerVector_Check(lhs)) {
+		if (op == VECTOR_POW) Py_RETURN_NOTIMPLEMENTED;
+		// mul and add commute
+		PyObject *t = lhs;
+		lhs = rhs;
+		rhs = t;
+	}
+	vec = (IntegerVector *) lhs;
+	memset(&task, 0, sizeof(task));
+	task.op = op;
+	task.a = vec->v;
+	task.m = vec->mod->m;
+
+	mpz_init(s);
+	if (PyIntegerVector_Check(rhs)) {
+		other = (IntegerVector *) rhs;
+		if (other->len != vec->len) {
+			mpz_clear(s);
+			ErrorMsg("vectors must have the same length.");
+		}
+		// exponents live in a different group than the bases
+		if (op != VECTOR_POW && modulus_cmp(other, vec) != 0) {
+			mpz_clear(s);
+			ErrorMsg("vectors must share a modulus.");
+		}
+		task.b = other->v;
+	}
+	else if (PyInteger_Check(rhs) || PyLong_Check(rhs)) {
+		if (op != VECTOR_POW && PyInteger_Check(rhs) && mpz_sgn(((Integer *) rhs)->mod->m) > 0
+				&& modulus_cmp((Integer *) rhs, vec) != 0) {
+			mpz_clear(s);
+			ErrorMsg("operand must share the vector's modulus.");
+		}
+		objectToMPZ(s, rhs);
+		if (op != VECTOR_POW && mpz_sgn(task.m) > 0) mpz_mod(s, s, task.m);
+		task.s = s;
+	}
+	else {
+		mpz_clear(s);
+		Py_RETURN_NOTIMPLEMENTED;
+	}
+	if (op == VECTOR_POW && mpz_sgn(task.m) == 0) {
+		mpz_clear(s);
+		ErrorMsg("exponentiation requires a modulus.");
+	}
+
+	if ((rop = vector_alloc(vec->len, vec->mod)) == NULL) {
+		mpz_clear(s);
+		return NULL;
+	}
+	task.rop = rop->v;
+	cost = vector_limbs(vec);
+	if (op == VECTOR_MUL) cost *= cost;
+	if (op == VECTOR_POW) cost *= cost * mpz_sizeinbase(task.m, 2);
+	error = vector_run(&task, vec->len, cost);
+	mpz_clear(s);
+	if (error != NULL) {
+		Py_DECREF(rop);
+		ErrorMsg(error);
+	}
+	return (PyObject *) rop;
+}
+
+static PyObject *IntegerVector_add(PyObject *lhs, PyObject *rhs) {
+	return vector_binary(lhs, rhs, VECTOR_ADD);
+}
+
+static PyObject *IntegerVector_mul(PyObject *lhs, PyObject *rhs) {
+	return vector_binary(lhs, rhs, VECTOR_MUL);
+}
+
+static PyObject *IntegerVector_pow(PyObject *base, PyObject *exp, PyObject *mod) {
+	EXIT_IF(mod != Py_None, "three-argument pow is not supported.");
+	return vector_binary(base, exp, VECTOR_POW);
+}
+
+static PyObject *vector_reduce(IntegerVector *self, int op) {
+	VectorTask task;
+	Integer *rop = NULL;
+	double cost = vector_limbs(self);
+
+	memset(&task, 0, sizeof(task));
+	task.op = op;
+	task.a = self->v;
+	task.m = self->mod->m;
+	rop = createNewInteger();
+	mpz_init(rop->e);
+	rop->mod = modulus_ref(self->mod);
+	mpz_init(task.partial);
+	vector_run(&task, self->len, op == VECTOR_PROD ? cost * cost : cost);
+	mpz_swap(rop->e, task.partial);
+	mpz_clear(task.partial);
+	return (PyObject *) rop;
+}
+
+static PyObject *IntegerVector_prod(IntegerVector *self, PyObject *args) {
+	return vector_reduce(self, VECTOR_PROD);
+}
+
+static PyObject *IntegerVector_sum(IntegerVector *self, PyObject *args) {
+	return vector_reduce(self, VECTOR_SUM);
+}
+
+/* fixed-width big-endian values back to back; width defaults to the modulus' byte length
+ * (or the widest element without a modulus) */
+static PyObject *IntegerVector_toBytes(IntegerVector *self, PyObject *args) {
+	VectorTask task;
+	PyObject *data = NULL;
+	const char *error;
+	Py_ssize_t width = 0, i;
+	size_t size;
+
+	if (!PyArg_ParseTuple(args, "|n", &width)) {
+		ErrorMsg("invalid argument type: expected a width.");
+	}
+	EXIT_IF(width < 0, "width must be non-negative.");
+	if (width == 0 && mpz_sgn(self->mod->m) > 0) {
+		width = (mpz_sizeinbase(self->mod->m, 2) + 7) / 8;
+	}
+	else if (width == 0) {
+		for (i = 0; i < self->len; i++) {
+			size = (mpz_sizeinbase(self->v[i], 2) + 7) / 8;
+			if (size > (size_t) width) width = (Py_ssize_t) size;
+		}
+	}
+	EXIT_IF(self->len > 0 && width > PY_SSIZE_T_MAX / self->len, "vector too large.");
+	if ((data = PyBytes_FromStringAndSize(NULL, self->len * width)) == NULL) return NULL;
+
+	memset(&task, 0, sizeof(task));
+	task.op = VECTOR_EXPORT;
+	task.a = self->v;
+	task.m = self->mod->m;
+	task.buf = (unsigned char *) PyBytes_AS_STRING(data);
+	task.width = (size_t) width;
+	error = vector_run(&task, self->len, (double) width / sizeof(mp_limb_t));
+	if (error != NULL) {
+		Py_DECREF(data);
+		ErrorMsg(error);
+	}
+	return data;
+}
+
+static PyObject *IntegerVector_fromBytes(PyObject *cls, PyObject *args, PyObject *kwds) {
+	Py_buffer data;
+	PyObject *modulus = Py_None;
+	IntegerModulus *mod = NULL;
+	IntegerVector *rop = NULL;
+	VectorTask task;
+	const char *error;
+	Py_ssize_t width = 0;
+	mpz_t m;
+	static char *kwlist[] = { "data", "width", "modulus", NULL };
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "y*|nO", kwlist, &data, &width, &modulus)) {
+		return NULL;
+	}
+	mpz_init(m);
+	if (modulus != Py_None && (!objectToMPZ(m, modulus) || mpz_sgn(m) < 0)) {
+		mpz_clear(m);
+		PyBuffer_Release(&data);
+		ErrorMsg("modulus must be a non-negative integer.");
+	}
+	if (width == 0 && mpz_sgn(m) > 0) width = (mpz_sizeinbase(m, 2) + 7) / 8;
+	if (width <= 0) {
+		mpz_clear(m);
+		PyBuffer_Release(&data);
+		ErrorMsg("give a width or a modulus.");
+	}
+	if (data.len % width != 0) {
+		mpz_clear(m);
+		PyBuffer_Release(&data);
+		ErrorMsg("data is not a whole number of values.");
+	}
+	mod = modulus_get(m);
+	mpz_clear(m);
+	rop = vector_alloc(data.len / width, mod);
+	modulus_release(mod);
+	if (rop == NULL) {
+		PyBuffer_Release(&data);
+		return NULL;
+	}
+
+	memset(&task, 0, sizeof(task));
+	task.op = VECTOR_IMPORT;
+	task.rop = rop->v;
+	task.m = rop->mod->m;
+	task.buf = (unsigned char *) data.buf;
+	task.width = (size_t) width;
+	error = vector_run(&task, rop->len, (double) width / sizeof(mp_limb_t));
+	PyBuffer_Release(&data);
+	if (error != NULL) {
+		Py_DECREF(rop);
+		ErrorMsg(error);
+	}
+	return (PyObject *) rop;
+}
+
+static PyObject *IntegerVector_richcompare(PyObject *lhs, PyObject *rhs, int op) {
+	IntegerVector *a = (IntegerVector *) lhs, *b = (IntegerVector *) rhs;
+	int equal;
+	Py_ssize_t i;
+
+	if (!PyIntegerVector_Check(lhs) || !PyIntegerVector_Check(rhs) || (op != Py_EQ && op != Py_NE)) {
+		Py_RETURN_NOTIMPLEMENTED;
+	}
+	equal = a->len == b->len && modulus_cmp(a, b) == 0;
+	for (i = 0; equal && i < a->len; i++) {
+		equal = mpz_cmp(a->v[i], b->v[i]) == 0;
+	}
+	if (equal == (op == Py_EQ)) Py_RETURN_TRUE;
+	Py_RETURN_FALSE;
 }
 
+PyMethodDef IntegerVector_methods[] = {
+	{ "prod", (PyCFunction) IntegerVector_prod, METH_NOARGS, "product of the elements, as a product tree split over threads." },
+	{ "sum", (PyCFunction) IntegerVector_sum, METH_NOARGS, "sum of the elements." },
+	{ "toBytes", (PyCFunction) IntegerVector_toBytes, METH_VARARGS, "export the elements as fixed-width big-endian values." },
+	{ "fromBytes", (PyCFunction) IntegerVector_fromBytes, METH_VARARGS | METH_KEYWORDS | METH_CLASS, "import fixed-width big-endian values (the width defaults to the modulus' byte length)." },
+	{ NULL }
+};
+
+PyNumberMethods vector_number = {
+	IntegerVector_add, /* nb_add */
+	0, /* nb_subtract */
+	IntegerVector_mul, /* nb_multiply */
+	0, /* nb_remainder */
+	0, /* nb_divmod */
+	(ternaryfunc) IntegerVector_pow, /* nb_power */
+};
+
+PySequenceMethods vector_sequence = {
+	(lenfunc) IntegerVector_length, /* sq_length */
+	0, /* sq_concat */
+	0, /* sq_repeat */
+	(ssizeargfunc) IntegerVector_item, /* sq_item */
+};
+
+PyTypeObject IntegerVectorType = {
+	PyVarObject_HEAD_INIT(NULL, 0)
+	"integer.IntegerVector", /*tp_name*/
+	sizeof(IntegerVector), /*tp_basicsize*/
+	0, /*tp_itemsize*/
+	(destructor)IntegerVector_dealloc, /*tp_dealloc*/
+	0, /*tp_print*/
+	0, /*tp_getattr*/
+	0, /*tp_setattr*/
+	0, /*tp_reserved*/
+	0, /*tp_repr*/
+	&vector_number, /*tp_as_number*/
+	&vector_sequence, /*tp_as_sequence*/
+	0, /*tp_as_mapping*/
+	0, /*tp_hash */
+	0, /*tp_call*/
+	0, /*tp_str*/
+	0, /*tp_getattro*/
+	0, /*tp_setattro*/
+	0, /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT, /*tp_flags*/
+	"contiguous vector of integers sharing one modulus", /* tp_doc */
+	0, /* tp_traverse */
+	0, /* tp_clear */
+	IntegerVector_richcompare, /* tp_richcompare */
+	0, /* tp_weaklistoffset */
+	0, /* tp_iter */
+	0, /* tp_iternext */
+	IntegerVector_methods, /* tp_methods */
+	0, /* tp_members */
+	0, /* tp_getset */
+	0, /* tp_base */
+	0, /* tp_dict */
+	0, /* tp_descr_get */
+	0, /* tp_descr_set */
+	0, /* tp_dictoffset */
+	(initproc)IntegerVector_init, /* tp_init */
+	0, /* tp_alloc */
+	IntegerVector_new, /* tp_new */
+};
+
+/* END: integer vectors */
+
 #ifdef BENCHMARK_ENABLED
 #define BenchmarkIdentifier 	3
 
@@ -2248,6 +4812,7 @@ PyMethodDef Integer_methods[] = {
 	{ "isCoPrime", (PyCFunction) testCoPrime, METH_O, "determine whether two integers a and b are relatively prime." },
 	#endif
 	{ "isCongruent", (PyCFunction) testCongruency, METH_VARARGS, "determine whether two integers are congruent mod n." },
+	{ "initPP", (PyCFunction) Integer_initPP, METH_VARARGS, "Initialize a fixed-base table for exponents of up to the given number of bits." },
 //	{ "reduce", (PyCFunction) Integer_reduce, METH_NOARGS, "reduce an integer object modulo N." },
 	{ NULL }
 };
@@ -2422,7 +4987,7 @@ PyTypeObject IntegerType = {
 PyMethodDef module_methods[] = {
 	{ "randomBits", (PyCFunction) genRandomBits, METH_VARARGS, "generate a random number of bits from 0 to 2^n-1." },
 	{ "random", (PyCFunction) genRandom, METH_VARARGS, "generate a random number in range of 0 to n-1 where n is large number." },
-	{ "randomPrime", (PyCFunction) genRandomPrime, METH_VARARGS, "generate a probabilistic random prime number that is n-bits." },
+	{ "randomPrime", (PyCFunction) genRandomPrime, METH_VARARGS, "generate a probabilistic random prime number that is n-bits: randomPrime(bits, safe=0, threads=0)." },
 	{ "isPrime", (PyCFunction) testPrimality, METH_O, "probabilistic algorithm to whether a given integer is prime." },
 	{ "encode", (PyCFunction) encode_message, METH_VARARGS, "encode a message as a group element where p = 2*q + 1 only." },
 	{ "decode", (PyCFunction) decode_message, METH_VARARGS, "decode a message from a group element where p = 2*q + 1 to a message." },
@@ -2431,8 +4996,14 @@ PyMethodDef module_methods[] = {
 	{ "legendre", (PyCFunction) legendre, METH_VARARGS, "given a and a positive prime p compute the legendre symbol." },
 	{ "gcd", (PyCFunction) gcdCall, METH_VARARGS, "compute the gcd of two integers a and b." },
 	{ "lcm", (PyCFunction) lcmCall, METH_VARARGS, "compute the lcd of two integers a and b." },
-	{ "serialize", (PyCFunction) serialize, METH_VARARGS, "Serialize an integer type into bytes." },
-	{ "deserialize", (PyCFunction) deserialize, METH_VARARGS, "De-serialize an bytes object into an integer object" },
+	{ "powm_public", (PyCFunction) powm_public, METH_VARARGS, "variable-time modular exponentiation: no side-channel protection for the exponent or the base." },
+	{ "multiexp", (PyCFunction) multiexp, METH_VARARGS, "compute the product of bases[i] ** exponents[i] in one pass (variable time: public exponents only)." },
+	{ "multiexp_sec", (PyCFunction) multiexp_sec, METH_VARARGS, "constant-time multiexp for secret exponents." },
+	{ "batch_invert", (PyCFunction) batch_invert, METH_O, "invert a list of integers mod the same n with a single modular inversion." },
+	{ "serialize", (PyCFunction) serialize, METH_VARARGS, "Serialize an integer type into bytes: serialize(x, raw=False, context=None)." },
+	{ "deserialize", (PyCFunction) deserialize, METH_VARARGS, "De-serialize an bytes object into an integer object: deserialize(data, context=None)" },
+	{ "serializeList", (PyCFunction) serializeList, METH_VARARGS, "Serialize a list of integers with a shared modulus into one raw buffer." },
+	{ "deserializeList", (PyCFunction) deserializeList, METH_VARARGS, "De-serialize a buffer written by serializeList into a list of integers." },
 #ifdef BENCHMARK_ENABLED
 	{ "InitBenchmark", (PyCFunction) InitBenchmark, METH_NOARGS, "Initialize a benchmark object" },
 	{ "StartBenchmark", (PyCFunction) StartBenchmark, METH_VARARGS, "Start a new benchmark with some options" },
@@ -2494,6 +5065,14 @@ void initinteger(void) {
 	PyObject *m=NULL;
 	if (PyType_Ready(&IntegerType) < 0)
 		CLEAN_EXIT;
+	if (PyType_Ready(&CRTType) < 0)
+		CLEAN_EXIT;
+	if (PyType_Ready(&PaillierType) < 0)
+		CLEAN_EXIT;
+	if (PyType_Ready(&IntegerVectorType) < 0)
+		CLEAN_EXIT;
+	mpz_init(no_modulus.m);
+	no_modulus.refcount = 1;
 #ifdef BENCHMARK_ENABLED
     if(import_benchmark() < 0)
     	CLEAN_EXIT;
@@ -2520,6 +5099,12 @@ void initinteger(void) {
 
 	Py_INCREF(&IntegerType);
 	PyModule_AddObject(m, "integer", (PyObject *) &IntegerType);
+	Py_INCREF(&CRTType);
+	PyModule_AddObject(m, "CRT", (PyObject *) &CRTType);
+	Py_INCREF(&PaillierType);
+	PyModule_AddObject(m, "Paillier", (PyObject *) &PaillierType);
+	Py_INCREF(&IntegerVectorType);
+	PyModule_AddObject(m, "IntegerVector", (PyObject *) &IntegerVectorType);
 
 #ifdef BENCHMARK_ENABLED
 	// add integer error to module
@@ -42,8 +42,11 @@
 #include <math.h>
 #include <string.h>
 #include <gmp.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "benchmarkmodule.h"
 #include "base64.h"
+#include "drbg.h"
 /* used to initialize the RNG */
 #include <openssl/objects.h>
 #include <openssl/rand.h>
@@ -142,13 +145,116 @@ static PyObject *IntegerError;
 #define PyInteger_Check(obj) PyObject_TypeCheck(obj, &IntegerType)
 #define PyInteger_Init(obj1, obj2) obj1->initialized && obj2->initialized
 
+/* Immutable modulus shared (by reference count) by every element of a group, so results
+ * of arithmetic point at their operands' modulus instead of copying it. A zero modulus
+ * means the element is a plain integer. Only touched while holding the GIL. */
 typedef struct {
-	PyObject_HEAD
+	long refcount;
 	mpz_t m;
+	size_t bits;	/* bit length of m (0 without a modulus) */
+	int odd;		/* m is odd, so the Montgomery-based mpz_powm_sec applies */
+} IntegerModulus;
+
+/* fixed-base table built by initPP() */
+#define PP_WINDOW	4
+#define PP_ENTRIES	(1 << PP_WINDOW)
+typedef struct {
+	mp_limb_t *table;	/* windows * PP_ENTRIES entries of nlimbs limbs */
+	mp_size_t nlimbs;
+	int windows;
+	size_t exp_bits;	/* largest exponent the table covers */
+} IntegerPP;
+
+typedef struct {
+	PyObject_HEAD
+	IntegerModulus *mod;
 	mpz_t e;
 	int initialized;
+	IntegerPP *pp;		/* fixed-base table, NULL unless initPP() was called */
 } Integer;
 
+/* precomputed (p, q) data for private-key exponentiation mod n = p*q and mod n^2 */
+typedef struct {
+	PyObject_HEAD
+	mpz_t p, q, p2, q2;
+	mpz_t ord_p, ord_q;		/* p - 1, q - 1 */
+	mpz_t ord_p2, ord_q2;	/* p(p - 1), q(q - 1) */
+	mpz_t q_inv, q2_inv;	/* q^-1 mod p, q^-2 mod p^2 */
+	IntegerModulus *n, *n2;
+	int initialized;
+} CRT;
+
+/* Paillier with g = n + 1: encryption is (1 + m*n) * r^n mod n^2, so the only exponentiation
+ * is r^n, which does not depend on m and comes from a pool that worker threads keep topped up.
+ * pool, head and count are guarded by lock; the workers never touch Python objects. */
+#define PAILLIER_MAX_THREADS	16
+typedef struct {
+	PyObject_HEAD
+	mpz_t n, n2;
+	int has_key;			/* p and q are known: CRT for r^n and decryption */
+	mpz_t p, q, p2, q2;
+	mpz_t ord_p2, ord_q2;	/* p(p - 1), q(q - 1) */
+	mpz_t q_inv, q2_inv;	/* q^-1 mod p, q^-2 mod p^2 */
+	mpz_t h_p, h_q;			/* L_p((n + 1)^(p - 1) mod p^2)^-1 = -q^-1 mod p, and likewise mod q */
+	IntegerModulus *mod_n, *mod_n2;
+	mpz_t *pool;
+	int capacity, head, count;
+	int nthreads, stop;
+	pthread_t threads[PAILLIER_MAX_THREADS];
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pid_t pid;				/* process that started the workers */
+	int initialized;
+} Paillier;
+
+/* contiguous array of values sharing one modulus. Element-wise operations and reductions
+ * run without the GIL, split over threads once they cost more than VECTOR_GRAIN
+ * limb multiplications. */
+#define VECTOR_MAX_THREADS	64
+#define VECTOR_GRAIN		(1 << 18)
+typedef struct {
+	PyObject_HEAD
+	IntegerModulus *mod;
+	mpz_t *v;
+	Py_ssize_t len;
+	int initialized;
+} IntegerVector;
+
+/* one thread's share [start, end) of an IntegerVector operation */
+typedef struct {
+	int op;
+	mpz_t *rop, *a, *b;		/* b is NULL when the right operand is the scalar s */
+	mpz_srcptr s, m;		/* m is 0 without a modulus */
+	unsigned char *buf;		/* toBytes/fromBytes buffer of width-byte values */
+	size_t width;
+	Py_ssize_t start, end;
+	mpz_t partial;			/* prod/sum of the share */
+	const char *error;		/* set by a failing thread */
+} VectorTask;
+
+/* first byte of the raw serialization; base64 encodings start with an ASCII digit instead */
+#define RAW_TAG			0x80
+#define RAW_NEGATIVE	0x01	/* single elements: the value is negative */
+#define RAW_MODULUS		0x02	/* the modulus is written out */
+#define RAW_CONTEXT		0x04	/* the modulus is an index into the reader's context */
+#define RAW_LIST		0x08	/* serializeList encoding */
+
+/* randomPrime: candidates are sieved by the odd primes below SIEVE_LIMIT over windows of
+ * SIEVE_WINDOW odd numbers, and each search thread walks up from its own random start */
+#define SIEVE_LIMIT		(1 << 20)
+#define SIEVE_WINDOW	4096
+#define PRIME_MAX_THREADS	64
+typedef struct {
+	int bits, safe;
+	int found;			/* set once any thread has a prime, under lock */
+	int failed;			/* a thread could not draw a start (or allocate); also sets found */
+	pthread_mutex_t lock;
+	mpz_t result;
+} PrimeSearch;
+
+PyTypeObject CRTType;
+PyTypeObject PaillierType;
+PyTypeObject IntegerVectorType;
 PyMethodDef Integer_methods[];
 PyNumberMethods integer_number;
 
@@ -157,6 +263,14 @@ PyObject *Integer_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 int Integer_init(Integer *self, PyObject *args, PyObject *kwds);
 PyObject *Integer_print(Integer *self);
 Integer *createNewInteger(void);
+IntegerModulus *modulus_get(const mpz_t m);
+IntegerModulus *modulus_ref(IntegerModulus *mod);
+void modulus_release(IntegerModulus *mod);
+void pp_free(IntegerPP *pp);
+void set_modulus(Integer *obj, const mpz_t m);
+
+/* compares the moduli of two elements, skipping the limb comparison when they share one */
+#define modulus_cmp(a, b) ((a)->mod == (b)->mod ? 0 : mpz_cmp((a)->mod->m, (b)->mod->m))
 void print_mpz(mpz_t x, int base);
 void print_bn_dec(const BIGNUM *bn);
 
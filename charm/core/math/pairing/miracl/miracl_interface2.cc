@@ -30,8 +30,51 @@
 #include "miracl_config.h"
 #include "miracl_interface2.h"
 #include "miracl.h"
+#include "drbg.h"
 #include <sstream>
 
+/* group law used by the multi-exponentiation below (additive for points, multiplicative for GT) */
+static inline G1 multi_exp_op(const G1& a, const G1& b) { return a + b; }
+#if (BUILD_MNT_CURVE == 1 || BUILD_BN_CURVE == 1)
+static inline G2 multi_exp_op(const G2& a, const G2& b) { return a + b; }
+#endif
+static inline GT multi_exp_op(const GT& a, const GT& b) { return a * b; }
+
+#define MULTI_EXP_WIN	4
+
+/*
+ * Straus' interleaved method with fixed 4-bit windows: base[i]^exp[i] for all i share one
+ * chain of squarings (doublings), so n bases cost about bits + n*bits/4 group operations
+ * instead of n separate exponentiations.
+ */
+template<class T>
+static T multi_exp(int n, T *base, Big *exp, const T& identity)
+{
+	int i, j, k, max_bits = 0, win = 1 << MULTI_EXP_WIN;
+	T *table = new T[n * win];
+
+	for(i = 0; i < n; i++) {
+		T *t = &table[i * win];
+		t[0] = identity;
+		t[1] = base[i];
+		for(j = 2; j < win; j++) t[j] = multi_exp_op(t[j-1], base[i]);
+		if(bits(exp[i]) > max_bits) max_bits = bits(exp[i]);
+	}
+
+	T r = identity;
+	for(k = (max_bits + MULTI_EXP_WIN - 1) / MULTI_EXP_WIN - 1; k >= 0; k--) {
+		for(j = 0; j < MULTI_EXP_WIN; j++) r = multi_exp_op(r, r);
+		for(i = 0; i < n; i++) {
+			int d = 0;
+			for(j = MULTI_EXP_WIN - 1; j >= 0; j--) d = (d << 1) | bit(exp[i], k * MULTI_EXP_WIN + j);
+			if(d != 0) r = multi_exp_op(r, table[i * win + d]);
+		}
+	}
+
+	delete [] table;
+	return r;
+}
+
 extern "C" {
 
 string _base64_encode(unsigned char const* bytes_to_encode, unsigned int in_len);
@@ -123,10 +166,14 @@ pairing_t *pairing_init(int securitylevel) {
 
 	//cout << "Initialized: " << pfc << endl;
     //cout << "Order = " << pfc->order() << endl;
-    time_t seed;
+    long seed;
 
-    time(&seed);
-    irand((long)seed); // weak RNG for now
+    // MIRACL's own generator only serves internal needs; random elements come from drbg_bytes
+    if(!drbg_bytes((unsigned char *) &seed, sizeof(seed))) {
+    	delete pfc;
+    	return NULL;
+    }
+    irand(seed);
 
 	// TODO: need to initialize RNG here as well (Testing w/o for now)
     return (pairing_t *) pfc;
@@ -218,6 +265,26 @@ int _element_pp_init(const pairing_t *pairing, Group_t type, element_t *e)
 	return TRUE;
 }
 
+int _element_pp_init_pairing(const pairing_t *pairing, Group_t type, element_t *e)
+{
+	PFC *pfc = (PFC *) pairing;
+	// the table lives in G2::ptable, so pairing() and multi_pairing() pick it up on their own
+	if(type != pyG2_t) { return FALSE; }
+	G2 *g = (G2 *) e;
+	if(g->g.iszero() == TRUE) { return FALSE; }
+	if(g->ptable == NULL) {
+		pfc->precomp_for_pairing(*g);
+	}
+	return TRUE;
+}
+
+int _element_has_pp_pairing(Group_t type, const element_t *e)
+{
+	if(type != pyG2_t) { return FALSE; }
+	G2 *g = (G2 *) e;
+	return (g->ptable != NULL) ? TRUE : FALSE;
+}
+
 element_t *element_gt(const pairing_t *pairing)
 {
 	PFC *pfc = (PFC *) pairing;
@@ -232,22 +299,49 @@ element_t *element_gt(const pairing_t *pairing)
 	return (element_t *) h;
 }
 
-void element_random(Group_t type, const pairing_t *pairing, element_t *e) {
+/* uniform in [0, n) up to a 2^-128 bias: 128 extra random bits are reduced mod n */
+static int _random_below(Big& x, const Big& n)
+{
+	int len = (bits(n) + 7) / 8 + 16, ok;
+	unsigned char *buf = new unsigned char[len];
+	ok = drbg_bytes(buf, len);
+	if(ok) x = from_binary(len, (char *) buf) % n;
+	memset(buf, 0, len);
+	delete [] buf;
+	return ok;
+}
+
+/* hex string of 32 random bytes: random points are hashed from it, so their discrete
+ * logarithms stay unknown */
+static int _random_string(char out[65])
+{
+	unsigned char buf[32];
+	int i;
+	if(!drbg_bytes(buf, sizeof(buf))) return FALSE;
+	for(i = 0; i < 32; i++) sprintf(out + 2 * i, "%02x", buf[i]);
+	memset(buf, 0, sizeof(buf));
+	return TRUE;
+}
+
+int element_random(Group_t type, const pairing_t *pairing, element_t *e) {
 	PFC *pfc = (PFC *) pairing;
+	char str[65];
 
 	if(type == pyZR_t) {
 		Big *x = (Big *) e;
-		pfc->random(*x);
-		*x = *x % pfc->order();
-		// cout << "1st: generated a random value x = " << *x << endl;
+		return _random_below(*x, pfc->order());
 	}
 	else if(type == pyG1_t) {
 		G1 *g = (G1 *) e;
-		pfc->random(*g);
+		if(!_random_string(str)) return FALSE;
+		pfc->hash_and_map(*g, str);
+		return TRUE;
 	}
 	else if(type == pyG2_t) {
 		G2 *g = (G2 *) e;
-		pfc->random(*g);
+		if(!_random_string(str)) return FALSE;
+		pfc->hash_and_map(*g, str);
+		return TRUE;
 	}
 	else if(type == pyGT_t) {
 		cout << "Error: can't generate random GT elements directly!" << endl;
@@ -255,6 +349,7 @@ void element_random(Group_t type, const pairing_t *pairing, element_t *e) {
 	else {
 		cout << "Error: unrecognized type." << endl;
 	}
+	return FALSE;
 }
 
 void element_printf(Group_t type, const element_t *e)
@@ -1009,8 +1104,9 @@ element_t *_element_pairing(const pairing_t *pairing, const element_t *in1, cons
 	}
 
 #if BUILD_MNT_CURVE == 1
-	pfc->precomp_for_pairing(*g2);
+	if(g2->ptable == NULL) pfc->precomp_for_pairing(*g2);
 #endif
+	// uses the precomputed lines when initPP() was called on g2
 	GT *gt = new GT(pfc->pairing(*g2, *g1)); // assumes type-3 pairings for now
 
 //	cout << "Result of pairing => " << gt->g << endl;
@@ -1019,6 +1115,93 @@ element_t *_element_pairing(const pairing_t *pairing, const element_t *in1, cons
 	return (element_t *) gt;
 }
 
+element_t *_element_multi_pow(Group_t type, const pairing_t *pairing, element_t **a, element_t **b, int length, const element_t *o)
+{
+	if(length <= 0) { return NULL; }
+	Big *order = (Big *) o;
+	Big *exp = new Big[length];
+	int i;
+
+	for(i = 0; i < length; i++) {
+		// windows are taken over non-negative exponents < order
+		exp[i] = *((Big *) b[i]) % *order;
+		if(exp[i] < 0) exp[i] += *order;
+	}
+
+	element_t *result = NULL;
+	if(type == pyG1_t) {
+		G1 *base = new G1[length];
+		for(i = 0; i < length; i++) base[i] = *((G1 *) a[i]);
+		G1 id;
+		result = (element_t *) new G1(multi_exp(length, base, exp, id));
+		delete [] base;
+	}
+#if (BUILD_MNT_CURVE == 1 || BUILD_BN_CURVE == 1)
+	else if(type == pyG2_t) {
+		G2 *base = new G2[length];
+		for(i = 0; i < length; i++) {
+			base[i] = *((G2 *) a[i]);
+#if BUILD_BN_CURVE == 1
+			base[i].g.norm();
+#endif
+		}
+		G2 id;
+		G2 *z = new G2(multi_exp(length, base, exp, id));
+#if BUILD_BN_CURVE == 1
+		z->g.norm();
+#endif
+		result = (element_t *) z;
+		delete [] base;
+	}
+#endif
+	else if(type == pyGT_t) {
+		GT *base = new GT[length];
+		for(i = 0; i < length; i++) base[i] = *((GT *) a[i]);
+		GT id;
+		id.g = 1;
+		result = (element_t *) new GT(multi_exp(length, base, exp, id));
+		delete [] base;
+	}
+
+	delete [] exp;
+	return result;
+}
+
+/* b[i] = 1 / a[i] mod o using a single inversion and 3(n-1) multiplications (Montgomery's trick).
+   b[i] must be allocated ZR elements. Returns FALSE (b untouched) if some a[i] is zero mod o. */
+int _element_batch_inv(element_t **a, element_t **b, int length, const element_t *o)
+{
+	if(length <= 0) { return FALSE; }
+	Big *order = (Big *) o;
+	Big *x = new Big[length];
+	Big *prefix = new Big[length];
+	Big acc = 1;
+	int i;
+
+	for(i = 0; i < length; i++) {
+		x[i] = *((Big *) a[i]) % *order;
+		if(x[i] < 0) x[i] += *order;
+		if(x[i].iszero()) {
+			delete [] x;
+			delete [] prefix;
+			return FALSE;
+		}
+		prefix[i] = acc;	// a[0] * ... * a[i-1]
+		acc = modmult(acc, x[i], *order);
+	}
+
+	acc = inverse(acc, *order);
+	for(i = length - 1; i >= 0; i--) {
+		// acc = 1 / (a[0] * ... * a[i])
+		*((Big *) b[i]) = modmult(acc, prefix[i], *order);
+		acc = modmult(acc, x[i], *order);
+	}
+
+	delete [] x;
+	delete [] prefix;
+	return TRUE;
+}
+
 /* Does NOT perform any error checking */
 element_t *_element_prod_pairing(const pairing_t *pairing, const element_t **in1, const element_t **in2, int length)
 {
@@ -1522,6 +1705,234 @@ element_t *_element_from_bytes(Curve_t ctype, Group_t type, unsigned char *data)
 	return NULL;
 }
 
+/*
+ * Fixed-width binary codec: every coordinate of an element is written big-endian and zero
+ * padded to the byte length of the field modulus (of the group order for ZR), straight into
+ * the caller's buffer. G1 and G2 points start with a flag byte because the point at
+ * infinity has no affine coordinates: (0,0) is off the BN/MNT curves and a real point on SS.
+ */
+#define MAX_COORDS	12
+#define POINT_AFFINE	0x00
+#define POINT_INFINITY	0x01
+
+static int _element_flag_len(Group_t type)
+{
+	return (type == pyG1_t || type == pyG2_t) ? 1 : 0;
+}
+
+static int _element_is_infinity(Group_t type, element_t *e)
+{
+	if(type == pyG1_t) return ((G1 *) e)->g.iszero();
+#if ASYMMETRIC == 1
+	else if(type == pyG2_t) return ((G2 *) e)->g.iszero();
+#endif
+	return FALSE;
+}
+
+static int _element_num_coords(Curve_t ctype, Group_t type)
+{
+	if(type == pyZR_t) return 1;
+	else if(type == pyG1_t) return 2;
+#if ASYMMETRIC == 1
+	else if(type == pyG2_t) {
+#if BUILD_MNT_CURVE == 1
+		return 6;
+#else
+		return 4;
+#endif
+	}
+#endif
+	else if(type == pyGT_t) {
+#if BUILD_MNT_CURVE == 1
+		return 6;
+#elif BUILD_BN_CURVE == 1
+		return 12;
+#else
+		return 2;
+#endif
+	}
+	return 0;
+}
+
+static int _element_coord_len(const pairing_t *pairing, Group_t type)
+{
+	if(type == pyZR_t) {
+		PFC *pfc = (PFC *) pairing;
+		return (bits(pfc->order()) + 7) / 8;
+	}
+	return (bits(get_modulus()) + 7) / 8;
+}
+
+static void _element_get_coords(Curve_t ctype, Group_t type, element_t *e, Big *a)
+{
+	if(type == pyZR_t) {
+		a[0] = *((Big *) e);
+	}
+	else if(type == pyG1_t) {
+		G1 *p = (G1 *) e;
+		p->g.get(a[0], a[1]);
+	}
+#if ASYMMETRIC == 1
+	else if(type == pyG2_t) {
+		G2 *P = (G2 *) e;
+#if BUILD_MNT_CURVE == 1
+		ZZn3 x, y;
+		ZZn b[6];
+		P->g.get(x, y);
+		x.get(b[0], b[1], b[2]);
+		y.get(b[3], b[4], b[5]);
+		for(int i = 0; i < 6; i++) a[i] = Big(b[i]);
+#elif BUILD_BN_CURVE == 1
+		ZZn2 x, y;
+		P->g.get(x, y);
+		x.get(a[0], a[1]);
+		y.get(a[2], a[3]);
+#endif
+	}
+#endif
+	else if(type == pyGT_t) {
+		GT *P = (GT *) e;
+#if BUILD_MNT_CURVE == 1
+		ZZn2 x, y, z;
+		P->g.get(x, y, z);
+		x.get(a[0], a[1]);
+		y.get(a[2], a[3]);
+		z.get(a[4], a[5]);
+#elif BUILD_BN_CURVE == 1
+		ZZn4 x, y, z;
+		ZZn2 x0, x1, y0, y1, z0, z1;
+		P->g.get(x, y, z);
+		x.get(x0, x1);
+		y.get(y0, y1);
+		z.get(z0, z1);
+		x0.get(a[0], a[1]);
+		x1.get(a[2], a[3]);
+		y0.get(a[4], a[5]);
+		y1.get(a[6], a[7]);
+		z0.get(a[8], a[9]);
+		z1.get(a[10], a[11]);
+#elif BUILD_SS_CURVE == 1
+		P->g.get(a[0], a[1]);
+#endif
+	}
+}
+
+/* returns NULL when the coordinates don't describe a valid point */
+static element_t *_element_set_coords(const pairing_t *pairing, Curve_t ctype, Group_t type, Big *a)
+{
+	if(type == pyZR_t) {
+		PFC *pfc = (PFC *) pairing;
+		if(a[0] >= pfc->order()) return NULL;
+		return (element_t *) new Big(a[0]);
+	}
+	else if(type == pyG1_t) {
+		G1 *p = new G1();
+		if(!p->g.set(a[0], a[1])) { delete p; return NULL; }
+		return (element_t *) p;
+	}
+#if ASYMMETRIC == 1
+	else if(type == pyG2_t) {
+		G2 *P = new G2();
+#if BUILD_MNT_CURVE == 1
+		ZZn3 x(ZZn(a[0]), ZZn(a[1]), ZZn(a[2]));
+		ZZn3 y(ZZn(a[3]), ZZn(a[4]), ZZn(a[5]));
+#elif BUILD_BN_CURVE == 1
+		ZZn2 x(a[0], a[1]);
+		ZZn2 y(a[2], a[3]);
+#endif
+		if(!P->g.set(x, y)) { delete P; return NULL; }
+		return (element_t *) P;
+	}
+#endif
+	else if(type == pyGT_t) {
+		GT *P = new GT();
+#if BUILD_MNT_CURVE == 1
+		ZZn2 x, y, z;
+		x.set(a[0], a[1]);
+		y.set(a[2], a[3]);
+		z.set(a[4], a[5]);
+		P->g.set(x, y, z);
+#elif BUILD_BN_CURVE == 1
+		ZZn2 x0, x1, y0, y1, z0, z1;
+		x0.set(a[0], a[1]);
+		x1.set(a[2], a[3]);
+		y0.set(a[4], a[5]);
+		y1.set(a[6], a[7]);
+		z0.set(a[8], a[9]);
+		z1.set(a[10], a[11]);
+		ZZn4 x(x0, x1);
+		ZZn4 y(y0, y1);
+		ZZn4 z(z0, z1);
+		P->g.set(x, y, z);
+#elif BUILD_SS_CURVE == 1
+		P->g.set(a[0], a[1]);
+#endif
+		return (element_t *) P;
+	}
+	return NULL;
+}
+
+int _element_length_in_bytes_raw(const pairing_t *pairing, Curve_t ctype, Group_t type)
+{
+	int n = _element_num_coords(ctype, type);
+	if(n == 0) return 0;
+	return _element_flag_len(type) + n * _element_coord_len(pairing, type);
+}
+
+int _element_to_bytes_raw(unsigned char *data, int data_len, const pairing_t *pairing, Curve_t ctype, Group_t type, element_t *e)
+{
+	int n = _element_num_coords(ctype, type), w = _element_coord_len(pairing, type), f = _element_flag_len(type);
+	if(n == 0 || data_len < f + n * w) return 0;
+
+	if(f) {
+		if(_element_is_infinity(type, e)) {
+			data[0] = POINT_INFINITY;
+			memset(data + 1, 0, n * w);
+			return f + n * w;
+		}
+		data[0] = POINT_AFFINE;
+		data += f;
+	}
+
+	Big a[MAX_COORDS];
+	_element_get_coords(ctype, type, e, a);
+	if(type == pyZR_t) {
+		PFC *pfc = (PFC *) pairing;
+		a[0] %= pfc->order();
+		if(a[0] < 0) a[0] += pfc->order();
+	}
+
+	for(int i = 0; i < n; i++) {
+		to_binary(a[i], w, (char *) (data + i * w), TRUE);
+	}
+	return f + n * w;
+}
+
+element_t *_element_from_bytes_raw(const pairing_t *pairing, Curve_t ctype, Group_t type, unsigned char *data, int data_len)
+{
+	int n = _element_num_coords(ctype, type), w = _element_coord_len(pairing, type), f = _element_flag_len(type);
+	if(n == 0 || data_len != f + n * w) return NULL;
+
+	if(f) {
+		if(data[0] == POINT_INFINITY) {
+			// a single canonical encoding: the coordinates must be zero
+			for(int i = 1; i < data_len; i++) {
+				if(data[i] != 0) return NULL;
+			}
+			if(type == pyG1_t) return _element_init_G1();
+			return _element_init_G2();
+		}
+		if(data[0] != POINT_AFFINE) return NULL;
+		data += f;
+	}
+
+	Big a[MAX_COORDS];
+	for(int i = 0; i < n; i++) {
+		a[i] = from_binary(w, (char *) (data + i * w));
+	}
+	return _element_set_coords(pairing, ctype, type, a);
+}
+
 void element_delete(Group_t type, element_t *e) {
 
 	if(type == pyZR_t) {
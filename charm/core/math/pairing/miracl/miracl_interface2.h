@@ -65,7 +65,11 @@ element_t *_element_init_G1(void);
 element_t *_element_init_G2(void);
 element_t *_element_init_GT(const pairing_t *pairing);
 int _element_pp_init(const pairing_t *pairing, Group_t type, element_t *e);
-void element_random(Group_t type, const pairing_t *pairing, element_t *e);
+// keeps the Miller loop lines of a fixed pairing argument (G2) with the element
+int _element_pp_init_pairing(const pairing_t *pairing, Group_t type, element_t *e);
+int _element_has_pp_pairing(Group_t type, const element_t *e);
+// FALSE if the generator failed or the type can't be drawn directly
+int element_random(Group_t type, const pairing_t *pairing, element_t *e);
 void element_printf(Group_t type, const element_t *e);
 int _element_length_to_str(Group_t type, const element_t *e);
 int _element_to_str(unsigned char **data_str, Group_t type, const element_t *e);
@@ -80,6 +84,10 @@ void _element_div(Group_t type, element_t *c, const element_t *a, const element_
 // c = a (G1, G2 or GT) ^ b (ZR)
 element_t *_element_pow_zr(Group_t type, const pairing_t *pairing, element_t *a, element_t *b, element_t *o);
 //element_t *_element_pow_zr(Group_t type, const pairing_t *pairing, const element_t *a, const element_t *b, const element_t *o);
+// c = a[0] ^ b[0] * ... * a[n-1] ^ b[n-1] (a in G1, G2 or GT, b in ZR)
+element_t *_element_multi_pow(Group_t type, const pairing_t *pairing, element_t **a, element_t **b, int length, const element_t *o);
+// b[i] = 1 / a[i] for n ZR elements with a single inversion, FALSE if any a[i] = 0
+int _element_batch_inv(element_t **a, element_t **b, int length, const element_t *o);
 element_t *_element_pow_zr_zr(Group_t type, const pairing_t *pairing, const element_t *a, const int b, const element_t *o);
 element_t *_element_neg(Group_t type, const element_t *e, const element_t *o);
 //void _element_inv(Group_t type, const element_t *a, element_t *b, element_t *o);
@@ -106,6 +114,10 @@ element_t *_element_prod_pairing(const pairing_t *pairing, const element_t **in1
 int _element_length_in_bytes(Curve_t ctype, Group_t type, element_t *e);
 int _element_to_bytes(unsigned char *data, Curve_t ctype, Group_t type, element_t *e);
 element_t *_element_from_bytes(Curve_t ctype, Group_t type, unsigned char *data);
+// fixed-width binary encoding written directly into the caller's buffer
+int _element_length_in_bytes_raw(const pairing_t *pairing, Curve_t ctype, Group_t type);
+int _element_to_bytes_raw(unsigned char *data, int data_len, const pairing_t *pairing, Curve_t ctype, Group_t type, element_t *e);
+element_t *_element_from_bytes_raw(const pairing_t *pairing, Curve_t ctype, Group_t type, unsigned char *data, int data_len);
 // I/O functiond end
 
 void element_delete(Group_t type, element_t *e);
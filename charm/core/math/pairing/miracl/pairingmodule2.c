@@ -445,25 +445,16 @@ int Pairing_init(Pairing *self, PyObject *args, PyObject *kwds)
         return -1; 
 	}
 
-    if(aes_sec != -1) {
-    	if(aes_sec == MNT160) {
-			self->pair_obj = pairing_init(aes_sec);
-			self->order    = order(self->pair_obj);
-			self->curve	  = MNT; // only supported at this point
-			pairing_init_finished 	  = FALSE;
-    	}
-    	else if(aes_sec == BN256) {
-			self->pair_obj = pairing_init(aes_sec);
-			self->order    = order(self->pair_obj);
-			self->curve	  = BN; // only supported at this point
-			pairing_init_finished 	  = FALSE;
-    	}
-    	else if(aes_sec == SS512) {
-			self->pair_obj = pairing_init(aes_sec);
-			self->order    = order(self->pair_obj);
-			self->curve	  = SS; // only supported at this point
-			pairing_init_finished 	  = FALSE;
-    	}
+    if(aes_sec == MNT160 || aes_sec == BN256 || aes_sec == SS512) {
+		self->pair_obj = pairing_init(aes_sec);
+		if(self->pair_obj == NULL) {
+			PyErr_SetString(ElementError, "failed to seed the random generator.");
+			return -1;
+		}
+		self->order    = order(self->pair_obj);
+		// only one curve of each family is supported at this point
+		self->curve	  = (aes_sec == MNT160) ? MNT : ((aes_sec == BN256) ? BN : SS);
+		pairing_init_finished 	  = FALSE;
     }
 
     self->group_init = TRUE;
@@ -593,7 +584,13 @@ static PyObject *Element_random(Element* self, PyObject* args)
 //		pbc_random_set_deterministic((uint32_t) seed);
 	}
 	/* create new Element object */
-    element_random(retObject->element_type, group->pair_obj, retObject->e);
+    if(!element_random(retObject->element_type, group->pair_obj, retObject->e)) {
+    	element_delete(retObject->element_type, retObject->e);
+    	retObject->elem_initialized = FALSE;
+    	Py_DECREF(retObject);
+    	PyErr_SetString(ElementError, "failed to seed the random generator.");
+    	return NULL;
+    }
 
 	retObject->elem_initialized = TRUE;
 	retObject->elem_initPP = FALSE;
@@ -1031,6 +1028,11 @@ static PyObject  *Element_initPP(Element *self, PyObject *args)
     	int result;
     	element_pp_init(result, self);
     	if(result == FALSE) { Py_RETURN_FALSE; }
+    	if(self->element_type == pyG2_t) {
+    		/* G2 elements are usually a fixed pairing argument (e.g. the generator in BLS verification) */
+    		element_pp_init_pairing(result, self);
+    		if(result == FALSE) { Py_RETURN_FALSE; }
+    	}
 		self->elem_initPP = TRUE;
 		Py_RETURN_TRUE;
     }
@@ -1053,6 +1055,7 @@ PyObject *multi_pairing_asymmetric(Pairing *groupObj, PyObject *listG1, PyObject
 
 		element_t *g1[length];
 		element_t *g2[length];
+		int g2_copy[length];
 		int i, l = 0, r = 0;
 
 		for(i = 0; i < length; i++) {
@@ -1068,8 +1071,16 @@ PyObject *multi_pairing_asymmetric(Pairing *groupObj, PyObject *listG1, PyObject
 					l++;
 				}
 				if(tmp2->element_type == pyG2_t) {
- 					g2[r] = element_init_G2();
-					element_set_raw(groupObj, pyG2_t, g2[r], tmp2->e);
+					if(_element_has_pp_pairing(pyG2_t, tmp2->e)) {
+						/* a copy would drop the precomputed lines, the list keeps tmp2 alive */
+						g2[r] = tmp2->e;
+						g2_copy[r] = FALSE;
+					}
+					else {
+						g2[r] = element_init_G2();
+						element_set_raw(groupObj, pyG2_t, g2[r], tmp2->e);
+						g2_copy[r] = TRUE;
+					}
 					r++;
 				}
 			}
@@ -1088,7 +1099,7 @@ PyObject *multi_pairing_asymmetric(Pairing *groupObj, PyObject *listG1, PyObject
 
 		/* clean up */
 		for(i = 0; i < l; i++) { element_delete(pyG1_t, g1[i]); }
-		for(i = 0; i < r; i++) { element_delete(pyG2_t, g2[i]); }
+		for(i = 0; i < r; i++) { if(g2_copy[i]) element_delete(pyG2_t, g2[i]); }
 		return (PyObject *) newObject;
 	}
 
@@ -1140,6 +1151,144 @@ PyObject *Apply_pairing(Element *self, PyObject *args)
 	return NULL;
 }
 
+/* computes prod(bases[i] ^ exps[i]) over G1, G2 or GT with a single interleaved
+   window pass rather than one exponentiation per base. Zero digits are skipped, so
+   the running time depends on the exponents: only use it with public ones. */
+static PyObject *Element_multiexp(Element *self, PyObject *args)
+{
+	Pairing *group = NULL;
+	PyObject *bases = NULL, *exps = NULL;
+
+	if(!PyArg_ParseTuple(args, "OOO", &group, &bases, &exps)) {
+		PyErr_SetString(ElementError, "invalid arguments: group, list of bases, list of exponents");
+		return NULL;
+	}
+	VERIFY_GROUP(group);
+	EXIT_IF(!PySequence_Check(bases) || !PySequence_Check(exps), "bases and exponents must be lists.");
+
+	int length = PySequence_Length(bases);
+	EXIT_IF(length <= 0, "list is empty.");
+	EXIT_IF(length != PySequence_Length(exps), "unequal number of bases and exponents.");
+
+	// sized by the caller's list, so kept off the stack
+	element_t **a = (element_t **) malloc(length * sizeof(element_t *));
+	element_t **b = (element_t **) malloc(length * sizeof(element_t *));
+	Element **zr = (Element **) calloc(length, sizeof(Element *));
+	Group_t type = NONE_G;
+	int i, valid = TRUE;
+
+	if(a == NULL || b == NULL || zr == NULL) {
+		free(a);
+		free(b);
+		free(zr);
+		return PyErr_NoMemory();
+	}
+
+	for(i = 0; i < length; i++) {
+		PyObject *base = PySequence_GetItem(bases, i);
+		PyObject *exp  = PySequence_GetItem(exps, i);
+		zr[i] = NULL;
+
+		if(base == NULL || exp == NULL || !PyElement_Check(base) || ((Element *) base)->element_type == pyZR_t ||
+		   (type != NONE_G && ((Element *) base)->element_type != type)) {
+			valid = FALSE;
+		}
+		else {
+			type = ((Element *) base)->element_type;
+			a[i] = ((Element *) base)->e;
+			if(PyElement_Check(exp) && ((Element *) exp)->element_type == pyZR_t) {
+				b[i] = ((Element *) exp)->e;
+			}
+			else if(_PyLong_Check(exp)) {
+				zr[i] = convertToZR(exp, base);
+				b[i] = zr[i]->e;
+			}
+			else {
+				valid = FALSE;
+			}
+		}
+		/* both sequences keep the items alive until we return */
+		Py_XDECREF(base);
+		Py_XDECREF(exp);
+		if(!valid) { length = i + 1; break; }
+	}
+
+	Element *newObject = NULL;
+	if(valid) {
+		newObject = createNewElement(NONE_G, group);
+		element_multi_pow(newObject, type, a, b, length);
+		if(newObject->e == NULL) {
+			// nothing to free in dealloc besides the group reference
+			newObject->elem_initialized = FALSE;
+			Py_DECREF(newObject->pairing);
+			Py_DECREF(newObject);
+			newObject = NULL;
+			PyErr_SetString(ElementError, "multi-exponentiation is not supported for this group.");
+		}
+#ifdef BENCHMARK_ENABLED
+		else {
+			UPDATE_BENCH(EXPONENTIATION, newObject->element_type, newObject->pairing);
+		}
+#endif
+	}
+	else {
+		PyErr_SetString(ElementError, "bases must all be G1, G2 or GT elements and exponents ZR elements or integers.");
+	}
+
+	for(i = 0; i < length; i++) { if(zr[i] != NULL) Py_DECREF(zr[i]); }
+	free(a);
+	free(b);
+	free(zr);
+	return (PyObject *) newObject;
+}
+
+/* inverts a list of ZR elements at the cost of one inversion plus a few multiplications each */
+static PyObject *Element_batch_invert(Element *self, PyObject *args)
+{
+	Pairing *group = NULL;
+	PyObject *elems = NULL;
+
+	if(!PyArg_ParseTuple(args, "OO", &group, &elems)) {
+		PyErr_SetString(ElementError, "invalid arguments: group, list of ZR elements");
+		return NULL;
+	}
+	VERIFY_GROUP(group);
+	EXIT_IF(!PySequence_Check(elems), "expected a list of ZR elements.");
+
+	int length = PySequence_Length(elems);
+	EXIT_IF(length < 0, "expected a list of ZR elements.");
+	PyObject *result = PyList_New(length);
+	if(result == NULL || length == 0) return result;
+
+	element_t *a[length];
+	element_t *b[length];
+	int i;
+
+	for(i = 0; i < length; i++) {
+		PyObject *item = PySequence_GetItem(elems, i);
+		int valid = PyElement_Check(item) && ((Element *) item)->element_type == pyZR_t;
+		if(valid) a[i] = ((Element *) item)->e;
+		/* the sequence keeps the item alive until we return */
+		Py_DECREF(item);
+		if(!valid) {
+			Py_DECREF(result);
+			EXIT_IF(TRUE, "can only invert a list of ZR elements.");
+		}
+		Element *inv = createNewElement(pyZR_t, group);
+		b[i] = inv->e;
+		PyList_SET_ITEM(result, i, (PyObject *) inv);
+	}
+
+	if(!element_batch_invert(group, a, b, length)) {
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "divide by zero error!");
+	}
+#ifdef BENCHMARK_ENABLED
+	UPDATE_BENCH(DIVISION, pyZR_t, group);
+#endif
+	return result;
+}
+
 PyObject *sha2_hash(Element *self, PyObject *args) {
 	Element *object;
 	PyObject *str;
@@ -1439,7 +1588,12 @@ BINARY(instance_sub, 's', Element_sub)
 static PyObject *Serialize_cmp(Element *o1, PyObject *args) {
 
 	Element *self = NULL;
-	if(!PyArg_ParseTuple(args, "O", &self)) {
+	int compression = 1; // accepted for API compatibility; MIRACL elements have a single encoding
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+	if(!PyArg_ParseTuple(args, "O|p", &self, &compression)) {
+#else
+	if(!PyArg_ParseTuple(args, "O|i", &self, &compression)) {
+#endif
 		PyErr_SetString(ElementError, "invalid argument.");
 		return NULL;
 	}
@@ -1452,42 +1606,30 @@ static PyObject *Serialize_cmp(Element *o1, PyObject *args) {
 		PyErr_SetString(ElementError, "element not initialized.");
 		return NULL;
 	}
+	if(check_type(self->element_type) == FALSE) {
+		PyErr_SetString(ElementError, "invalid type.\n");
+		return NULL;
+	}
 
-	int elem_len = 0;
-	uint8_t *data_buf = NULL;
-	size_t bytes_written;
-
-
-//	printf("element type => '%d'\n", self->element_type);
-//	print("test output => ", self->element_type, self->e);
-	if(check_type(self->element_type) == TRUE) {
-		// determine size of buffer we need to allocate
-		elem_len = element_length_in_bytes(self);
-		data_buf = (uint8_t *) malloc(elem_len + 1);
-		memset(data_buf, 0, elem_len);
-		if(data_buf == NULL) {
-			PyErr_SetString(ElementError, "out of memory.");
-			return NULL;
-		}
+	// fixed-width binary encoding, written in place
+	int elem_len = element_length_in_bytes_raw(self);
+	EXIT_IF(elem_len <= 0, "uninitialized element.");
+	uint8_t data_buf[elem_len + 1];
+	memset(data_buf, 0, elem_len + 1);
 
-		// write to char buffer
-		bytes_written = element_to_bytes(data_buf, self);
-		if(elem_len != bytes_written) {
-			PyErr_SetString(ElementError, "serialization failed. try again.");
-			free(data_buf);
-			return NULL;
-		}
-		debug("result => ");
-		printf_buffer_as_hex(data_buf, bytes_written);
-	}
-	else {
-		PyErr_SetString(ElementError, "invalid type.\n");
+	int bytes_written = element_to_bytes_raw(data_buf, elem_len, self);
+	if(elem_len != bytes_written) {
+		PyErr_SetString(ElementError, "serialization failed. try again.");
 		return NULL;
 	}
+	debug("result => ");
+	printf_buffer_as_hex(data_buf, bytes_written);
 
-	PyObject *result = PyBytes_FromFormat("%d:%s", self->element_type, (const char *) data_buf);
-	debug("enc => '%s'\n", data_buf);
-	free(data_buf);
+	size_t length = 0;
+	char *base64_data_buf = NewBase64Encode(data_buf, elem_len, FALSE, &length);
+	PyObject *result = PyBytes_FromFormat("%d:%s", self->element_type, (const char *) base64_data_buf);
+	debug("enc => '%s'\n", base64_data_buf);
+	free(base64_data_buf);
 
 	return result;
 }
@@ -1496,23 +1638,42 @@ static PyObject *Deserialize_cmp(Element *self, PyObject *args) {
 	Element *origObject = NULL;
 	Pairing *group = NULL;
 	PyObject *object;
+	int compression = 1;
 
-	if(PyArg_ParseTuple(args, "OO", &group, &object)) {
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+	if(PyArg_ParseTuple(args, "OO|p", &group, &object, &compression)) {
+#else
+	if(PyArg_ParseTuple(args, "OO|i", &group, &object, &compression)) {
+#endif
 		VERIFY_GROUP(group);
 		if(PyBytes_Check(object)) {
 			uint8_t *serial_buf = (uint8_t *) PyBytes_AsString(object);
 			int type = atoi((const char *) &(serial_buf[0]));
 			uint8_t *base64_buf = (uint8_t *)(serial_buf + 2);
-//			printf("type => %d\n", type);
-//			printf("base64 dec => '%s'\n", base64_buf);
 
 			if(check_type(type) == TRUE && strlen((char *) base64_buf) > 0) {
-//				debug("result => ");
-//				printf_buffer_as_hex(binary_buf, deserialized_len);
 				origObject = createNewElement(NONE_G, group);
 				origObject->element_type = type;
-				element_from_bytes(origObject, base64_buf);
 
+				size_t deserialized_len = 0;
+				uint8_t *binary_buf = NewBase64Decode((const char *) base64_buf, strlen((char *) base64_buf), &deserialized_len);
+				if(binary_buf != NULL && deserialized_len == (size_t) element_length_in_bytes_raw(origObject)) {
+					element_from_bytes_raw(origObject, binary_buf, (int) deserialized_len);
+				}
+				else {
+					// older releases wrote length-prefixed coordinates
+					element_from_bytes(origObject, base64_buf);
+				}
+				if(binary_buf != NULL) free(binary_buf);
+
+				if(origObject->e == NULL) {
+					// nothing to free in dealloc besides the group reference
+					origObject->elem_initialized = FALSE;
+					Py_DECREF(origObject->pairing);
+					Py_DECREF(origObject);
+					PyErr_SetString(ElementError, "invalid element encoding.");
+					return NULL;
+				}
 				return (PyObject *) origObject;
 			}
 		}
@@ -1952,6 +2113,8 @@ PyMethodDef pairing_methods[] = {
 
 	{"pair", (PyCFunction)Apply_pairing, METH_VARARGS, "Apply pairing between an element of G1_t and G2 and returns an element mapped to GT"},
 	{"hashPair", (PyCFunction)sha2_hash, METH_VARARGS, "Compute a sha1 hash of an element type"},
+	{"multiexp", (PyCFunction)Element_multiexp, METH_VARARGS, "Compute the product of bases[i] ^ exps[i] over G1, G2 or GT"},
+	{"batch_invert", (PyCFunction)Element_batch_invert, METH_VARARGS, "Invert a list of ZR elements with a single modular inversion"},
 //	{"SymEnc", (PyCFunction) AES_Encrypt, METH_VARARGS, "AES encryption args: key (bytes or str), message (str)"},
 //	{"SymDec", (PyCFunction) AES_Decrypt, METH_VARARGS, "AES decryption args: key (bytes or str), ciphertext (str)"},
 #ifdef BENCHMARK_ENABLED
@@ -2053,6 +2216,14 @@ void initpairing(void) 		{
 	PyModule_AddIntConstant(m, "BN256", BN256);
 	PyModule_AddIntConstant(m, "SS512", SS512);
 	PyModule_AddIntConstant(m, "SS1536", SS1536);
+	// the one curve this extension was compiled for
+#if BUILD_MNT_CURVE == 1
+	PyModule_AddStringConstant(m, "curve", "MNT160");
+#elif BUILD_BN_CURVE == 1
+	PyModule_AddStringConstant(m, "curve", "BN256");
+#else
+	PyModule_AddStringConstant(m, "curve", "SS512");
+#endif
 
 LEAVE:
     if (PyErr_Occurred()) {
@@ -50,6 +50,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include "benchmarkmodule.h"
+#include "base64.h"
 #include "openssl/objects.h"
 #include "openssl/rand.h"
 #include "openssl/sha.h"
@@ -184,6 +185,16 @@ typedef struct {
 #define element_pp_init(b, a) \
 		b = _element_pp_init(a->pairing->pair_obj, a->element_type, a->e)
 
+#define element_multi_pow(c, t, a, b, l) \
+	c->e = _element_multi_pow(t, c->pairing->pair_obj, a, b, l, c->pairing->order);	\
+	c->element_type = t;
+
+#define element_batch_invert(g, a, b, l) \
+	_element_batch_inv(a, b, l, g->order)
+
+#define element_pp_init_pairing(b, a) \
+		b = _element_pp_init_pairing(a->pairing->pair_obj, a->element_type, a->e)
+
 #define pairing_apply(c, a, b) \
 	if(a->pairing->curve == MNT || a->pairing->curve == BN || a->pairing->curve == SS) { \
 		c->e = _element_pairing(a->pairing->pair_obj, a->e, b->e); \
@@ -210,6 +221,15 @@ typedef struct {
 #define element_from_bytes(o, b)   \
 	o->e = _element_from_bytes(o->pairing->curve, o->element_type, b);
 
+#define element_length_in_bytes_raw(a)  \
+	_element_length_in_bytes_raw(a->pairing->pair_obj, a->pairing->curve, a->element_type);
+
+#define element_to_bytes_raw(d, l, a)	\
+	_element_to_bytes_raw(d, l, a->pairing->pair_obj, a->pairing->curve, a->element_type, a->e);
+
+#define element_from_bytes_raw(o, b, l)   \
+	o->e = _element_from_bytes_raw(o->pairing->pair_obj, o->pairing->curve, o->element_type, b, l);
+
 #define element_cmp(a, b) _element_cmp(a->element_type, a->e, b->e);
 #define element_length_to_str(a) _element_length_to_str(a->element_type, a->e);
 #define element_to_str(d, a)  _element_to_str(d, a->element_type, a->e);
@@ -45,6 +45,7 @@
 #include <fcntl.h>
 #include "benchmarkmodule.h"
 #include "base64.h"
+#include "drbg.h"
 #include <openssl/objects.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
@@ -12,7 +12,7 @@ my_relic_inc=include
 
 
 # build using GMP backend and link statically 
-cmake -DVERBS=off -DDEBUG=off -DTRACE=off -DSHLIB=on -DWITH="ALL" -DCHECK=off -DARITH=gmp -DBENCH=0 -DTESTS=0 -DSTBIN=off -DFP_METHD="BASIC;COMBA;COMBA;MONTY;LOWER;MONTY" -DFP_QNRES=off -DEC_METHD="PRIME" -DPC_METHD="PRIME" -DEP_METHD="BASIC;LWNAF;COMBS;INTER" -DPP_METHD="INTEG;INTEG;LAZYR;OATEP" -DFP_PRIME=256 -DEP_KBLTZ=on -DALLOC=DYNAMIC -DBN_PRECI=256 -DCOMP="-O2 -funroll-loops -fomit-frame-pointer" $path_to_relic/
+cmake -DVERBS=off -DDEBUG=off -DTRACE=off -DSHLIB=on -DWITH="ALL" -DCHECK=off -DARITH=gmp -DBENCH=0 -DTESTS=0 -DSTBIN=off -DFP_METHD="BASIC;COMBA;COMBA;MONTY;LOWER;MONTY" -DFP_QNRES=off -DEC_METHD="PRIME" -DPC_METHD="PRIME" -DEP_METHD="BASIC;LWNAF;COMBS;INTER" -DPP_METHD="INTEG;INTEG;LAZYR;OATEP" -DFP_PRIME=256 -DEP_KBLTZ=on -DALLOC=DYNAMIC -DBN_PRECI=256 -DRAND=CALL -DCOMP="-O2 -funroll-loops -fomit-frame-pointer" $path_to_relic/
 
 make
 install -d $path_to_inc
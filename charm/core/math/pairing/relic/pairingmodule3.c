@@ -89,6 +89,7 @@ static PyObject *f(PyObject *v) { \
 static PyObject *f(PyObject *v, PyObject *w) { \
 	Element *obj1 = NULL, *obj2 = NULL;			\
 	int obj1_long = FALSE, obj2_long = FALSE; 	\
+	RELIC_CTX_CHECK();							\
 	debug("Performing the '%s' operation.\n", __func__); \
 	if(PyElement_Check(v)) {	\
 		obj1 = (Element *) v; } \
@@ -470,6 +471,7 @@ static PyObject *Element_elem(Element* self, PyObject* args)
 		EXIT_IF(TRUE, "invalid arguments.");
 	}
 	VERIFY_GROUP(group);
+	RELIC_CTX_CHECK();
 	
 	debug("init an element.\n");
 	if(type >= ZR && type <= GT) {
@@ -531,6 +533,7 @@ static PyObject *Element_random(Element* self, PyObject* args)
 		return NULL;
 
 	VERIFY_GROUP(group);
+	RELIC_CTX_CHECK();
 	retObject = PyObject_New(Element, &ElementType);
 	debug("init random element in '%d'\n", arg1);
 	if(arg1 == ZR) {
@@ -625,6 +628,7 @@ static PyObject *Element_mul(PyObject *lhs, PyObject *rhs)
 	integer_t z;
 	int found_int = FALSE;
 
+	RELIC_CTX_CHECK();
 	// lhs or rhs must be an element type
 	if(PyElement_Check(lhs)) {
 		self = (Element *) lhs;
@@ -650,7 +654,9 @@ static PyObject *Element_mul(PyObject *lhs, PyObject *rhs)
 
 		newObject = createNewElement(self->element_type, self->pairing);
 		// multiplication is commutative
+		RELIC_BEGIN_ALLOW_THREADS;
 		element_mul_int(newObject->e, self->e, z);
+		RELIC_END_ALLOW_THREADS;
 		bn_free(z);
 
 	}
@@ -659,7 +665,9 @@ static PyObject *Element_mul(PyObject *lhs, PyObject *rhs)
 
 		newObject = createNewElement(other->element_type, other->pairing);
 		// multiplication is commutative
+		RELIC_BEGIN_ALLOW_THREADS;
 		element_mul_int(newObject->e, other->e, z);
+		RELIC_END_ALLOW_THREADS;
 		bn_free(z);
 
 	}
@@ -670,12 +678,16 @@ static PyObject *Element_mul(PyObject *lhs, PyObject *rhs)
 
 		if(self->element_type != ZR && other->element_type == ZR) {
 			newObject = createNewElement(self->element_type, self->pairing);
+			RELIC_BEGIN_ALLOW_THREADS;
 			element_mul_zr(newObject->e, self->e, other->e);
+			RELIC_END_ALLOW_THREADS;
 
 		}
 		else if(other->element_type != ZR && self->element_type == ZR) {
 			newObject = createNewElement(other->element_type, self->pairing);
+			RELIC_BEGIN_ALLOW_THREADS;
 			element_mul_zr(newObject->e, other->e, self->e);
+			RELIC_END_ALLOW_THREADS;
 		}
 		else { // all other cases
 			newObject = createNewElement(self->element_type, self->pairing);
@@ -697,6 +709,7 @@ static PyObject *Element_div(PyObject *lhs, PyObject *rhs)
 	integer_t z;
 	int found_int = FALSE;
 
+	RELIC_CTX_CHECK();
 	// lhs or rhs must be an element type
 	if(PyElement_Check(lhs)) {
 		self = (Element *) lhs;
@@ -776,6 +789,7 @@ static PyObject *Element_invert(Element *self)
 {
 	Element *newObject = NULL;
 	
+	RELIC_CTX_CHECK();
 	debug("Starting '%s'\n", __func__);
 #ifdef DEBUG	
 	if(self->e) {
@@ -794,6 +808,7 @@ static PyObject *Element_negate(Element *self)
 {
 	Element *newObject = NULL;
 
+	RELIC_CTX_CHECK();
 	debug("Starting '%s'\n", __func__);
 #ifdef DEBUG
 	if(self->e) {
@@ -815,6 +830,7 @@ static PyObject *Element_pow(PyObject *o1, PyObject *o2, PyObject *o3)
 	int longFoundLHS = FALSE, longFoundRHS = FALSE;
 	integer_t n;
 
+	RELIC_CTX_CHECK();
 	Check_Types2(o1, o2, lhs_o1, rhs_o2, longFoundLHS, longFoundRHS);
 
 	if(longFoundLHS) {
@@ -847,12 +863,14 @@ static PyObject *Element_pow(PyObject *o1, PyObject *o2, PyObject *o3)
 			newObject = createNewElement(lhs_o1->element_type, lhs_o1->pairing);
 			bn_inits(n);
 			ConvertToInt2(n, o2);
+			RELIC_BEGIN_ALLOW_THREADS;
 			if(lhs_o1->elem_initPP == TRUE) {
 				element_pp_pow_int(newObject->e, lhs_o1->e_pp, lhs_o1->element_type, n);
 			}
 			else {
 				element_pow_int(newObject->e, lhs_o1->e, n);
 			}
+			RELIC_END_ALLOW_THREADS;
 			bn_free(n);
 		}
 		else if(rhs == -1) {
@@ -872,12 +890,14 @@ static PyObject *Element_pow(PyObject *o1, PyObject *o2, PyObject *o3)
 		if(rhs_o2->element_type == ZR) {
 
 			newObject = createNewElement(lhs_o1->element_type, lhs_o1->pairing);
+			RELIC_BEGIN_ALLOW_THREADS;
 			if(lhs_o1->elem_initPP == TRUE) {
 				element_pp_pow(newObject->e, lhs_o1->e_pp, lhs_o1->element_type, rhs_o2->e);
 			}
 			else {
 				element_pow_zr(newObject->e, lhs_o1->e, rhs_o2->e);
 			}
+			RELIC_END_ALLOW_THREADS;
 		}
 		else {
 			// we have a problem
@@ -906,6 +926,7 @@ static PyObject *Element_set(Element *self, PyObject *args)
     unsigned int value;
 
     EXITCODE_IF(self->elem_initialized == FALSE, "must initialize element to a field (G1,G2,GT, or Zr)", FALSE);
+    RELIC_CTX_CHECK();
 
     debug("Creating a new element\n");
     if(PyArg_ParseTuple(args, "i", &value)) {
@@ -931,6 +952,7 @@ static PyObject  *Element_initPP(Element *self, PyObject *args)
 {
     EXITCODE_IF(self->elem_initPP == TRUE, "initialized the pre-processing function already", FALSE);
     EXITCODE_IF(self->elem_initialized == FALSE, "must initialize element to a field (G1,G2, or GT)", FALSE);
+    RELIC_CTX_CHECK();
 
     /* initialize and store preprocessing information in e_pp */
     if(self->element_type >= G1 && self->element_type < GT) {
@@ -1026,6 +1048,7 @@ PyObject *Apply_pairing(Element *self, PyObject *args)
 	if(!PyArg_ParseTuple(args, "OO|O", &lhs2, &rhs2, &group)) {
 		EXIT_IF(TRUE, "invalid arguments: G1, G2, groupObject.");
 	}
+	RELIC_CTX_CHECK();
 
 //	if(PySequence_Check(lhs2) && PySequence_Check(rhs2)) {
 //		VERIFY_GROUP(group);
@@ -1044,12 +1067,14 @@ PyObject *Apply_pairing(Element *self, PyObject *args)
 			debug_e("RHS: '%B'\n", rhs->e);
 			//
 			newObject = createNewElement(GT, lhs->pairing);
+			RELIC_BEGIN_ALLOW_THREADS;
 			if(lhs->element_type == G1) {
 				pairing_apply(newObject->e, lhs->e, rhs->e);
 			}
 			else if(lhs->element_type == G2) {
 				pairing_apply(newObject->e, rhs->e, lhs->e);
 			}
+			RELIC_END_ALLOW_THREADS;
 			//
 #ifdef BENCHMARK_ENABLED
 			UPDATE_BENCHMARK(PAIRINGS, newObject->pairing->dBench);
@@ -1071,6 +1096,7 @@ PyObject *sha2_hash(Element *self, PyObject *args) {
 
 	if(!PyElement_Check(object)) EXIT_IF(TRUE, "not a valid element object.");
 	EXIT_IF(object->elem_initialized == FALSE, "null element object.");
+	RELIC_CTX_CHECK();
 	int hash_size = SHA_LEN;
 	uint8_t hash_buf[hash_size + 1];
 	memset(hash_buf, 0, hash_size);
@@ -1094,7 +1120,7 @@ PyObject *sha2_hash(Element *self, PyObject *args) {
 static PyObject *Element_hash(Element *self, PyObject *args) {
 	Element *newObject = NULL, *object = NULL;
 	Pairing *group = NULL;
-	PyObject *objList = NULL, *tmpObject = NULL, *tmp_obj = NULL;
+	PyObject *objList = NULL, *tmpObject = NULL, *tmp_obj = NULL, *dstObj = NULL;
 	// hashing element to Zr
 	uint8_t hash_buf[SHA_LEN+1];
 	memset(hash_buf, '\0', SHA_LEN);
@@ -1103,12 +1129,32 @@ static PyObject *Element_hash(Element *self, PyObject *args) {
 	char *tmp = NULL, *str;
 
 	// make sure args have the right type -- check that args contain a "string" and "string"
-	if(!PyArg_ParseTuple(args, "OO|i", &group, &objList, &type)) {
+	if(!PyArg_ParseTuple(args, "OO|iO", &group, &objList, &type, &dstObj)) {
 		tmp = "invalid object types";
 		goto cleanup;
 	}
 
 	VERIFY_GROUP(group);
+	RELIC_CTX_CHECK();
+	// a domain separation tag selects RFC 9380 hash-to-curve over the raw message bytes
+	if(dstObj != NULL) {
+		if(type != G1 && type != G2) {
+			tmp = "sswu hash-to-curve only applies to G1 or G2.";
+			goto cleanup;
+		}
+		if(!PyBytes_Check(objList) || !PyBytes_Check(dstObj)) {
+			tmp = "sswu hash-to-curve expects a bytes message and tag.";
+			goto cleanup;
+		}
+		newObject = createNewElement(type, group);
+		result = element_from_hash_dst(newObject->e, (uint8_t *) PyBytes_AS_STRING(objList), (int) PyBytes_GET_SIZE(objList),
+									   (uint8_t *) PyBytes_AS_STRING(dstObj), (int) PyBytes_GET_SIZE(dstObj));
+		if(result != ELEMENT_OK) {
+			tmp = "could not hash to curve.";
+			goto cleanup;
+		}
+		return (PyObject *) newObject;
+	}
 	// first case: is a string and type may or may not be set
 	if(PyBytes_CharmCheck(objList)) {
 		str = NULL;
@@ -1245,6 +1291,7 @@ static PyObject *Element_equals(PyObject *lhs, PyObject *rhs, int opid) {
 	int result = -1;
 
 	EXIT_IF(opid != Py_EQ && opid != Py_NE, "comparison supported: '==' or '!='");
+	RELIC_CTX_CHECK();
 	// check type of lhs & rhs
 	if(PyElement_Check(lhs) && PyElement_Check(rhs)) {
 		self = (Element *) lhs;
@@ -1280,6 +1327,7 @@ static PyObject *Element_equals(PyObject *lhs, PyObject *rhs, int opid) {
 }
 
 static PyObject *Element_long(PyObject *o1) {
+	RELIC_CTX_CHECK();
 	if(PyElement_Check(o1)) {
 		// finish this function
 		Element *value = (Element *) o1;
@@ -1298,6 +1346,10 @@ static PyObject *Element_long(PyObject *o1) {
 static long Element_index(Element *o1) {
 	long result = -1;
 
+	if(pairing_init_thread() != ELEMENT_OK) {
+		PyErr_SetString(ElementError, "could not initialize RELIC context for this thread.");
+		return result;
+	}
 	if(o1->element_type == ZR) {
 		integer_t o;
 		bn_inits(o);
@@ -1318,21 +1370,31 @@ BINARY(instance_sub, 's', Element_sub)
 static PyObject *Serialize_cmp(Element *o1, PyObject *args) {
 
 	Element *self = NULL;
-	EXIT_IF(!PyArg_ParseTuple(args, "O", &self), "invalid argument.");
+	int compression = 1;
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+	EXIT_IF(!PyArg_ParseTuple(args, "O|p", &self, &compression), "invalid argument.");
+#else
+	EXIT_IF(!PyArg_ParseTuple(args, "O|i", &self, &compression), "invalid argument.");
+#endif
 	if(!PyElement_Check(self)) EXIT_IF(TRUE, "not a valid element object.");
 	EXIT_IF(self->elem_initialized == FALSE, "element not initialized");
+	RELIC_CTX_CHECK();
 
 	int elem_len = 0;
+	status_t status;
 	EXIT_IF(check_type(self->element_type) == FALSE, "invalid type.");
 
-	// determine size of buffer we need to allocate
-	elem_len = element_length(self->e);
+	// determine size of buffer we need to allocate (only G1 and G2 have a compressed form)
+	if(compression) elem_len = element_length_compressed(self->e);
+	else elem_len = element_length(self->e);
 	EXIT_IF(elem_len == 0, "uninitialized element.");
 
 	uint8_t data_buf[elem_len + 1];
 	memset(data_buf, 0, elem_len);
 	// write to char buffer
-	element_to_bytes(data_buf, elem_len, self->e);
+	if(compression) status = element_to_bytes_compressed(data_buf, elem_len, self->e);
+	else status = element_to_bytes(data_buf, elem_len, self->e);
+	EXIT_IF(status != ELEMENT_OK, "could not serialize element.");
 	debug("result => ");
 	printf_buffer_as_hex(data_buf, elem_len);
 
@@ -1350,10 +1412,17 @@ static PyObject *Deserialize_cmp(Element *self, PyObject *args) {
 	Element *origObject = NULL;
 	Pairing *group = NULL;
 	PyObject *object;
+	int compression = 1;
+	status_t status;
 
-	if(PyArg_ParseTuple(args, "OO", &group, &object)) {
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+	if(PyArg_ParseTuple(args, "OO|p", &group, &object, &compression)) {
+#else
+	if(PyArg_ParseTuple(args, "OO|i", &group, &object, &compression)) {
+#endif
 
 		VERIFY_GROUP(group);
+		RELIC_CTX_CHECK();
 		if(PyBytes_Check(object)) {
 			uint8_t *serial_buf = (uint8_t *) PyBytes_AsString(object);
 			int type = atoi((const char *) &(serial_buf[0]));
@@ -1366,11 +1435,17 @@ static PyObject *Deserialize_cmp(Element *self, PyObject *args) {
 				debug("result => ");
 				printf_buffer_as_hex(binary_buf, deserialized_len);
 				origObject = createNewElement(type, group);
-				element_from_bytes(origObject->e, binary_buf, deserialized_len);
+				if(compression) status = element_from_bytes_compressed(origObject->e, binary_buf, deserialized_len);
+				else status = element_from_bytes(origObject->e, binary_buf, deserialized_len);
 				free(binary_buf);
+				if(status != ELEMENT_OK) {
+					Py_DECREF(origObject);
+					EXIT_IF(TRUE, "invalid element encoding.");
+				}
 
 				return (PyObject *) origObject;
 			}
+			if(binary_buf != NULL) free(binary_buf);
 		}
 		EXIT_IF(TRUE, "string object malformed.");
 	}
@@ -1378,12 +1453,160 @@ static PyObject *Deserialize_cmp(Element *self, PyObject *args) {
 	EXIT_IF(TRUE, "nothing to deserialize in element.");
 }
 
+/*
+ * Deserializes a list of serialized elements in one call. The bytes are parsed up front and
+ * each G1/G2 point is then decoded in turn outside of the GIL. Decompression is not batched:
+ * its cost is one field square root per point, an exponentiation that, unlike an inversion,
+ * cannot be shared between elements, and read points are already affine.
+ */
+static PyObject *Deserialize_list(Element *self, PyObject *args) {
+	Pairing *group = NULL;
+	PyObject *objList = NULL, *result = NULL, *item = NULL;
+	int compression = 1, i, n, failed = FALSE;
+	status_t status = ELEMENT_OK;
+
+#if PY_MAJOR_VERSION >= 3 && PY_MINOR_VERSION >= 3
+	EXIT_IF(!PyArg_ParseTuple(args, "OO|p", &group, &objList, &compression), "invalid arguments.");
+#else
+	EXIT_IF(!PyArg_ParseTuple(args, "OO|i", &group, &objList, &compression), "invalid arguments.");
+#endif
+	VERIFY_GROUP(group);
+	RELIC_CTX_CHECK();
+	EXIT_IF(!PySequence_Check(objList), "expected a list of serialized elements.");
+
+	n = (int) PySequence_Length(objList);
+	result = PyList_New(n);
+	if(result == NULL) return NULL;
+	if(n == 0) return result;
+
+	element_ptr *elems = (element_ptr *) malloc(n * sizeof(element_ptr));
+	uint8_t **bufs = (uint8_t **) calloc(n, sizeof(uint8_t *));
+	int *lens = (int *) malloc(n * sizeof(int));
+	if(elems == NULL || bufs == NULL || lens == NULL) {
+		failed = TRUE;
+		goto cleanup;
+	}
+
+	for(i = 0; i < n; i++) {
+		item = PySequence_GetItem(objList, i);
+		if(item == NULL || !PyBytes_Check(item)) {
+			Py_XDECREF(item);
+			failed = TRUE;
+			goto cleanup;
+		}
+		uint8_t *serial_buf = (uint8_t *) PyBytes_AsString(item);
+		int type = atoi((const char *) &(serial_buf[0]));
+		uint8_t *base64_buf = (uint8_t *)(serial_buf + 2);
+		size_t deserialized_len = 0;
+		bufs[i] = NewBase64Decode((const char *) base64_buf, strlen((char *) base64_buf), &deserialized_len);
+		Py_DECREF(item);
+
+		if(type < ZR || type > GT || deserialized_len == 0) {
+			failed = TRUE;
+			goto cleanup;
+		}
+		Element *elem = createNewElement(type, group);
+		PyList_SET_ITEM(result, i, (PyObject *) elem);
+		elems[i] = elem->e;
+		lens[i] = (int) deserialized_len;
+	}
+
+	RELIC_BEGIN_ALLOW_THREADS;
+	for(i = 0; i < n && status == ELEMENT_OK; i++) {
+		if(compression) status = element_from_bytes_compressed(elems[i], bufs[i], lens[i]);
+		else status = element_from_bytes(elems[i], bufs[i], lens[i]);
+	}
+	RELIC_END_ALLOW_THREADS;
+	if(status != ELEMENT_OK) failed = TRUE;
+
+cleanup:
+	if(bufs != NULL) {
+		for(i = 0; i < n; i++) {
+			if(bufs[i] != NULL) free(bufs[i]);
+		}
+		free(bufs);
+	}
+	if(elems != NULL) free(elems);
+	if(lens != NULL) free(lens);
+	if(failed) {
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "invalid element encoding in list.");
+	}
+	return result;
+}
+
+/* inverts a list of ZR elements with a single modular inversion */
+static PyObject *Element_batch_invert(Element *self, PyObject *args) {
+	Pairing *group = NULL;
+	PyObject *objList = NULL, *result = NULL, *item = NULL;
+	int i, n, failed = FALSE;
+	status_t status = ELEMENT_OK;
+
+	EXIT_IF(!PyArg_ParseTuple(args, "OO", &group, &objList), "invalid arguments.");
+	VERIFY_GROUP(group);
+	RELIC_CTX_CHECK();
+	EXIT_IF(!PySequence_Check(objList), "expected a list of ZR elements.");
+
+	n = (int) PySequence_Length(objList);
+	result = PyList_New(n);
+	if(result == NULL) return NULL;
+	if(n == 0) return result;
+
+	element_ptr *in = (element_ptr *) malloc(n * sizeof(element_ptr));
+	element_ptr *out = (element_ptr *) malloc(n * sizeof(element_ptr));
+	if(in == NULL || out == NULL) {
+		failed = TRUE;
+		goto cleanup;
+	}
+
+	for(i = 0; i < n; i++) {
+		item = PySequence_GetItem(objList, i);
+		if(item == NULL || !PyElement_Check(item) || ((Element *) item)->element_type != ZR) {
+			Py_XDECREF(item);
+			failed = TRUE;
+			goto cleanup;
+		}
+		/* the sequence keeps the item alive until we return */
+		in[i] = ((Element *) item)->e;
+		Py_DECREF(item);
+
+		Element *elem = createNewElement(ZR, group);
+		PyList_SET_ITEM(result, i, (PyObject *) elem);
+		out[i] = elem->e;
+	}
+
+	RELIC_BEGIN_ALLOW_THREADS;
+	status = element_invert_batch(out, in, n);
+	RELIC_END_ALLOW_THREADS;
+
+cleanup:
+	if(in != NULL) free(in);
+	if(out != NULL) free(out);
+	if(failed) {
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "can only invert a list of ZR elements.");
+	}
+	if(status == ELEMENT_DIV_ZERO) {
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "divide by zero error!");
+	}
+	else if(status != ELEMENT_OK) {
+		Py_DECREF(result);
+		EXIT_IF(TRUE, "could not invert the list of elements.");
+	}
+#ifdef BENCHMARK_ENABLED
+	UPDATE_BENCH(DIVISION, ZR, group);
+#endif
+	return result;
+}
+
 static PyObject *Group_Check(Element *self, PyObject *args) {
 
 	Pairing *group = NULL;
 	PyObject *object = NULL;
 	if(PyArg_ParseTuple(args, "OO", &group, &object)) {
 		VERIFY_GROUP(group); /* verify group object is still active */
+		RELIC_CTX_CHECK();
 		if(PyElement_Check(object)) {
 			Element *elem = (Element *) object;
 
@@ -1410,6 +1633,7 @@ static PyObject *Get_Order(Element *self, PyObject *args) {
 	EXIT_IF(!PyArg_ParseTuple(args, "O", &group), "invalid group object");
 
 	VERIFY_GROUP(group);
+	RELIC_CTX_CHECK();
 
 	integer_t x;
 	bn_inits(x);
@@ -1733,8 +1957,10 @@ PyMethodDef pairing_methods[] = {
 	{"random", (PyCFunction)Element_random, METH_VARARGS, "Return a random element in a specific group: G1, G2, Zr"},
 	{"serialize", (PyCFunction)Serialize_cmp, METH_VARARGS, "Serialize an element type into bytes."},
 	{"deserialize", (PyCFunction)Deserialize_cmp, METH_VARARGS, "De-serialize an bytes object into an element object"},
+	{"deserializeList", (PyCFunction)Deserialize_list, METH_VARARGS, "De-serialize a list of bytes objects into element objects"},
 	{"ismember", (PyCFunction) Group_Check, METH_VARARGS, "Group membership test for element objects."},
 	{"order", (PyCFunction) Get_Order, METH_VARARGS, "Get the group order for a particular field."},
+	{"batch_invert", (PyCFunction)Element_batch_invert, METH_VARARGS, "Invert a list of ZR elements with a single modular inversion"},
 #ifdef BENCHMARK_ENABLED
 	{"InitBenchmark", (PyCFunction)InitBenchmark, METH_VARARGS, "Initialize a benchmark object"},
 	{"StartBenchmark", (PyCFunction)StartBenchmark, METH_VARARGS, "Start a new benchmark with some options"},
@@ -213,6 +213,21 @@ int pair_rule(GroupType lhs, GroupType rhs);
 	PyErr_SetString(ElementError, msg);	 \
 	return Py_BuildValue("i", code);	}
 
+/* any entry point may run on a thread that hasn't touched RELIC yet */
+#define RELIC_CTX_CHECK() \
+	if(pairing_init_thread() != ELEMENT_OK) { 	\
+	PyErr_SetString(ElementError, "could not initialize RELIC context for this thread."); \
+	return NULL;	}
+
+#ifdef RELIC_THREAD_SAFE
+#define RELIC_BEGIN_ALLOW_THREADS	Py_BEGIN_ALLOW_THREADS
+#define RELIC_END_ALLOW_THREADS		Py_END_ALLOW_THREADS
+#else
+/* a single shared context can't be used concurrently, so hold on to the GIL */
+#define RELIC_BEGIN_ALLOW_THREADS	{
+#define RELIC_END_ALLOW_THREADS		}
+#endif
+
 #define IS_SAME_GROUP(a, b) 	/* doesn't apply */
 //#define IS_SAME_GROUP(a, b)
 //	if(strncmp((const char *) a->pairing->hash_id, (const char *) b->pairing->hash_id, ID_LEN) != 0) {
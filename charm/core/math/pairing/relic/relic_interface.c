@@ -98,19 +98,76 @@ int bn_is_one(bn_t a)
 	else return 0; // false
 }
 
-status_t pairing_init(void)
+#ifdef RELIC_THREAD_SAFE
+static pthread_key_t relic_ctx_key;
+static pthread_once_t relic_ctx_once = PTHREAD_ONCE_INIT;
+
+/* invoked by pthreads when a thread that initialized a context exits */
+static void relic_ctx_cleanup(void *ctx)
+{
+	if(ctx != NULL) core_clean();
+}
+
+static void relic_ctx_key_init(void)
+{
+	pthread_key_create(&relic_ctx_key, relic_ctx_cleanup);
+}
+#endif
+
+#if RAND == CALL
+/* RELIC built with -DRAND=CALL takes its random bytes from this callback */
+static void relic_drbg_random(uint8_t *buf, int size, void *args)
+{
+	if(!drbg_bytes(buf, (size_t) size)) {
+		fprintf(stderr, "failed to seed the random generator.\n");
+		abort();
+	}
+}
+#endif
+
+static status_t relic_ctx_init(void)
 {
 	int err_code = core_init();
 	if(err_code != STS_OK) return ELEMENT_PAIRING_INIT_FAILED;
+#if RAND == CALL
+	/* the callback lives in the (per-thread) core context */
+	rand_call(relic_drbg_random, NULL);
+#endif
 
 //	conf_print();
 	pc_param_set_any(); // see if we can open this up?
 	return ELEMENT_OK;
 }
 
+status_t pairing_init_thread(void)
+{
+#ifdef RELIC_THREAD_SAFE
+	pthread_once(&relic_ctx_once, relic_ctx_key_init);
+	if(pthread_getspecific(relic_ctx_key) != NULL) return ELEMENT_OK;
+	if(relic_ctx_init() != ELEMENT_OK) return ELEMENT_PAIRING_INIT_FAILED;
+	pthread_setspecific(relic_ctx_key, (void *) 1);
+#endif
+	return ELEMENT_OK;
+}
+
+status_t pairing_init(void)
+{
+#ifdef RELIC_THREAD_SAFE
+	/* the importing thread may already own a context from an earlier group */
+	return pairing_init_thread();
+#else
+	return relic_ctx_init();
+#endif
+}
+
 status_t pairing_clear(void)
 {
 	int err_code = core_clean();
+#ifdef RELIC_THREAD_SAFE
+	/* context is gone, so don't clean it again when the thread exits */
+	pthread_once(&relic_ctx_once, relic_ctx_key_init);
+	pthread_setspecific(relic_ctx_key, NULL);
+#endif
 	/* check error */
 	if(err_code != STS_OK) return ELEMENT_PAIRING_INIT_FAILED;
 
@@ -689,6 +746,43 @@ status_t element_invert(element_t c, element_t a)
 	return ELEMENT_OK;
 }
 
+/* c[i] = 1 / a[i] for n ZR elements: a single inversion plus 3(n-1) multiplications */
+status_t element_invert_batch(element_ptr *c, element_ptr *a, int n)
+{
+	element_t acc, inv;
+	int i;
+
+	for(i = 0; i < n; i++) {
+		LEAVE_IF(a[i]->isInitialized != TRUE || c[i]->isInitialized != TRUE, "uninitialized arguments.");
+		if(a[i]->type != ZR || c[i]->type != ZR) return ELEMENT_INVALID_TYPES;
+	}
+	if(n <= 0) return ELEMENT_OK;
+
+	element_init_Zr(acc, 1);
+	element_init_Zr(inv, 0);
+	// c[i] = a[0] * ... * a[i-1]
+	for(i = 0; i < n; i++) {
+		element_set(c[i], acc);
+		element_mul(acc, acc, a[i]);
+	}
+
+	if(bn_is_zero(acc->bn)) {
+		element_clear(acc);
+		element_clear(inv);
+		return ELEMENT_DIV_ZERO;
+	}
+
+	element_invert(inv, acc);
+	for(i = n - 1; i >= 0; i--) {
+		// inv = 1 / (a[0] * ... * a[i])
+		element_mul(c[i], c[i], inv);
+		element_mul(inv, inv, a[i]);
+	}
+	element_clear(acc);
+	element_clear(inv);
+	return ELEMENT_OK;
+}
+
 status_t element_pow_zr(element_t c, element_t a, element_t b)
 {
 	GroupType type = a->type;
@@ -864,6 +958,27 @@ status_t element_from_hash(element_t e, unsigned char *data, int len)
 	return result;
 }
 
+status_t element_from_hash_dst(element_t e, unsigned char *data, int len, unsigned char *dst, int dst_len)
+{
+	LEAVE_IF(e->isInitialized == FALSE, "uninitialized argument.");
+	LEAVE_IF(dst_len <= 0 || dst_len > 255, "invalid domain separation tag.");
+	status_t result = ELEMENT_OK;
+
+	/* the ep/ep2 maps implement hash_to_curve (expand_message_xmd + two field elements),
+	 * with the map chosen by EP_MAP/EP2_MAP (SSWU + isogeny on the BLS12 curves by default) */
+	switch(e->type) {
+		case G1: ep_map_dst(e->g1, data, len, dst, dst_len);
+				 break;
+		case G2: ep2_map_dst(e->g2, data, len, dst, dst_len);
+				 break;
+		default:
+				 result = ELEMENT_INVALID_TYPES;
+				 break;
+	}
+
+	return result;
+}
+
 int element_length(element_t e)
 {
 
@@ -1172,6 +1287,64 @@ status_t element_to_bytes(unsigned char *data, int data_len, element_t e)
 	return ELEMENT_OK;
 }
 
+int element_length_compressed(element_t e)
+{
+	if(e->isInitialized != TRUE) return 0;
+	switch(e->type) {
+		case G1: return g1_size_bin(e->g1, TRUE); // G1_LEN_CMP or 1 for infinity
+		case G2: return g2_size_bin(e->g2, TRUE); // G2_LEN_CMP or 1 for infinity
+		default: break;
+	}
+	return element_length(e);
+}
+
+status_t element_to_bytes_compressed(unsigned char *data, int data_len, element_t e)
+{
+	LEAVE_IF(e->isInitialized != TRUE, "uninitialized argument.");
+	status_t result = ELEMENT_OK;
+	if(e->type != G1 && e->type != G2) {
+		return element_to_bytes(data, data_len, e);
+	}
+	if(data_len < element_length_compressed(e)) return ELEMENT_INVALID_ARG_LEN;
+
+	TRY {
+		if(e->type == G1) g1_write_bin(data, element_length_compressed(e), e->g1, TRUE);
+		else g2_write_bin(data, element_length_compressed(e), e->g2, TRUE);
+	}
+	CATCH_ANY {
+		result = ELEMENT_INVALID_RESULT;
+	}
+	return result;
+}
+
+status_t element_from_bytes_compressed(element_t e, unsigned char *data, int data_len)
+{
+	LEAVE_IF(e->isInitialized != TRUE, "uninitialized argument.");
+	status_t result = ELEMENT_OK;
+	if(e->type == G1) {
+		/* G1_LEN is the uncompressed encoding written before compression became the default */
+		if(data_len == G1_LEN) return element_from_bytes(e, data, data_len);
+		if(data_len != G1_LEN_CMP && data_len != 1) return ELEMENT_INVALID_ARG_LEN;
+	}
+	else if(e->type == G2) {
+		if(data_len == G2_LEN) return element_from_bytes(e, data, data_len);
+		if(data_len != G2_LEN_CMP && data_len != 1) return ELEMENT_INVALID_ARG_LEN;
+	}
+	else {
+		return element_from_bytes(e, data, data_len);
+	}
+
+	/* recovers y with a field square root and rejects x-coordinates that are not on the curve */
+	TRY {
+		if(e->type == G1) g1_read_bin(e->g1, data, data_len);
+		else g2_read_bin(e->g2, data, data_len);
+	}
+	CATCH_ANY {
+		result = ELEMENT_INVALID_ARG;
+	}
+	return result;
+}
+
 status_t element_to_key(element_t e, uint8_t *data, int data_len, uint8_t label)
 {
 	LEAVE_IF(e->isInitialized != TRUE, "uninitialized argument.");
@@ -33,8 +33,16 @@
 #include <stdlib.h>
 #include <math.h>
 #include "relic.h"
+#include "drbg.h"
 /* make sure error checking enabled in relic_conf.h, ALLOC should be dynamic */
 
+/* RELIC built with -DMULTI=PTHREAD keeps its core context in thread-local storage,
+ * so every OS thread needs its own core_init() before touching any element. */
+#if defined(MULTI) && defined(PTHREAD) && MULTI == PTHREAD
+#define RELIC_THREAD_SAFE	1
+#include <pthread.h>
+#endif
+
 //#define DISABLE_CHECK  1
 #define TRUE	1
 #define FALSE	0
@@ -73,6 +81,9 @@ typedef enum Group GroupType;
 #define G1_LEN (FP_BYTES * 2) + 2
 #define G2_LEN (FP_BYTES * 4) + 4
 #define GT_LEN (FP_BYTES * 12) + 12
+/* compressed points: sign byte followed by the x-coordinate */
+#define G1_LEN_CMP FP_BYTES + 1
+#define G2_LEN_CMP (FP_BYTES * 2) + 1
 
 struct element {
 	int isInitialized;
@@ -101,6 +112,8 @@ int bn_is_one(bn_t a);
  */
 status_t pairing_init(void); // must be able to set curve parameters dynamically
 status_t pairing_clear(void);
+/* lazily sets up the RELIC core context and curve parameters for the calling thread */
+status_t pairing_init_thread(void);
 
 status_t element_init_Zr(element_t e, int init_value);
 /* Initialize 'e' to be an element of the group G1, G2 or GT of pairing. */
@@ -140,6 +153,8 @@ status_t element_int_div(element_t c, integer_t a, element_t b);
 status_t element_neg(element_t c, element_t a);
 // c = 1 / a
 status_t element_invert(element_t c, element_t a);
+// c[i] = 1 / a[i] for a list of ZR elements (Montgomery's trick)
+status_t element_invert_batch(element_ptr *c, element_ptr *a, int n);
 // c = a ^ b ( where b is ZR)
 status_t element_pow_zr(element_t c, element_t a, element_t b);
 // c = a ^ b ( where b is int)
@@ -165,10 +180,16 @@ status_t element_set_si(element_t e, unsigned int x);
 int element_length(element_t e);
 /* generate an element of a particular type from data */
 status_t element_from_hash(element_t e, unsigned char *data, int len);
+/* RFC 9380 hash-to-curve of data into G1 or G2 under the domain separation tag dst */
+status_t element_from_hash_dst(element_t e, unsigned char *data, int len, unsigned char *dst, int dst_len);
 /* serialize to bytes */
 status_t element_to_bytes(unsigned char *data, int data_len, element_t e);
 /* de-serialize from bytes */
 status_t element_from_bytes(element_t e, unsigned char *data, int data_len);
+/* compressed encoding for G1 and G2 (ZR and GT use the regular encoding) */
+int element_length_compressed(element_t e);
+status_t element_to_bytes_compressed(unsigned char *data, int data_len, element_t e);
+status_t element_from_bytes_compressed(element_t e, unsigned char *data, int data_len);
 
 void print_as_hex(uint8_t *data, size_t len);
 status_t charm_g1_read_bin(g1_t g, uint8_t *data, int data_len);
@@ -0,0 +1,175 @@
+/*
+ * Charm-Crypto is a framework for rapidly prototyping cryptosystems.
+ *
+ * Charm-Crypto is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Charm-Crypto is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Charm-Crypto. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Please contact the charm-crypto dev team at support@charm-crypto.com
+ * for any questions.
+ */
+
+/*
+ *   @file    drbg.c
+ *
+ *   @brief   per-thread ChaCha20 generator behind the random elements of every module
+ *
+ ************************************************************************/
+
+#include "drbg.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+
+#define DRBG_BLOCKS		16			/* ChaCha20 blocks per refill */
+#define DRBG_BUFFER		(DRBG_BLOCKS * 64)
+#define DRBG_KEY		32
+#define DRBG_RESEED		(1 << 16)	/* refills between reseeds (64 MiB) */
+
+typedef struct {
+	uint32_t key[DRBG_KEY / 4];
+	unsigned char buf[DRBG_BUFFER];
+	size_t pos;					/* bytes of buf already served or used as key */
+	unsigned long refills;
+	unsigned long generation;	/* drbg_generation when last seeded */
+	int seeded;
+} drbg_state;
+
+static pthread_key_t drbg_key;
+static pthread_once_t drbg_once = PTHREAD_ONCE_INIT;
+/* bumped in the child of every fork; a thread whose state is behind reseeds */
+static volatile unsigned long drbg_generation = 0;
+
+static void drbg_atfork_child(void)
+{
+	drbg_generation++;
+}
+
+static void drbg_release(void *st)
+{
+	OPENSSL_cleanse(st, sizeof(drbg_state));
+	free(st);
+}
+
+static void drbg_key_init(void)
+{
+	pthread_key_create(&drbg_key, drbg_release);
+	pthread_atfork(NULL, NULL, drbg_atfork_child);
+}
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+#define QUARTERROUND(a, b, c, d) \
+	a += b; d ^= a; d = ROTL32(d, 16); \
+	c += d; b ^= c; b = ROTL32(b, 12); \
+	a += b; d ^= a; d = ROTL32(d, 8);  \
+	c += d; b ^= c; b = ROTL32(b, 7);
+
+/* one 64-byte ChaCha20 block (RFC 8439) for key, block counter and an all-zero nonce */
+static void chacha20_block(const uint32_t key[8], uint32_t counter, unsigned char out[64])
+{
+	uint32_t in[16], x[16];
+	int i;
+
+	in[0] = 0x61707865; in[1] = 0x3320646e; in[2] = 0x79622d32; in[3] = 0x6b206574;
+	for(i = 0; i < 8; i++) in[4 + i] = key[i];
+	in[12] = counter;
+	in[13] = in[14] = in[15] = 0;
+
+	memcpy(x, in, sizeof(x));
+	for(i = 0; i < 10; i++) {
+		QUARTERROUND(x[0], x[4], x[8],  x[12])
+		QUARTERROUND(x[1], x[5], x[9],  x[13])
+		QUARTERROUND(x[2], x[6], x[10], x[14])
+		QUARTERROUND(x[3], x[7], x[11], x[15])
+		QUARTERROUND(x[0], x[5], x[10], x[15])
+		QUARTERROUND(x[1], x[6], x[11], x[12])
+		QUARTERROUND(x[2], x[7], x[8],  x[13])
+		QUARTERROUND(x[3], x[4], x[9],  x[14])
+	}
+	for(i = 0; i < 16; i++) {
+		x[i] += in[i];
+		out[4 * i]     = (unsigned char) x[i];
+		out[4 * i + 1] = (unsigned char) (x[i] >> 8);
+		out[4 * i + 2] = (unsigned char) (x[i] >> 16);
+		out[4 * i + 3] = (unsigned char) (x[i] >> 24);
+	}
+	OPENSSL_cleanse(in, sizeof(in));
+	OPENSSL_cleanse(x, sizeof(x));
+}
+
+/* expands the key into a new buffer whose first DRBG_KEY bytes become the next key */
+static void drbg_refill(drbg_state *st)
+{
+	int i;
+	for(i = 0; i < DRBG_BLOCKS; i++) chacha20_block(st->key, (uint32_t) i, st->buf + 64 * i);
+	memcpy(st->key, st->buf, DRBG_KEY);
+	OPENSSL_cleanse(st->buf, DRBG_KEY);
+	st->pos = DRBG_KEY;
+	st->refills++;
+}
+
+/* mixes fresh seed material into the key and discards whatever was buffered */
+static int drbg_reseed(drbg_state *st)
+{
+	unsigned char seed[DRBG_KEY];
+	int i;
+
+	if(RAND_bytes(seed, DRBG_KEY) != 1) return 0;
+	for(i = 0; i < DRBG_KEY; i++) ((unsigned char *) st->key)[i] ^= seed[i];
+	OPENSSL_cleanse(seed, DRBG_KEY);
+	st->refills = 0;
+	st->generation = drbg_generation;
+	st->seeded = 1;
+	drbg_refill(st);
+	return 1;
+}
+
+static drbg_state *drbg_thread_state(void)
+{
+	drbg_state *st;
+
+	pthread_once(&drbg_once, drbg_key_init);
+	st = (drbg_state *) pthread_getspecific(drbg_key);
+	if(st == NULL) {
+		st = (drbg_state *) calloc(1, sizeof(drbg_state));
+		if(st == NULL) return NULL;
+		pthread_setspecific(drbg_key, st);
+	}
+	if(!st->seeded || st->generation != drbg_generation || st->refills >= DRBG_RESEED) {
+		if(!drbg_reseed(st)) return NULL;
+	}
+	return st;
+}
+
+int drbg_bytes(unsigned char *out, size_t len)
+{
+	drbg_state *st = drbg_thread_state();
+	size_t n;
+
+	if(st == NULL) return 0;
+	while(len > 0) {
+		if(st->pos == DRBG_BUFFER) drbg_refill(st);
+		n = DRBG_BUFFER - st->pos;
+		if(n > len) n = len;
+		memcpy(out, st->buf + st->pos, n);
+		// served bytes are wiped so a later memory disclosure can't reveal them
+		OPENSSL_cleanse(st->buf + st->pos, n);
+		st->pos += n;
+		out += n;
+		len -= n;
+	}
+	return 1;
+}
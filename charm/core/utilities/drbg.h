@@ -0,0 +1,53 @@
+/*
+ * Charm-Crypto is a framework for rapidly prototyping cryptosystems.
+ *
+ * Charm-Crypto is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * Charm-Crypto is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Charm-Crypto. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Please contact the charm-crypto dev team at support@charm-crypto.com
+ * for any questions.
+ */
+
+/*
+ *   @file    drbg.h
+ *
+ *   @brief   per-thread ChaCha20 generator behind the random elements of every module
+ *
+ ************************************************************************/
+
+#ifndef __DRBG_H__
+#define __DRBG_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-thread ChaCha20 generator behind all the random elements of the math modules.
+ * Each thread keeps a key seeded from RAND_bytes and expands it a buffer at a time
+ * (the first 32 bytes of every buffer replace the key, so served output can't be
+ * recomputed later). Fresh seed material is mixed in periodically and in the child
+ * after a fork, so parent and child never share a stream.
+ *
+ * Fills out with len random bytes. Returns 1 on success and 0 if the generator
+ * could not be seeded.
+ */
+int drbg_bytes(unsigned char *out, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
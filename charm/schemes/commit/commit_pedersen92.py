@@ -27,5 +27,6 @@ class CM_Ped92(Commitment):
         return (c,d)
 
     def decommit(self, pk, c, d, msg):
-        return c == (pk['g'] ** msg) * (pk['h'] ** d)
+        # everything is public at this point, so the variable-time multiexp is fine
+        return c == group.multiexp([pk['g'], pk['h']], [msg, d])
 
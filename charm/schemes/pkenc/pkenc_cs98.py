@@ -72,6 +72,9 @@ class CS98(PKEnc):
         c = ((g1 ** x1) * (g2 ** x2))
         d = ((g1 ** y1) * (g2 ** y2)) 
         h = (g1 ** z)
+        # every encryption exponentiates these fixed bases
+        for base in (g1, g2, c, d, h):
+            base.initPP()
 		
         pk = { 'g1' : g1, 'g2' : g2, 'c' : c, 'd' : d, 'h' : h }
         sk = { 'x1' : x1, 'x2' : x2, 'y1' : y1, 'y2' : y2, 'z' : z }
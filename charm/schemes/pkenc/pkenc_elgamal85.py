@@ -84,6 +84,8 @@ class ElGamal(PKEnc):
             g = group.random(G)
         # x is private, g is public param
         x = group.random(); h = g ** x
+        # every encryption exponentiates g and h, so give both a fixed-base table
+        g.initPP(); h.initPP()
         if debug:
             print('Public parameters...')
             print('h => %s' % h)
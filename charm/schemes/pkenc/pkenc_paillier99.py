@@ -12,7 +12,7 @@ Pascal Paillier (Public-Key)
 :Authors:    J Ayo Akinyele
 :Date:       4/2011 (updated 2/2016)
 '''
-from charm.toolbox.integergroup import lcm,integer,toInt
+from charm.toolbox.integergroup import lcm,integer,toInt,powm_public,CRT,Paillier
 from charm.toolbox.PKEnc import PKEnc
 
 debug = False
@@ -39,11 +39,20 @@ class Ciphertext(dict):
     >>> decrypted_msg_3 == msg_3
     True
     """
-    def __init__(self, ct, pk, key):
+    def __init__(self, ct, pk, key, engine=None):
         dict.__init__(self, ct)
         self.pk, self.key = pk, key
+        # native integer.Paillier context when g = n + 1; each operation is then a single call
+        self.engine = engine
     
     def __add__(self, other):
+        if self.engine is not None:
+           lhs = dict.__getitem__(self, self.key)
+           if type(other) == int:
+               c = self.engine.add_plain(lhs, other)
+           else:
+               c = self.engine.add(lhs, dict.__getitem__(other, self.key))
+           return Ciphertext({self.key:c}, self.pk, self.key, self.engine)
         if type(other) == int: # rhs must be Cipher
            lhs = dict.__getitem__(self, self.key)
            return Ciphertext({self.key:lhs * ((self.pk['g'] ** other) % self.pk['n2']) }, 
@@ -55,24 +64,52 @@ class Ciphertext(dict):
                           self.pk, self.key) 
         
     def __mul__(self, other):
+        if type(other) == int and self.engine is not None:
+            lhs = dict.__getitem__(self, self.key)
+            return Ciphertext({self.key:self.engine.mul_plain(lhs, other)}, self.pk, self.key, self.engine)
         if type(other) == int:
             lhs = dict.__getitem__(self, self.key)
             return Ciphertext({self.key:(lhs ** other)}, self.pk, self.key)
     
-    def randomize(self, r): # need to provide random value
+    def randomize(self, r=None): # r is required without an engine
         lhs = dict.__getitem__(self, self.key)
-        rhs = (integer(r) ** self.pk['n']) % self.pk['n2']
-        return Ciphertext({self.key:(lhs * rhs) % self.pk['n2']})
+        if self.engine is not None and r is None:
+            # a fresh r^n, from the engine's pool when it has one
+            return Ciphertext({self.key:self.engine.rerandomize(lhs)}, self.pk, self.key, self.engine)
+        rhs = powm_public(integer(r) % self.pk['n2'], self.pk['n'])
+        return Ciphertext({self.key:(lhs * rhs) % self.pk['n2']}, self.pk, self.key, self.engine)
     
     def __str__(self):
         value = dict.__str__(self)
         return value # + ", pk =" + str(pk)
     
 class Pai99(PKEnc):
-    def __init__(self, groupObj):
+    """
+    Keys use g = n + 1, so encryption and decryption go through a native integer.Paillier
+    context: g^m = 1 + m*n, and r^n comes from a pool of ``pool`` values that ``threads``
+    worker threads refill in the background (pool=0 computes r^n on demand).
+    """
+    def __init__(self, groupObj, pool=0, threads=1):
         PKEnc.__init__(self)
         global group
         group = groupObj
+        self.pool, self.threads = pool, threads
+        self.engines = {}
+        self.crt = {}
+    
+    def engine(self, pk, sk=None):
+        # one context per modulus; the one made from the secret key also decrypts
+        n = pk['n']
+        if pk['g'] != n + 1:
+            return None
+        engine = self.engines.get(int(n))
+        if engine is None or (sk is not None and not engine[1]):
+            if sk is not None and 'p' in sk and 'q' in sk:
+                engine = (Paillier(n, sk['p'], sk['q'], self.pool, self.threads), True)
+            else:
+                engine = (Paillier(n, pool=self.pool, threads=self.threads), False)
+            self.engines[int(n)] = engine
+        return engine[0]
     
     def L(self, u, n):
         # computes L(u) => ((u - 1) / n)
@@ -85,20 +122,35 @@ class Pai99(PKEnc):
         (p, q, n) = group.paramgen(secparam)
         lam = lcm(p - 1, q - 1)
         n2 = n ** 2
-        g = group.random(n2)
+        g = n + 1
         u = (self.L(((g % n2) ** lam), n) % n) ** -1
-        pk, sk = {'n':n, 'g':g, 'n2':n2}, {'lamda':lam, 'u':u}
+        pk, sk = {'n':n, 'g':g, 'n2':n2}, {'lamda':lam, 'u':u, 'p':p, 'q':q}
+        self.engine(pk, sk)
         return (pk, sk)
 
     def encrypt(self, pk, m):
+        engine = self.engine(pk)
+        if engine is not None:
+            return Ciphertext({'c':engine.encrypt(m)}, pk, 'c', engine)
         g, n, n2 = pk['g'], pk['n'], pk['n2']
         r = group.random(pk['n'])
-        c = ((g % n2) ** m) * ((r % n2) ** n)
+        c = ((g % n2) ** m) * powm_public(r % n2, n)
         return Ciphertext({'c':c}, pk, 'c')
     
     def decrypt(self, pk, sk, ct):
         n, n2 = pk['n'], pk['n2']
-        m = ((self.L(ct['c'] ** sk['lamda'], n) % n) * sk['u']) % n
+        engine = self.engine(pk, sk) if 'p' in sk and 'q' in sk else None
+        if engine is not None:
+            return toInt(engine.decrypt(ct['c']))
+        if 'p' in sk and 'q' in sk:
+            # c^lambda mod n^2 as two exponentiations mod p^2 and q^2
+            key = (int(sk['p']), int(sk['q']))
+            if key not in self.crt:
+                self.crt[key] = CRT(sk['p'], sk['q'])
+            u = self.crt[key].powm_n2(ct['c'], sk['lamda'])
+        else:
+            u = ct['c'] ** sk['lamda']
+        m = ((self.L(u, n) % n) * sk['u']) % n
         return toInt(m)
 
     def encode(self, modulus, message):
@@ -10,7 +10,7 @@
 :Date:            07/2011
 '''
 
-from charm.core.math.integer import integer,isPrime,gcd,random,randomPrime,toInt
+from charm.core.math.integer import integer,isPrime,gcd,random,randomPrime,toInt,powm_public,CRT
 from charm.toolbox.PKEnc import PKEnc
 from charm.toolbox.PKSig import PKSig
 from charm.toolbox.paddingschemes import OAEPEncryptionPadding,PSSPadding
@@ -20,7 +20,8 @@ from math import ceil
 debug = False
 class RSA():
     def __init__(self):
-        pass
+        # per private key: the CRT context and e = d^-1 mod phi(N) for the signature fault check
+        self.crt = {}
     # generate p,q and n
     def paramgen(self, secparam):
         while True:
@@ -36,7 +37,7 @@ class RSA():
             (N, e, d, p, q) = self.convert(params)
             phi_N = (p - 1) * (q - 1)
             pk = { 'N':N, 'e':e }
-            sk = { 'phi_N':phi_N, 'd':d , 'N':N}
+            sk = { 'phi_N':phi_N, 'd':d , 'N':N, 'p':p, 'q':q }
             return (pk, sk)
 
         (p, q, N, phi_N) = self.paramgen(secparam)
@@ -48,10 +49,23 @@ class RSA():
             d = e ** -1
             break
         pk = { 'N':N, 'e':toInt(e) } # strip off \phi
-        sk = { 'phi_N':phi_N, 'd':d , 'N':N}
+        sk = { 'phi_N':phi_N, 'd':d , 'N':N, 'p':p, 'q':q }
 
         return (pk, sk)
     
+    def crtContext(self, sk):
+        key = (int(sk['p']), int(sk['q']), int(sk['d']))
+        if key not in self.crt:
+            e = integer(int(sk['d']), sk['phi_N']) ** -1
+            self.crt[key] = (CRT(sk['p'], sk['q']), e)
+        return self.crt[key]
+
+    def privatePow(self, sk, x):
+        # x^d mod N; keys that carry the factorization use two half-size exponentiations
+        if 'p' in sk and 'q' in sk:
+            return self.crtContext(sk)[0].powm(x, sk['d']) % sk['N']
+        return (x ** (sk['d'] % sk['phi_N'])) % sk['N']
+
     def convert(self, N, e, d, p, q):
         return (integer(N), integer(e), integer(d), 
                 integer(p), integer(q))
@@ -77,11 +91,11 @@ class RSA_Enc(RSA,PKEnc):
         if debug: print("EM == >", EM)
         i = Conversion.OS2IP(EM)
         ip = integer(i) % pk['N']  #Convert to modular integer
-        return (ip ** pk['e']) % pk['N']
+        return powm_public(ip, pk['e']) % pk['N']
     
     def decrypt(self, pk, sk, c):
         octetlen = int(ceil(int(pk['N']).bit_length() / 8.0))
-        M = (c ** (sk['d'] % sk['phi_N'])) % pk['N']
+        M = self.privatePow(sk, c)
         os = Conversion.IP2OS(int(M), octetlen)
         if debug: print("OS  =>", os)
         return self.paddingscheme.decode(os)
@@ -111,7 +125,10 @@ class RSA_Sig(RSA, PKSig):
         em = self.paddingscheme.encode(M, modbits - 1, salt)
         m = Conversion.OS2IP(em)
         m = integer(m) % sk['N']  #ERRROR m is larger than N
-        s =  (m ** sk['d']) % sk['N']
+        s = self.privatePow(sk, m)
+        if 'p' in sk and 'q' in sk and powm_public(s, self.crtContext(sk)[1]) != m:
+            # a fault in one CRT half would reveal a factor of N through gcd(s^e - m, N)
+            raise Exception("RSA signature failed its consistency check.")
         S = Conversion.IP2OS(s, k)
         if debug:
             print("Signing")
@@ -132,7 +149,7 @@ class RSA_Sig(RSA, PKSig):
             return False
         s = Conversion.OS2IP(S)
         s = integer(s) % pk['N']  #Convert to modular integer
-        m = (s ** pk['e']) % pk['N']
+        m = powm_public(s, pk['e']) % pk['N']
         EM = Conversion.IP2OS(m, emLen)
         if debug:
             print("Verifying")
@@ -60,17 +60,12 @@ class Sig_CL03(PKSig):
         
     def keygen(self, secparam=512, p=0, q=0):
         if(p == 0):
-            pprime = randomPrime(secparam)
-            while(not isPrime(2*pprime + 1)):
-                pprime = randomPrime(secparam)
-            p = 2 * pprime + 1
+            # p = 2 * pprime + 1 with a secparam-bit prime pprime
+            p = randomPrime(secparam + 1, 1)
             print(p)
 
         if(q == 0):
-            qprime = randomPrime(secparam)
-            while(not isPrime(2*qprime + 1)):
-                qprime = randomPrime(secparam)
-            q = 2 * qprime + 1
+            q = randomPrime(secparam + 1, 1)
             print(q)
 
         N = p * q
@@ -14,6 +14,8 @@ Digital Signature Algorithm (DSA)
 """
 from charm.toolbox.ecgroup import ECGroup,ZR,G
 from charm.toolbox.PKSig import PKSig
+from charm.toolbox.securerandom import OpenSSLRand
+from charm.core.math.elliptic_curve import ec_element
 
 debug = False
 class ECDSA(PKSig):
@@ -26,6 +28,8 @@ class ECDSA(PKSig):
     >>> signature = ecdsa.sign(public_key, secret_key, msg)
     >>> ecdsa.verify(public_key, signature, msg)
     True
+    >>> ecdsa.batch_verify([(public_key, msg, signature), (public_key, "forged", signature)])
+    [True, False]
     """
     def __init__(self, groupObj):
         PKSig.__init__(self)
@@ -41,7 +45,8 @@ class ECDSA(PKSig):
     def sign(self, pk, x, M):
         while True:
             k = group.random()
-            r = group.zr(pk['g'] ** k)
+            R = pk['g'] ** k
+            r = group.zr(R)
             e = group.hash(M)
             s = (k ** -1) * (e + x * r)
             if (r == 0 or s == 0):
@@ -49,16 +54,79 @@ class ECDSA(PKSig):
                 continue
             else:
                 break
-        return { 'r':r, 's':s }
+        # 'v' is the parity of R's y-coordinate, so that R can be recovered from r for batching
+        return { 'r':r, 's':s, 'v':int(group.coordinates(R)[1]) & 1 }
         
     def verify(self, pk, sig, M):
         w = sig['s'] ** -1
         u1 = group.hash(M) * w
         u2 = sig['r'] * w
-        v = (pk['g'] ** u1) * (pk['y'] ** u2)
+        v = group.multiexp([pk['g'], pk['y']], [u1, u2])
     
         if group.zr(v) == sig['r']:
             return True
         else:
             return False
 
+    def batch_verify(self, batch):
+        """verifies a list of (pk, message, sig) tuples and returns one boolean per entry.
+
+        Signatures carrying the recovery bit are checked together: with R recovered from r,
+        sum z_i * (u1_i * g_i + u2_i * y_i - R_i) must be the point at infinity for random
+        128-bit z_i, which takes one multi-scalar multiplication. A failing batch is bisected
+        to find the bad signatures. Signatures without the bit are verified one by one."""
+        batch = list(batch)
+        result = [None] * len(batch)
+        recoverable = []
+        for i, (pk, M, sig) in enumerate(batch):
+            if 'v' in sig:
+                recoverable.append(i)
+            else:
+                result[i] = self.verify(pk, sig, M)
+
+        checked = self.bisect_batch([batch[i] for i in recoverable], self.check_batch)
+        for i, ok in zip(recoverable, checked):
+            result[i] = ok
+        return result
+
+    def check_batch(self, batch):
+        if len(batch) == 1:
+            # the final verdict on a single signature is always the standard check
+            (pk, M, sig) = batch[0]
+            return self.verify(pk, sig, M)
+        rand = OpenSSLRand()
+        bases = {}   # base points shared between signatures get a single coefficient
+        def add(P, c):
+            if id(P) in bases:
+                bases[id(P)][1] += c
+            else:
+                bases[id(P)] = [P, c]
+
+        for (pk, M, sig) in batch:
+            if sig['r'] == 0 or sig['s'] == 0:
+                return False
+            R = self.recover(pk['g'], sig['r'], sig['v'])
+            if R is None:
+                return False
+            z = group.init(ZR, int.from_bytes(rand.getRandomBytes(16), 'big'))
+            w = (sig['s'] ** -1) * z
+            add(pk['g'], group.hash(M) * w)
+            add(pk['y'], sig['r'] * w)
+            add(R, -z)
+
+        points = [b[0] for b in bases.values()]
+        scalars = [b[1] for b in bases.values()]
+        return len(points) == 0 or group.multiexp(points, scalars).isInf()
+
+    def recover(self, g, r, v):
+        """rebuilds R from its x-coordinate r and the parity v of its y-coordinate"""
+        # raw encoding of g (type byte, then the compressed point) gives the field element width
+        width = len(group.serialize(g, format='raw')) - 2
+        try:
+            R = group.deserialize(bytes([G, 2 + (v & 1)]) + int(r).to_bytes(width, 'big'))
+        except Exception:
+            return None
+        if type(R) is not ec_element or R.isInf():
+            return None
+        return R
+
@@ -15,7 +15,7 @@ Hohenberger-Waters Stateful Signatures (RSA-based)
 :Status:    Needs Improvement.
 """
 
-from charm.core.math.integer import integer,random,randomBits,isPrime,gcd,bitsize,serialize
+from charm.core.math.integer import integer,random,randomBits,isPrime,gcd,bitsize,serialize,powm_public,CRT
 from charm.toolbox.PKSig import PKSig
 from charm.schemes.chamhash_rsa_hw09 import ChamHash_HW09
 from charm.toolbox.conversion import Conversion
@@ -99,6 +99,7 @@ class Sig_RSA_Stateless_HW09(PKSig):
         self.BWInt = BlumWilliamsInteger()
         self.Prf = Prf()
         self.ChameleonHash = CH()
+        self.crt = {}
         
     def keygen(self, keyLength=1024, p=0, q=0):
         # Generate a Blum-Williams integer N of 'key_length' bits with factorization p,q
@@ -151,13 +152,29 @@ class Sig_RSA_Stateless_HW09(PKSig):
         temp = ((u ** x) * h) % N
         power = ((((p-1)*(q-1))+4)/8) ** (math.ceil(log[2](s)))
         B = temp ** power
-        sigma1 = (B ** (e ** -1)) % N
+        sigma1 = self.crtContext(p, q).powm(B, self.rootExponent(p, q, e)) % N
+        if powm_public(sigma1, e) % N != B % N:
+            # a fault in one CRT half would reveal a factor of N through gcd(sigma1^e - B, N)
+            raise Exception("HW09 signature failed its consistency check.")
 
         # Update internal state counter and return sig = (sigma1, r, s)
         self.state = s
         return { 'sigma1':sigma1, 'r': r, 's': s, 'e':e }
 
 
+    def crtContext(self, p, q):
+        key = (int(p), int(q))
+        if key not in self.crt:
+            self.crt[key] = CRT(p, q)
+        return self.crt[key]
+
+    def rootExponent(self, p, q, e):
+        # d = e^-1 mod phi(N), kept per key and prime exponent
+        key = (int(p), int(q), int(e))
+        if key not in self.crt:
+            self.crt[key] = e ** -1
+        return self.crt[key]
+
     def verify(self, pk, message, sig):
         if debug: print("\nVERIFY\n\n")
         sigma1, r, s, e = sig['sigma1'], sig['r'], sig['s'], sig['e']
@@ -175,12 +192,12 @@ class Sig_RSA_Stateless_HW09(PKSig):
         
         # Compute Y = sigma1^{2*ceil(log2(s))}
         s1 = integer(2 ** (math.ceil(log[2](s))))
-        Y = (sigma1 ** s1) % N
+        Y = powm_public(sigma1, s1) % N
         
         # Hash the mesage using the chameleon hash with fixed randomness r
         (x, r2) = self.ChameleonHash.hash(L, message, r)
 
-        lhs = (Y ** ei) % N
+        lhs = powm_public(Y, ei) % N
         rhs = ((u ** x) * h) % N
         if debug:
             print("lhs =>", lhs)
@@ -1,5 +1,6 @@
-from charm.toolbox.integergroup import IntegerGroupQ
+from charm.toolbox.integergroup import IntegerGroupQ,integer,powm_public
 from charm.toolbox.PKSig import PKSig
+from charm.toolbox.securerandom import OpenSSLRand
 
 debug = False
 class SchnorrSig(PKSig):
@@ -14,6 +15,9 @@ class SchnorrSig(PKSig):
     >>> signature = pksig.sign(public_key, secret_key, msg)
     >>> pksig.verify(public_key, signature, msg)
     True
+    >>> (other_key, other_secret) = pksig.keygen()
+    >>> pksig.batch_verify([(public_key, msg, signature), (other_key, msg, signature)])
+    [True, False]
     """
     def __init__(self):
         PKSig.__init__(self)
@@ -39,7 +43,8 @@ class SchnorrSig(PKSig):
         e = group.hash(M, r)
         s = (k - x*e) % q
 
-        return {'e':e, 's':s }
+        # the commitment r isn't needed by verify(), but lets batch_verify() combine signatures
+        return {'e':e, 's':s, 'r':r }
     
     def verify(self, pk, sig, M):
         p = group.p
@@ -53,4 +58,59 @@ class SchnorrSig(PKSig):
         else:
             return False
         return None
+
+    def batch_verify(self, batch):
+        """verifies a list of (pk, message, sig) tuples and returns one boolean per entry.
+
+        Signatures that carry their commitment r are checked together: after the hash check
+        e_i == H(M_i, r_i) and a check that r_i lies in the order-q subgroup, prod (g_i^s_i * y_i^e_i)^z_i == prod r_i^z_i (mod p) must hold for
+        random 64-bit z_i. Exponents of a shared g or y are summed first, so every common base
+        costs one exponentiation for the whole batch. A failing batch is bisected to find the
+        bad signatures; signatures without r are verified one by one."""
+        batch = list(batch)
+        result = [None] * len(batch)
+        combined = []
+        for i, (pk, M, sig) in enumerate(batch):
+            if 'r' in sig:
+                combined.append(i)
+            else:
+                result[i] = self.verify(pk, sig, M)
+
+        checked = self.bisect_batch([batch[i] for i in combined], self.check_batch)
+        for i, ok in zip(combined, checked):
+            result[i] = ok
+        return result
+
+    def check_batch(self, batch):
+        if len(batch) == 1:
+            # the final verdict on a single signature is always the standard check
+            (pk, M, sig) = batch[0]
+            return self.verify(pk, sig, M)
+        p, q = group.p, group.q
+        rand = OpenSSLRand()
+        bases = {}
+        def add(b, x):
+            if id(b) in bases:
+                bases[id(b)][1] += x
+            else:
+                bases[id(b)] = [b, x]
+
+        rhs = None
+        for (pk, M, sig) in batch:
+            if group.hash(M, sig['r']) != sig['e']:
+                return False
+            # r outside the subgroup (e.g. -g^k, where -1 has order 2) could cancel across signatures
+            if powm_public(integer(int(sig['r']), p), q) != 1:
+                return False
+            z = int.from_bytes(rand.getRandomBytes(8), 'big')
+            add(pk['g'], sig['s'] * integer(z, q))
+            add(pk['y'], sig['e'] * integer(z, q))
+            t = (sig['r'] ** z) % p
+            rhs = t if rhs is None else (rhs * t) % p
+
+        lhs = None
+        for (b, x) in bases.values():
+            t = (b ** x) % p
+            lhs = t if lhs is None else (lhs * t) % p
+        return lhs == rhs
     
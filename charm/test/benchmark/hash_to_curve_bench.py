@@ -0,0 +1,44 @@
+import sys
+
+from charm.toolbox.ecgroup import ECGroup, G
+from charm.toolbox.eccurve import prime256v1, secp256k1
+
+
+def run_hash_to_curve(curve, method, trials):
+    group = ECGroup(curve)
+    messages = [("message %d" % i).encode('utf-8') for i in range(trials)]
+
+    start_bench(group)
+    for m in messages:
+        group.hash(m, G, method=method)
+    return end_bench(group, method or "try-and-increment", curve, trials)
+
+
+def end_bench(group, operation, curve, n):
+    group.EndBenchmark()
+    benchmarks = group.GetGeneralBenchmarks()
+    cpu_time = benchmarks['CpuTime']
+    real_time = benchmarks['RealTime']
+    return "%s,%d,%d,%f,%f" % (operation, curve, n, cpu_time, real_time)
+
+
+def start_bench(group):
+    group.InitBenchmark()
+    group.StartBenchmark(["RealTime", "CpuTime"])
+
+
+if __name__ == '__main__':
+    """
+    Compares the legacy try-and-increment mapping of ECGroup.hash into G
+    against RFC 9380 hash-to-curve (method='sswu').
+
+    :arg n: number of messages hashed per curve and method.
+
+    Example invocation:
+    `$ python charm/test/benchmark/hash_to_curve_bench.py 1000`
+    """
+    trials = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+    print("function,curve,n,CpuTime,RealTime")
+    for curve in [prime256v1, secp256k1]:
+        print(run_hash_to_curve(curve, None, trials))
+        print(run_hash_to_curve(curve, 'sswu', trials))
@@ -0,0 +1,52 @@
+import sys
+import time
+
+from charm.core.math.integer import IntegerVector, integer, randomBits, randomPrime
+
+
+def run_pair(name, loop, vector, same=lambda a, b: list(a) == list(b)):
+    start = time.perf_counter()
+    expected = loop()
+    middle = time.perf_counter()
+    result = vector()
+    end = time.perf_counter()
+    assert same(expected, result), "%s: results differ" % name
+    return "%s,%f,%f" % (name, middle - start, end - middle)
+
+
+if __name__ == '__main__':
+    """
+    Compares one Python call per element against the equivalent
+    IntegerVector operation on random values mod a random modulus.
+
+    :arg bits: bit length of the modulus (2048 bits stands in for a Paillier n^2 of a 1024-bit n).
+    :arg n: number of elements.
+
+    Example invocation:
+    `$ python charm/test/benchmark/integer_vector_bench.py 4096 100000`
+    """
+    bits = int(sys.argv[1]) if len(sys.argv) > 1 else 2048
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 100000
+    m = randomPrime(bits)
+    xs = [integer(int(randomBits(bits - 1)), m) for i in range(count)]
+    ys = [integer(int(randomBits(bits - 1)), m) for i in range(count)]
+    es = [int(randomBits(256)) for i in range(count // 100)]
+    xv, yv, ev = IntegerVector(xs), IntegerVector(ys), IntegerVector(es)
+
+    def loop_prod():
+        acc = xs[0]
+        for x in xs[1:]:
+            acc = (acc * x) % m
+        return acc
+
+    print("operation,loopSeconds,vectorSeconds")
+    width = (bits + 7) // 8
+    data = xv.toBytes()
+    pv = IntegerVector(xs[:len(es)])
+    print(run_pair("mul", lambda: [(x * y) % m for x, y in zip(xs, ys)], lambda: xv * yv))
+    print(run_pair("pow (n/100, 256-bit exponents)", lambda: [x ** e for x, e in zip(xs, es)], lambda: pv ** ev))
+    print(run_pair("prod", loop_prod, lambda: xv.prod(), lambda a, b: a == b))
+    print(run_pair("toBytes", lambda: b''.join(int(x).to_bytes(width, 'big') for x in xs),
+                   lambda: xv.toBytes(), lambda a, b: a == b))
+    print(run_pair("fromBytes", lambda: [integer(int.from_bytes(data[i:i + width], 'big'), m) for i in range(0, len(data), width)],
+                   lambda: IntegerVector.fromBytes(data, modulus=m)))
@@ -0,0 +1,43 @@
+import sys
+import time
+
+from charm.toolbox.integergroup import RSAGroup, Paillier, integer, powm_public
+
+
+def run_ops(name, op, trials):
+    start = time.perf_counter()
+    for i in range(trials):
+        op(i)
+    elapsed = time.perf_counter() - start
+    return "%s,%d,%f" % (name, trials, trials / elapsed)
+
+
+if __name__ == '__main__':
+    """
+    Reports Paillier operations per second with g = n + 1, for the generic
+    g^m * r^n formula and for the native integer.Paillier context.
+
+    :arg bits: bit length of n.
+    :arg n: number of operations per row.
+
+    Example invocation:
+    `$ python charm/test/benchmark/paillier_bench.py 2048 200`
+    """
+    bits = int(sys.argv[1]) if len(sys.argv) > 1 else 2048
+    trials = int(sys.argv[2]) if len(sys.argv) > 2 else 200
+    group = RSAGroup()
+    p, q, n = group.paramgen(bits)
+    n2 = n ** 2
+    g = (n + 1) % n2
+    ctx = Paillier(n, p, q, pool=trials, threads=0)
+    pub = Paillier(n)
+    c = ctx.encrypt(1)
+    print("function,n,PerSecond")
+    print(run_ops("g**m * r**n", lambda m: (g ** m) * powm_public(group.random(n) % n2, n), trials))
+    print(run_ops("encrypt (public key)", pub.encrypt, trials))
+    print(run_ops("encrypt (CRT, no pool)", Paillier(n, p, q).encrypt, trials))
+    print(run_ops("precompute r**n (CRT)", lambda i: ctx.precompute(1), trials))
+    print(run_ops("encrypt (pooled)", ctx.encrypt, trials))
+    print(run_ops("decrypt (CRT)", lambda i: ctx.decrypt(c), trials))
+    print(run_ops("add", lambda i: ctx.add(c, c), trials * 10))
+    print(run_ops("add_plain", lambda i: ctx.add_plain(c, i), trials * 10))
@@ -0,0 +1,31 @@
+import sys
+import time
+
+from charm.core.math.integer import randomPrime
+
+
+def run_prime_gen(bits, safe, threads, trials):
+    start = time.perf_counter()
+    for i in range(trials):
+        randomPrime(bits, safe, threads)
+    avg = (time.perf_counter() - start) / trials
+    return "%s,%d,%d,%d,%f" % ("safe prime" if safe else "prime", bits, threads, trials, avg)
+
+
+if __name__ == '__main__':
+    """
+    Reports the average time to generate a random prime and a random safe
+    prime p = 2q + 1 with randomPrime.
+
+    :arg n: number of primes generated per size (safe primes: n / 10, at least 1).
+    :arg threads: number of search threads (0 means one per online CPU).
+
+    Example invocation:
+    `$ python charm/test/benchmark/prime_gen_bench.py 50 4`
+    """
+    trials = int(sys.argv[1]) if len(sys.argv) > 1 else 50
+    threads = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+    print("function,bits,threads,n,AvgTime")
+    for bits in [1024, 2048, 3072]:
+        print(run_prime_gen(bits, False, threads, trials))
+        print(run_prime_gen(bits, True, threads, max(1, trials // 10)))
@@ -0,0 +1,45 @@
+import sys
+import time
+
+from charm.core.math.integer import randomBits
+from charm.toolbox.integergroup import IntegerGroupQ
+from charm.toolbox.ecgroup import ECGroup, G, ZR
+from charm.toolbox.eccurve import prime256v1
+
+
+def run_random(name, draw, trials):
+    start = time.perf_counter()
+    for i in range(trials):
+        draw()
+    elapsed = time.perf_counter() - start
+    return "%s,%d,%f" % (name, trials, trials / elapsed)
+
+
+if __name__ == '__main__':
+    """
+    Reports how many random integers and group elements per second the math
+    modules produce.
+
+    :arg n: number of elements drawn per row.
+
+    Example invocation:
+    `$ python charm/test/benchmark/random_elements_bench.py 100000`
+    """
+    trials = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    int_group = IntegerGroupQ()
+    int_group.paramgen(1024)
+    ec_group = ECGroup(prime256v1)
+    print("function,n,PerSecond")
+    print(run_random("randomBits(64)", lambda: randomBits(64), trials))
+    print(run_random("randomBits(256)", lambda: randomBits(256), trials))
+    print(run_random("IntegerGroupQ.random", int_group.random, trials))
+    print(run_random("ECGroup.random(ZR)", lambda: ec_group.random(ZR), trials))
+    print(run_random("ECGroup.random(G)", lambda: ec_group.random(G), trials // 10))
+    try:
+        from charm.toolbox.pairinggroup import PairingGroup
+        pair_group = PairingGroup('BN254')
+    except Exception:
+        pair_group = None
+    if pair_group is not None:
+        from charm.toolbox.pairinggroup import ZR as PZR
+        print(run_random("PairingGroup.random(ZR)", lambda: pair_group.random(PZR), trials))
@@ -175,6 +175,13 @@ class Pai99Test(unittest.TestCase):
         orig_m = pai.decrypt(pk, sk, c5)
         if debug: print("m5 =>", orig_m, "\n")
 
+        # re-randomized ciphertexts keep the native context for later operations
+        c6 = c1.randomize()
+        assert c6 != c1 and c6.engine is c1.engine
+        assert pai.decrypt(pk, sk, c6 + c2) == m3
+        c7 = c1.randomize(12345)
+        assert c7.engine is c1.engine and pai.decrypt(pk, sk, c7) == m1
+
         messages = range(0, 10)
         cts = []
 
@@ -14,13 +14,14 @@ from charm.schemes.pksig.pksig_hess import Hess
 from charm.schemes.pksig.pksig_hw import HW
 from charm.schemes.pksig.pksig_rsa_hw09 import Sig_RSA_Stateless_HW09
 from charm.schemes.pksig.pksig_schnorr91 import SchnorrSig
+from charm.schemes.pksig import pksig_schnorr91
 from charm.schemes.pksig.pksig_waters05 import IBE_N04_Sig
 from charm.schemes.pksig.pksig_waters09 import IBEWaters09
 from charm.schemes.pksig.pksig_waters import WatersSig
 from charm.toolbox.pairinggroup import PairingGroup, ZR
 from charm.toolbox.ecgroup import ECGroup
 from charm.toolbox.eccurve import prime192v2
-from charm.toolbox.integergroup import integer
+from charm.toolbox.integergroup import integer,CRT,randomPrime
 from charm.toolbox.hash_module import Waters
 import unittest
 #import pytest
@@ -226,6 +227,21 @@ class ECDSATest(unittest.TestCase):
         assert ecdsa.verify(pk, sig, m), "Failed verification!"
         if debug: print("Signature Verified!!!")
 
+    def testECDSABatch(self):
+        groupObj = ECGroup(prime192v2)
+        ecdsa = ECDSA(groupObj)
+
+        keys = [ecdsa.keygen(0) for i in range(2)]
+        batch = []
+        for i in range(8):
+            (pk, sk) = keys[i % 2]
+            m = "message %d" % i
+            batch.append((pk, m, ecdsa.sign(pk, sk, m)))
+        assert all(ecdsa.batch_verify(batch)), "Failed batch verification!"
+
+        batch[5] = (keys[0][0], batch[5][1], batch[5][2])
+        assert ecdsa.batch_verify(batch) == [i != 5 for i in range(8)], "Failed to isolate the bad signature!"
+
 class HessTest(unittest.TestCase):
     def testHess(self):
        groupObj = PairingGroup('SS512')
@@ -297,6 +313,18 @@ class HWTest(unittest.TestCase):
 #        assert pksig.verify(pk, m2, sig2), "FAILED VERIFICATION!!!"
 #        if debug: print("Successful Verification!!!")
 
+class RSA_HW09FaultTest(unittest.TestCase):
+    def testFaultCheck(self):
+        pksig = Sig_RSA_Stateless_HW09()
+        p = integer(13075790812874903063868976368194105132206964291400106069285054021531242344673657224376055832139406140158530256050580761865568307154219348003780027259560207)
+        q = integer(12220150399144091059083151334113293594120344494042436487743750419696868216757186059428173175925369884682105191510729093971051869295857706815002710593321543)
+        (pk, sk) = pksig.keygen(1024, p, q)
+        m = SHA1(b'this is the message I want to hash.')
+        assert pksig.verify(pk, m, pksig.sign(pk, sk, m)), "FAILED VERIFICATION!!!"
+        # a CRT context with a wrong half stands in for a fault during signing
+        pksig.crt[(int(p), int(q))] = CRT(p, randomPrime(512))
+        self.assertRaises(Exception, pksig.sign, pk, sk, m)
+
 class SchnorrSigTest(unittest.TestCase):
     def testSchnorrSig(self):
         # test only parameters for p,q
@@ -314,6 +342,27 @@ class SchnorrSigTest(unittest.TestCase):
         assert pksig.verify(pk, sig, M), "Failed verification!"
         if debug: print("Signature verified!!!!")
 
+        keys = [(pk, sk), pksig.keygen()]
+        batch = []
+        for i in range(6):
+            (pk, sk) = keys[i % 2]
+            batch.append((pk, M, pksig.sign(pk, sk, M)))
+        assert all(pksig.batch_verify(batch)), "Failed batch verification!"
+
+        batch[3] = (keys[0][0], M, batch[3][2])
+        assert pksig.batch_verify(batch) == [i != 3 for i in range(6)], "Failed to isolate the bad signature!"
+
+        # r = -g^k is outside the order-q subgroup; two such sign flips must not cancel in a batch
+        (pk, sk) = keys[0]
+        forged = []
+        for i in range(2):
+            k = pksig_schnorr91.group.random()
+            r = integer(int(p) - int((pk['g'] ** k) % p), p)
+            e = pksig_schnorr91.group.hash(M, r)
+            forged.append((pk, M, {'e':e, 's':(k - sk * e) % q, 'r':r}))
+        assert not pksig.verify(pk, forged[0][2], M)
+        assert pksig.batch_verify(forged) == [False, False], "Accepted signatures outside the subgroup!"
+
 class IBE_N04_SigTest(unittest.TestCase):
     def testIBE_N04_Sig(self):
         # initialize the element object so that object references have global scope
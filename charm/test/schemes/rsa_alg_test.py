@@ -5,6 +5,7 @@
 from binascii import a2b_hex
 from charm.schemes.pkenc.pkenc_rsa import RSA_Enc, RSA_Sig
 from charm.toolbox.conversion import Conversion
+from charm.core.math.integer import CRT,randomPrime
 from charm.toolbox.securerandom import WeakRandom
 import unittest
 from random import Random
@@ -180,6 +181,16 @@ class Test(unittest.TestCase):
         (pk, sk) = rsa.keygen(1024)
         S = rsa.sign(sk, M)
         assert rsa.verify(pk, M, S)
+
+    def testRSASigFaultCheck(self):
+        rsa = RSA_Sig()
+        (pk, sk) = rsa.keygen(1024)
+        M = b'This is a test message.'
+        assert rsa.verify(pk, M, rsa.sign(sk, M))
+        # a context computing with the wrong q stands in for a fault in one CRT half
+        (crt, e) = rsa.crtContext(sk)
+        rsa.crt[(int(sk['p']), int(sk['q']), int(sk['d']))] = (CRT(sk['p'], randomPrime(512)), e)
+        self.assertRaises(Exception, rsa.sign, sk, M)
     
     
     def testPSSVector(self):
@@ -1,6 +1,6 @@
 from charm.core.engine.util import objectToBytes,bytesToObject
 from charm.toolbox.integergroup import IntegerGroup, integer
-from charm.toolbox.pairinggroup import PairingGroup
+from charm.toolbox.pairinggroup import PairingGroup,G1,G2
 from charm.toolbox.ecgroup import ECGroup
 from charm.toolbox.eccurve import prime192v1
 import unittest
@@ -26,6 +26,17 @@ class SerializeTest(unittest.TestCase):
         x=objectToBytes(data,groupobj)
         data2=bytesToObject(x,groupobj)
         self.assertEqual(data,data2)
+
+    def testPairingGroupCompression(self):
+        groupobj = PairingGroup('SS512')
+        elems = [groupobj.random(G1) for i in range(4)] + [groupobj.random(G2) for i in range(4)]
+
+        cmp = [groupobj.serialize(e) for e in elems]
+        raw = [groupobj.serialize(e, compression=False) for e in elems]
+        for c, r in zip(cmp, raw):
+            self.assertTrue(len(c) < len(r))
+        self.assertEqual(elems, groupobj.deserializeList(cmp))
+        self.assertEqual(elems, groupobj.deserializeList(raw, compression=False))
         
     def testECGroup(self):    
         groupObj = ECGroup(prime192v1)
@@ -2,9 +2,12 @@
 :Date: Aug 26, 2016
 :Authors: J. Ayo Akinyele
 '''
-from charm.toolbox.ecgroup import ECGroup,G
-from charm.toolbox.eccurve import prime192v1,prime192v2
+from charm.toolbox.ecgroup import ECGroup,G,ZR
+from charm.core.math.elliptic_curve import getGenerator
+from charm.toolbox.eccurve import prime192v1,prime192v2,prime256v1,secp256k1
 from charm.toolbox.securerandom import OpenSSLRand
+import os
+import threading
 import unittest
 
 runs = 10
@@ -49,5 +52,149 @@ class ECGroupEncodeAndDecode(unittest.TestCase):
         t = group.decode(g, True)
         assert s == t, "Failed to encode/decode properly"
 
+    def testPointListSerialize(self):
+        for curve in (prime192v1, prime256v1, secp256k1):
+            group = ECGroup(curve)
+            points = [group.random(G) * group.random(G) for i in range(runs)]
+            points.append(points[0] * (points[0] ** -1))
+            data = group.serializePoints(points)
+            assert len(data) % len(points) == 0
+            assert group.deserializePoints(data) == points, "Failed to decode list of points"
+            assert group.deserializePoints(group.serializePoints([])) == []
+            self.assertRaises(Exception, group.deserializePoints, data[:-1])
+
+    def testRawSerialize(self):
+        for curve in (prime192v1, prime256v1, secp256k1):
+            group = ECGroup(curve)
+            P = group.random(G)
+            for e in (P, group.random(ZR), P * (P ** -1), group.init(ZR, 0)):
+                data = group.serialize(e, format='raw')
+                assert group.deserialize(data) == e, "Failed to decode raw element"
+                assert group.deserialize(memoryview(bytearray(data))) == e
+            data = group.serialize(P, format='raw')
+            self.assertRaises(Exception, group.deserialize, data[:-1])
+            self.assertRaises(ValueError, group.serialize, P, format='hex')
+
+class ECGroupHashToCurve(unittest.TestCase):
+    # hash_to_curve test vectors from RFC 9380, appendix J
+    def testP256Vectors(self):
+        group = ECGroup(prime256v1)
+        dst = b'QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_'
+        x, y = group.coordinates(group.hash(b'', G, method='sswu', dst=dst))
+        assert int(x) == 0x2c15230b26dbc6fc9a37051158c95b79656e17a1a920b11394ca91c44247d3e4
+        assert int(y) == 0x8a7a74985cc5c776cdfe4b1f19884970453912e9d31528c060be9ab5c43e8415
+        x, y = group.coordinates(group.hash(b'abc', G, method='sswu', dst=dst))
+        assert int(x) == 0x0bb8b87485551aa43ed54f009230450b492fead5f1cc91658775dac4a3388a0f
+        assert int(y) == 0x5c41b3d0731a27a7b14bc0bf0ccded2d8751f83493404c84a88e71ffd424212e
+
+    def testSecp256k1Vectors(self):
+        group = ECGroup(secp256k1)
+        dst = b'QUUX-V01-CS02-with-secp256k1_XMD:SHA-256_SSWU_RO_'
+        x, y = group.coordinates(group.hash(b'', G, method='sswu', dst=dst))
+        assert int(x) == 0xc1cae290e291aee617ebaef1be6d73861479c48b841eaba9b7b5852ddfeb1346
+        assert int(y) == 0x64fa678e07ae116126f08b022a94af6de15985c996c3a91b64c406a960e51067
+
+    def testDefaultTag(self):
+        group = ECGroup(prime256v1)
+        h = group.hash('message', G, method='sswu')
+        assert h == group.hash(b'message', G, method='sswu')
+        assert h != group.hash('message', G)
+
+class ECGroupPrecomputation(unittest.TestCase):
+    def testFixedBase(self):
+        for curve in (prime256v1, secp256k1):
+            group = ECGroup(curve)
+            P = group.random(G)
+            xs = [group.random(ZR) for i in range(runs)]
+            expected = [P ** x for x in xs]
+            assert P.initPP()
+            assert expected == [P ** x for x in xs], "Failed fixed-base exponentiation"
+            assert P ** 3 == P * P * P
+
+    def testMultiExp(self):
+        group = ECGroup(secp256k1)
+        P = [group.random(G) for i in range(runs)]
+        x = [group.random(ZR) for i in range(runs)]
+        expected = P[0] ** x[0]
+        for i in range(1, runs):
+            expected *= P[i] ** x[i]
+        assert group.multiexp(P, x) == expected, "Failed multi-scalar multiplication"
+        assert group.multiexp(P[:2], [3, int(x[1])]) == (P[0] ** 3) * (P[1] ** x[1])
+
+    def testSecp256k1Native(self):
+        # the generic path on secp256k1 is native; the fixed-base table goes through OpenSSL
+        group = ECGroup(secp256k1)
+        n = int(group.order())
+        P = group.random(G)
+        Q = group.deserialize(group.serialize(P))
+        assert Q.initPP()
+        for x in [0, 1, 2, n - 1, n, n + 1, group.init(ZR, -3), 2 ** 256 - 1] + [group.random(ZR) for i in range(runs)]:
+            assert P ** x == Q ** x, "Failed native secp256k1 multiplication"
+        assert (P ** 0) ** 5 == P ** 0
+
+    def testGenerator(self):
+        group = ECGroup(prime256v1)
+        g = getGenerator(group.ec_group)
+        x = group.random(ZR)
+        assert g ** x == (g ** (x - 1)) * g
+        # an equal point that wasn't handed out by generator() takes the generic path
+        h = group.deserialize(group.serialize(g))
+        assert g ** x == h ** x
+
+    def testConcurrentInitPP(self):
+        # the table is built without the GIL: one caller stores it, the others fail cleanly
+        group = ECGroup(prime256v1)
+        P = group.random(G)
+        x = group.random(ZR)
+        expected = P ** x
+        results = []
+        def build():
+            try:
+                results.append(P.initPP())
+            except ValueError:
+                results.append(None)
+        threads = [threading.Thread(target=build) for i in range(8)]
+        for t in threads: t.start()
+        for t in threads: t.join()
+        assert results.count(True) == 1 and results.count(None) == 7
+        assert P ** x == expected
+
+class ECGroupZRArithmetic(unittest.TestCase):
+    def testMulAndExp(self):
+        for curve in (prime192v1, secp256k1):
+            group = ECGroup(curve)
+            n = int(group.order())
+            for i in range(runs):
+                a, b = group.random(ZR), group.random(ZR)
+                assert int(a * b) == int(a) * int(b) % n, "Failed ZR multiplication"
+                assert int(a ** b) == pow(int(a), int(b), n), "Failed ZR exponentiation"
+                assert int(a * 7) == int(a) * 7 % n
+                assert int(a * (n + 5)) == int(a) * 5 % n
+
+    def testBatchInvert(self):
+        group = ECGroup(secp256k1)
+        xs = [group.random(ZR) for i in range(runs)]
+        assert [int(x * y) for x, y in zip(xs, group.batch_invert(xs))] == [1] * runs
+        assert group.batch_invert([]) == []
+        self.assertRaises(Exception, group.batch_invert, [xs[0], xs[0] - xs[0]])
+
+class ECGroupRandom(unittest.TestCase):
+    @unittest.skipUnless(hasattr(os, 'fork'), "requires os.fork")
+    def testForkSafety(self):
+        group = ECGroup(secp256k1)
+        for t in (ZR, G):
+            group.random(t)
+            r, w = os.pipe()
+            pid = os.fork()
+            if pid == 0:
+                os.close(r)
+                os.write(w, group.serialize(group.random(t)))
+                os._exit(0)
+            os.close(w)
+            child = os.read(r, 4096)
+            os.close(r)
+            os.waitpid(pid, 0)
+            assert group.serialize(group.random(t)) != child, "Parent and child share a random stream after fork"
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,323 @@
+from charm.toolbox.integergroup import IntegerGroupQ,RSAGroup,integer,isPrime,random,randomPrime,randomBits,bitsize,Paillier,IntegerVector,CRT,powm_public,multiexp,multiexp_sec
+import functools
+import operator
+import os
+import time
+import unittest
+
+runs = 10
+
+def forkedDraws(draw):
+    # returns what the parent and a forked child draw next, as strings
+    draw()
+    r, w = os.pipe()
+    pid = os.fork()
+    if pid == 0:
+        os.close(r)
+        os.write(w, str(draw()).encode())
+        os._exit(0)
+    os.close(w)
+    child = b''
+    while True:
+        data = os.read(r, 4096)
+        if not data: break
+        child += data
+    os.close(r)
+    os.waitpid(pid, 0)
+    return str(draw()), child.decode()
+
+class IntegerGroupRandom(unittest.TestCase):
+    @unittest.skipUnless(hasattr(os, 'fork'), "requires os.fork")
+    def testForkSafety(self):
+        group = IntegerGroupQ()
+        group.paramgen(256)
+        for draw in (lambda: randomBits(256), group.random, group.randomGen):
+            parent, child = forkedDraws(draw)
+            assert parent != child, "Parent and child share a random stream after fork"
+
+    def testRandomRange(self):
+        assert set(randomBits(2) for i in range(200)) == {0, 1, 2, 3}
+        assert all(0 <= int(random(5)) < 5 for i in range(runs))
+        assert randomBits(300) < 2 ** 300
+
+class IntegerGroupParamgen(unittest.TestCase):
+    def testSafePrime(self):
+        for threads in (1, 4):
+            group = IntegerGroupQ()
+            group.paramgen(256, threads=threads)
+            assert group.p == 2 * group.q + 1 and bitsize(group.p) == 256
+            assert isPrime(group.p) and isPrime(group.q), "Failed to generate a safe prime"
+
+    def testRandomPrime(self):
+        for bits in (2, 3, 17, 64, 512):
+            for i in range(runs):
+                p = randomPrime(bits)
+                assert isPrime(p) and bitsize(p) == bits, "Failed to generate a %d-bit prime" % bits
+        assert randomPrime(3, 1) == 7
+        self.assertRaises(Exception, randomPrime, 1)
+        self.assertRaises(Exception, randomPrime, 2, 1)
+
+class IntegerGroupMultiExp(unittest.TestCase):
+    def setUp(self):
+        self.group = IntegerGroupQ()
+        self.group.paramgen(512)
+
+    def testMultiExp(self):
+        group = self.group
+        for n in (1, 2, runs, 100):
+            g = [group.randomGen() for i in range(n)]
+            x = [group.random() for i in range(n)]
+            expected = g[0] ** x[0]
+            for i in range(1, n):
+                expected *= g[i] ** x[i]
+            assert group.multiexp(g, x) == expected, "Failed multi-exponentiation"
+            assert group.multiexp_sec(g, x) == expected, "Failed constant-time multi-exponentiation"
+        g = group.randomGen()
+        assert group.multiexp([g, g], [3, -1]) == g ** 2
+        assert group.multiexp([], []) == integer(1, group.p)
+
+    def testPippenger(self):
+        # enough bases that multiexp_choose switches from Straus to Pippenger buckets
+        group = self.group
+        p = int(group.p)
+        for n in (500, 1200):
+            g = [group.randomGen() for i in range(n)]
+            x = [group.random() for i in range(n)]
+            # repeated and zero exponents land in shared and skipped buckets
+            x[1] = x[0]
+            x[2] = 0
+            expected = functools.reduce(lambda acc, i: acc * pow(int(g[i]), int(x[i]), p) % p, range(n), 1)
+            assert int(group.multiexp(g, x)) == expected, "Failed Pippenger multi-exponentiation"
+        assert int(group.multiexp_sec(g[:500], x[:500])) == functools.reduce(
+            lambda acc, i: acc * pow(int(g[i]), int(x[i]), p) % p, range(500), 1)
+
+    def testEvenModulus(self):
+        # no Montgomery form: the kernels fall back to plain reduction
+        m = 2 ** 130 * int(randomPrime(256))
+        for n in (1, runs, 600):
+            b = [int(random(m)) for i in range(n)]
+            x = [int(randomBits(512)) for i in range(n)]
+            expected = functools.reduce(lambda acc, i: acc * pow(b[i], x[i], m) % m, range(n), 1)
+            assert int(multiexp(b, x, m)) == expected, "Failed multi-exponentiation mod an even number"
+            assert int(multiexp_sec(b, x, m)) == expected
+        assert int(multiexp([5, 7], [0, 0], m)) == 1
+
+    def testMismatchedLists(self):
+        g = self.group.randomGen()
+        self.assertRaises(Exception, self.group.multiexp, [g, g], [1])
+
+    def testFixedBase(self):
+        group = self.group
+        g = group.randomGen()
+        h = integer(int(g), group.p)
+        assert h.initPP()
+        bits = bitsize(group.p)
+        for x in [0, 1, 2 ** bits - 1, 2 ** (bits - 1)] + [group.random() for i in range(runs)]:
+            assert h ** x == g ** x, "Failed fixed-base exponentiation"
+        # exponents the table does not cover fall back to mpz_powm_sec
+        assert h ** (2 ** bits + 5) == g ** (2 ** bits + 5)
+
+class IntegerGroupSerialize(unittest.TestCase):
+    def testRawSerialize(self):
+        group = IntegerGroupQ()
+        group.paramgen(256)
+        for e in (group.randomGen(), group.random(), integer(-3, group.p), integer(7, 5), integer(-7), integer(0)):
+            data = group.serialize(e, format='raw')
+            assert group.deserialize(data) == e, "Failed to decode raw integer"
+            assert group.deserialize(memoryview(bytearray(data))) == e
+        g = group.randomGen()
+        assert len(group.serialize(g, format='raw')) < len(group.serialize(g)) // 2
+        assert group.deserialize(group.serialize(g)) == g
+        self.assertRaises(Exception, group.deserialize, group.serialize(g, format='raw')[:-1])
+        data = group.serialize(g, format='raw')
+        for bit in (0x10, 0x20, 0x40):
+            self.assertRaises(Exception, group.deserialize, bytes([data[0] | bit]) + data[1:])
+        self.assertRaises(ValueError, group.serialize, g, format='hex')
+
+    def testContextModulus(self):
+        group = RSAGroup()
+        (p, q, n) = group.paramgen(256)
+        c = random(n * n)
+        data = group.serialize(c, format='raw')
+        assert group.deserialize(data) == c
+        # the modulus was referenced from the group, so a reader without it can't decode
+        self.assertRaises(Exception, RSAGroup().deserialize, data)
+
+    def testListSerialize(self):
+        group = IntegerGroupQ()
+        group.paramgen(256)
+        elems = [group.randomGen() for i in range(runs)] + [integer(1, group.p)]
+        data = group.serializeList(elems)
+        assert group.deserializeList(data) == elems, "Failed to decode list of integers"
+        assert group.deserializeList(group.serializeList([])) == []
+        self.assertRaises(Exception, group.deserializeList, data[:-1])
+        self.assertRaises(Exception, group.deserializeList, bytes([data[0] | 0x01]) + data[1:])
+        self.assertRaises(Exception, group.deserializeList, bytes([data[0] | 0x40]) + data[1:])
+        self.assertRaises(Exception, group.serializeList, [elems[0], group.random()])
+
+class IntegerCRT(unittest.TestCase):
+    def testPowm(self):
+        p, q = randomPrime(256), randomPrime(256)
+        P, Q = int(p), int(q)
+        N = P * Q
+        crt = CRT(p, q)
+        bases = [int(randomBits(500)), N + 12345, 3 * N + 1, P, 7 * Q, 0, 1]
+        exps = [0, 1, 2, P - 1, P, (P - 1) * (Q - 1), 3 * (P - 1), int(randomBits(1024))]
+        for x in bases:
+            for d in exps:
+                assert int(crt.powm(x, d)) == pow(x, d, N), "Failed CRT exponentiation mod n"
+                assert int(crt.powm_n2(x, d)) == pow(x, d, N * N), "Failed CRT exponentiation mod n^2"
+        x, d = integer(int(randomBits(500)), p * q), int(randomBits(512))
+        assert crt.powm(x, d) == x ** d
+        assert crt.powm_n2(x, d) == integer(int(x), p * p * q * q) ** d
+        self.assertRaises(Exception, crt.powm, x, -1)
+        self.assertRaises(Exception, CRT, p, p)
+
+class IntegerPowmPublic(unittest.TestCase):
+    def testPowmPublic(self):
+        p, q = randomPrime(256), randomPrime(256)
+        n = p * q
+        N = int(n)
+        for i in range(runs):
+            x, e = integer(int(randomBits(500)), n), int(randomBits(512))
+            assert powm_public(x, e) == x ** e, "Failed public-exponent exponentiation"
+            assert powm_public(x, integer(e)) == x ** e
+        x = integer(int(randomBits(500)), n)
+        assert int(powm_public(x, 0)) == 1
+        assert int(powm_public(x, -3)) == pow(int(x), -3, N), "Failed negative exponent"
+        # p shares a factor with n, so it has no inverse
+        self.assertRaises(Exception, powm_public, integer(int(p), n), -1)
+        assert int(powm_public(integer(int(p), n), 2)) == int(p) ** 2 % N
+        self.assertRaises(Exception, powm_public, integer(5), 3)
+
+class IntegerBatchInvert(unittest.TestCase):
+    def testBatchInvert(self):
+        group = IntegerGroupQ()
+        group.paramgen(256)
+        xs = [group.random() for i in range(runs)]
+        invs = group.batch_invert(xs)
+        assert len(invs) == len(xs) and all(x * inv == 1 for x, inv in zip(xs, invs)), "Failed batch inversion"
+        assert group.batch_invert([]) == []
+        self.assertRaises(Exception, group.batch_invert, xs[:2] + [integer(0, group.q)])
+        # 3 shares a factor with 15, so the whole batch has no inverse
+        self.assertRaises(Exception, group.batch_invert, [integer(2, 15), integer(3, 15)])
+
+class IntegerPaillier(unittest.TestCase):
+    def setUp(self):
+        self.p, self.q, self.n = RSAGroup().paramgen(512)
+        self.N = int(self.n)
+
+    def lamdaDecrypt(self, c):
+        # textbook decryption with g = n + 1: m = L(c^lambda mod n^2) * lambda^-1 mod n
+        N, lam = self.N, (int(self.p) - 1) * (int(self.q) - 1)
+        return (pow(int(c), lam, N * N) - 1) // N * pow(lam, -1, N) % N
+
+    def testEncryptDecrypt(self):
+        for pool in (0, 8):
+            ctx = Paillier(self.n, self.p, self.q, pool=pool)
+            pub = Paillier(self.n, pool=pool)
+            for m in [0, 1, 2, self.N - 1, self.N, -5] + [int(randomBits(500)) for i in range(runs)]:
+                for c in (ctx.encrypt(m), pub.encrypt(m)):
+                    assert self.lamdaDecrypt(c) == m % self.N, "Failed Paillier encryption"
+                    assert int(ctx.decrypt(c)) == m % self.N, "Failed CRT decryption"
+            assert ctx.encrypt(7) != ctx.encrypt(7)
+        self.assertRaises(Exception, pub.decrypt, ctx.encrypt(1))
+        self.assertRaises(Exception, Paillier, self.n, self.p)
+        self.assertRaises(Exception, Paillier, self.n, self.p, self.p)
+        # 15 * 7 = 105, but 15 is not prime
+        self.assertRaises(Exception, Paillier, 105, 15, 7)
+        self.assertRaises(Exception, Paillier(self.n).__init__, self.n)
+
+    def testHomomorphic(self):
+        ctx = Paillier(self.n, self.p, self.q)
+        a, b = ctx.encrypt(1000), ctx.encrypt(234)
+        assert int(ctx.decrypt(ctx.add(a, b))) == 1234
+        assert int(ctx.decrypt(ctx.add_plain(a, 24))) == 1024
+        assert int(ctx.decrypt(ctx.add_plain(a, -1001))) == self.N - 1
+        assert int(ctx.decrypt(ctx.mul_plain(b, 3))) == 702
+        assert int(ctx.decrypt(ctx.mul_plain(b, 0))) == 0
+        assert int(ctx.decrypt(ctx.mul_plain(b, -1))) == self.N - 234
+        c = ctx.rerandomize(a)
+        assert c != a and int(ctx.decrypt(c)) == 1000
+
+    def testPool(self):
+        ctx = Paillier(self.n, self.p, self.q, pool=16, threads=0)
+        assert ctx.pooled() == 0
+        assert ctx.precompute(5) == 5
+        assert ctx.precompute() == 16
+        ctx.encrypt(1)
+        assert ctx.pooled() == 15
+        self.assertRaises(Exception, Paillier(self.n).precompute)
+        ctx = Paillier(self.n, pool=4, threads=2)
+        deadline = time.time() + 30
+        while ctx.pooled() < 4 and time.time() < deadline:
+            time.sleep(0.01)
+        assert ctx.pooled() == 4, "Workers did not fill the pool"
+        assert all(self.lamdaDecrypt(ctx.encrypt(m)) == m for m in range(runs))
+
+    @unittest.skipUnless(hasattr(os, 'fork'), "requires os.fork")
+    def testForkSafety(self):
+        for threads in (0, 1):
+            ctx = Paillier(self.n, self.p, self.q, pool=8, threads=threads)
+            ctx.precompute()
+            parent, child = forkedDraws(lambda: ctx.encrypt(1))
+            assert parent != child, "Parent and child share pooled randomness after fork"
+
+class IntegerVectorOps(unittest.TestCase):
+    def setUp(self):
+        # 300 values mod a 2048-bit prime are enough work to take the threaded path
+        self.m = randomPrime(2048)
+        self.M = int(self.m)
+        self.xs = [integer(int(randomBits(2047)), self.m) for i in range(300)]
+        self.ys = [int(randomBits(2047)) for i in range(300)]
+
+    def testElementwise(self):
+        M, xv, yv = self.M, IntegerVector(self.xs), IntegerVector(self.ys, self.m)
+        assert len(xv) == 300 and xv[0] == self.xs[0] and xv[-1] == self.xs[-1]
+        assert [int(z) for z in xv * yv] == [int(x) * y % M for x, y in zip(self.xs, self.ys)]
+        assert [int(z) for z in xv + yv] == [(int(x) + y) % M for x, y in zip(self.xs, self.ys)]
+        assert [int(z) for z in xv * 3] == [int(z) for z in 3 * xv] == [int(x) * 3 % M for x in self.xs]
+        ev = IntegerVector([int(randomBits(160)) for i in range(runs)])
+        assert [int(z) for z in IntegerVector(self.xs[:runs]) ** ev] == [pow(int(x), int(e), M) for x, e in zip(self.xs, ev)]
+        assert [int(z) for z in IntegerVector(self.xs[:runs]) ** -2] == [pow(int(x), -2, M) for x in self.xs[:runs]]
+        self.assertRaises(Exception, lambda: xv * IntegerVector(self.ys[:2], self.m))
+        self.assertRaises(Exception, lambda: xv * IntegerVector(self.ys))
+        self.assertRaises(Exception, lambda: IntegerVector(self.ys) ** 2)
+        self.assertRaises(Exception, IntegerVector, [self.xs[0], integer(1, 7)])
+        self.assertRaises(Exception, xv.__init__, self.ys[:2])
+        assert len(xv) == 300 and xv[0] == self.xs[0], "re-initialization modified the vector"
+
+    def testReductions(self):
+        M, xv = self.M, IntegerVector(self.xs)
+        prod = 1
+        for x in self.xs:
+            prod = prod * int(x) % M
+        assert int(xv.prod()) == prod and xv.prod() == integer(prod, self.m), "Failed vector product"
+        assert int(xv.sum()) == sum(int(x) for x in self.xs) % M
+        assert int(IntegerVector(self.ys).prod()) == functools.reduce(operator.mul, self.ys)
+        assert int(IntegerVector([10, 4], 12).prod()) == 4
+        assert int(IntegerVector([]).prod()) == 1 and int(IntegerVector([]).sum()) == 0
+
+    def testBytes(self):
+        xv = IntegerVector(self.xs)
+        data = xv.toBytes()
+        assert len(data) == 300 * 256
+        assert data[:256] == int(self.xs[0]).to_bytes(256, 'big')
+        assert IntegerVector.fromBytes(data, modulus=self.m) == xv
+        assert IntegerVector.fromBytes(xv.toBytes(300), 300, self.m) == xv
+        assert [int(z) for z in IntegerVector.fromBytes(data, 256)] == [int(x) for x in self.xs]
+        assert IntegerVector([1, 2 ** 20]).toBytes() == bytes([0, 0, 1, 16, 0, 0])
+        self.assertRaises(Exception, IntegerVector.fromBytes, data[:-1], modulus=self.m)
+        self.assertRaises(Exception, IntegerVector.fromBytes, data)
+        self.assertRaises(Exception, IntegerVector.fromBytes, b'\xff' * 256, modulus=self.m)
+        self.assertRaises(Exception, IntegerVector([-1]).toBytes)
+        self.assertRaises(Exception, xv.toBytes, 100)
+
+    def testPaillierSum(self):
+        p, q, n = RSAGroup().paramgen(512)
+        ctx = Paillier(n, p, q)
+        votes = [int(randomBits(3)) for i in range(50)]
+        assert int(ctx.decrypt(IntegerVector([ctx.encrypt(v) for v in votes]).prod())) == sum(votes)
+
+if __name__ == "__main__":
+    unittest.main()
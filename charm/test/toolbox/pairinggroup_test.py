@@ -0,0 +1,94 @@
+from charm.toolbox.pairinggroup import PairingGroup,ZR,G1,G2,GT,pair
+from charm.config import libs,pairing_lib
+import charm.core.math.pairing as pg
+import functools
+import operator
+import unittest
+
+runs = 5
+
+@unittest.skipUnless(pairing_lib == libs.miracl, "multiexp has a native kernel only on the MIRACL backend")
+class PairingGroupMultiExp(unittest.TestCase):
+    def setUp(self):
+        self.group = PairingGroup(pg.curve)
+        # G2 is G1 on the symmetric SS curve
+        self.types = (G1, GT) if pg.curve == 'SS512' else (G1, G2, GT)
+
+    def naive(self, bases, exps):
+        return functools.reduce(operator.mul, [b ** e for b, e in zip(bases, exps)])
+
+    def sample(self, gtype, n):
+        group = self.group
+        if gtype == GT:
+            return [pair(group.random(G1), group.random(G2)) for i in range(n)]
+        return [group.random(gtype) for i in range(n)]
+
+    def testMultiExp(self):
+        group = self.group
+        for gtype in self.types:
+            for n in (1, 2, 5, 40):
+                bases = self.sample(gtype, n)
+                exps = [group.random(ZR) for j in range(n)]
+                assert group.multiexp(bases, exps) == self.naive(bases, exps), "multiexp does not match the product of powers"
+                # straight into the kernel, with int exponents
+                ints = [int(x) for x in exps]
+                assert pg.multiexp(group.Pairing, bases, ints) == self.naive(bases, exps)
+
+    def testZeroExponent(self):
+        group = self.group
+        for gtype in self.types:
+            bases = self.sample(gtype, 3)
+            exps = [group.random(ZR), group.init(ZR, 0), 0]
+            assert group.multiexp(bases, exps) == bases[0] ** exps[0], "zero exponents must contribute the identity"
+            assert group.multiexp(bases[1:], exps[1:]) == bases[1] ** 0, "all-zero exponents must give the identity"
+
+    def testInvalidLists(self):
+        group = self.group
+        bases = self.sample(G1, 3)
+        exps = [group.random(ZR) for j in range(3)]
+        for call in (group.multiexp, lambda b, e: pg.multiexp(group.Pairing, b, e)):
+            with self.assertRaises(Exception):
+                call([], [])
+            with self.assertRaises(Exception):
+                call(bases, exps[:2])
+            with self.assertRaises(Exception):
+                call(bases[:2], exps)
+        with self.assertRaises(Exception):
+            pg.multiexp(group.Pairing, [bases[0], self.sample(GT, 1)[0]], exps[:2])
+
+@unittest.skipUnless(pairing_lib == libs.miracl, "requires the MIRACL backend")
+class PairingGroupMiraclSerialize(unittest.TestCase):
+    def testIdentity(self):
+        group = PairingGroup(pg.curve)
+        # G2 is G1 on the symmetric SS curve
+        types = (G1,) if pg.curve == 'SS512' else (G1, G2)
+        elems = [group.init(t) for t in types] + [pair(group.random(G1), group.random(G2)) ** 0]
+        for e in elems:
+            data = group.serialize(e)
+            d = group.deserialize(data)
+            assert d == e, "Failed to decode the identity"
+            assert d * d == d
+        for t in types:
+            g = group.random(t)
+            assert group.deserialize(group.serialize(g)) == g
+            assert group.serialize(g) != group.serialize(group.init(t))
+
+@unittest.skipUnless(pairing_lib == libs.relic, "requires the RELIC backend")
+class PairingGroupRelicSerialize(unittest.TestCase):
+    def testCompressed(self):
+        group = PairingGroup('BN254')
+        for t in (G1, G2):
+            elems = [group.random(t) for i in range(runs)] + [group.init(t)]
+            for e in elems:
+                data = group.serialize(e)
+                assert len(data) < len(group.serialize(e, compression=False)), "Failed to compress"
+                assert group.deserialize(data) == e, "Failed to decode a compressed point"
+                # encodings written before compression became the default
+                assert group.deserialize(group.serialize(e, compression=False)) == e
+                assert group.deserialize(group.serialize(e, compression=False), compression=False) == e
+            assert group.deserializeList([group.serialize(e) for e in elems]) == elems
+            assert group.deserializeList([group.serialize(e, compression=False) for e in elems]) == elems
+            self.assertRaises(Exception, group.deserializeList, [group.serialize(elems[0])[:-4]])
+
+if __name__ == "__main__":
+    unittest.main()
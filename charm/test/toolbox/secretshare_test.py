@@ -24,5 +24,11 @@ class SecretShareTest(unittest.TestCase):
           assert K == secret, "Could not recover the secret!"
           if debug: print("Successfully recovered secret: ", secret)
 
+    def testBatchInvert(self):
+          group = PairingGroup('SS512')
+          xs = [group.random(ZR) for i in range(5)]
+          for x, y in zip(xs, group.batch_invert(xs)):
+              assert x * y == group.init(ZR, 1), "Failed batch inversion"
+
 if __name__ == "__main__":
     unittest.main()
@@ -54,3 +54,18 @@ class PKSig(SchemeBase):
     
     def verify(self, pk, message, sig):
         raise NotImplementedError
+
+    def batch_verify(self, batch):
+        """verifies a list of (pk, message, sig) tuples and returns one boolean per entry.
+        Schemes with a cheaper combined check override this."""
+        return [self.verify(pk, sig, message) for (pk, message, sig) in batch]
+
+    def bisect_batch(self, batch, check):
+        """runs the combined check over the batch and, when it fails, over each half in turn
+        until the invalid signatures are isolated. Returns one boolean per entry."""
+        if check(batch):
+            return [True] * len(batch)
+        if len(batch) == 1:
+            return [False]
+        mid = len(batch) // 2
+        return self.bisect_batch(batch[:mid], check) + self.bisect_batch(batch[mid:], check)
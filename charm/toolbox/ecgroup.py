@@ -1,5 +1,5 @@
 try:
-   from charm.core.math.elliptic_curve import elliptic_curve,ec_element,ZR,G,init,random,order,getGenerator,bitsize,serialize,deserialize,hashEC,encode,decode,getXY
+   from charm.core.math.elliptic_curve import elliptic_curve,ec_element,ZR,G,init,random,order,getGenerator,bitsize,serialize,deserialize,hashEC,hashToCurve,encode,decode,getXY,multiexp,batch_invert,serializePoints,deserializePoints
    import charm.core.math.elliptic_curve as ecc
 except Exception as err:
    print(err)
@@ -51,19 +51,37 @@ class ECGroup():
         """decode a group element into a string"""
         return decode(self.ec_group, msg_bytes, include_ctr)
     
-    def serialize(self, object):
-        """serializes a pairing object into bytes"""        
-        return serialize(object)
+    def serialize(self, object, format='base64'):
+        """serializes a pairing object into bytes. With format='raw' the result is
+        a type byte followed by a fixed-length compressed point or scalar"""
+        if format not in ('base64', 'raw'):
+            raise ValueError("unknown serialization format: {}".format(format))
+        return serialize(object, format == 'raw')
     
     def deserialize(self, bytes_object):
-        """deserializes into a pairing object"""        
+        """deserializes into a pairing object. Raw encodings are also accepted
+        from any bytes-like object (bytearray, memoryview, ...)"""
         return deserialize(self.ec_group, bytes_object)
 
-    def hash(self, args, target_type=ZR):
+    def serializePoints(self, points):
+        """serializes a list of points into a single buffer of compressed points"""
+        return serializePoints(self.ec_group, points)
+
+    def deserializePoints(self, bytes_object):
+        """deserializes a buffer written by serializePoints into a list of points"""
+        return deserializePoints(self.ec_group, bytes_object)
+
+    def hash(self, args, target_type=ZR, method=None, dst=None):
         """hashes objects into ZR or G
 
         Different object types may hash to the same element, e.g., the ASCII
-        string 'str' and the byte string b'str' map to the same element."""
+        string 'str' and the byte string b'str' map to the same element.
+
+        :param method: 'sswu' hashes into G following RFC 9380 (simplified SWU,
+             random oracle encoding). Only supported on prime256v1, secp384r1,
+             secp521r1 and secp256k1.
+        :param dst: domain separation tag for the 'sswu' method. Defaults to
+             a charm specific tag for the curve suite."""
         def hash_encode(arg):
             """encode a data type to bytes"""
             if type(arg) is bytes:
@@ -92,8 +110,27 @@ class ECGroup():
 
             return s
 
+        if method == 'sswu':
+            if target_type != G:
+                raise ValueError("'sswu' can only hash into G")
+            if dst is not None:
+                return hashToCurve(self.ec_group, hash_encode(args), dst)
+            return hashToCurve(self.ec_group, hash_encode(args))
+        elif method is not None:
+            raise ValueError("unknown hash method: {}".format(method))
         return hashEC(self.ec_group, hash_encode(args), target_type)
 
+    def multiexp(self, points, scalars):
+        """computes the product of points[i] ** scalars[i] in a single call.
+        Scalars can be ZR elements or ints. Not constant time: use it with
+        public scalars only (e.g., signature verification)"""
+        return multiexp(self.ec_group, points, scalars)
+
+    def batch_invert(self, elems):
+        """takes a list of ZR elements and returns the list of their inverses,
+        computed with a single modular inversion"""
+        return batch_invert(self.ec_group, elems)
+
     def zr(self, point):
         """get the X coordinate only"""
         if type(point) == ec_element:
@@ -24,13 +24,11 @@ class IntegerGroup:
         outStr += "q = " + str(self.q) + "\n"
         return outStr
         
-    def paramgen(self, bits, r=2):
-        # determine which group
-        while True:
-            self.p = randomPrime(bits, 1)
-            self.q = (self.p - 1) / 2
-            if (isPrime(self.p) and isPrime(self.q)):
-                break
+    def paramgen(self, bits, r=2, threads=0):
+        """generates a safe prime p = 2q + 1 of the given size; the prime search
+        runs on the given number of threads (default: one per online CPU)"""
+        self.p = randomPrime(bits, 1, threads)
+        self.q = (self.p - 1) / 2
         self.r = r
         return None    
     
@@ -69,13 +67,33 @@ class IntegerGroup:
     def decode(self, element):
         return decode(element, self.p, self.q)
 
-    def serialize(self, object):
+    def serialize(self, object, format='base64'):
+        """serializes an integer into bytes. With format='raw' the result is a sign
+        byte and a fixed-width big-endian value, and a modulus of p or q is referenced
+        from the group instead of being written out"""
         assert type(object) == integer, "cannot serialize non-integer types"
+        if format not in ('base64', 'raw'):
+            raise ValueError("unknown serialization format: {}".format(format))
+        if format == 'raw':
+            return serialize(object, True, self._context())
         return serialize(object)
     
     def deserialize(self, bytes_object):
-        assert type(bytes_object) == bytes, "cannot deserialize object"
-        return deserialize(bytes_object)
+        """deserializes either format. Raw encodings are also accepted from any
+        bytes-like object (bytearray, memoryview, ...)"""
+        return deserialize(bytes_object, self._context())
+
+    def serializeList(self, elems):
+        """serializes a list of integers that share a modulus into a single raw buffer"""
+        return serializeList(elems, self._context())
+
+    def deserializeList(self, bytes_object):
+        """deserializes a buffer written by serializeList into a list of integers"""
+        return deserializeList(bytes_object, self._context())
+
+    def _context(self):
+        """moduli that raw encodings reference by index"""
+        return tuple(m for m in (getattr(self, 'p', None), getattr(self, 'q', None)) if m is not None)
     
     def hash(self, *args):
         if isinstance(args, tuple):
@@ -83,6 +101,19 @@ class IntegerGroup:
             return hashInt(args, self.p, self.q, False)
         return None
 
+    def batch_invert(self, elems):
+        """inverts a list of integers that share a modulus with a single modular inversion"""
+        return batch_invert(elems)
+
+    def multiexp(self, bases, exps):
+        """computes the product of bases[i] ** exps[i] mod p in a single call.
+        Not constant time: use it with public exponents only (e.g., verification)"""
+        return multiexp(bases, exps, self.p)
+
+    def multiexp_sec(self, bases, exps):
+        """multiexp for secret exponents, with fixed windows and constant-time table reads"""
+        return multiexp_sec(bases, exps, self.p)
+
     def InitBenchmark(self):
         """initiates the benchmark state"""
         return InitBenchmark()
@@ -124,13 +155,11 @@ class IntegerGroupQ:
             print("p and q are not safe primes!")
         return False
         
-    def paramgen(self, bits, r=2):
-        # determine which group
-        while True:
-            self.p = randomPrime(bits, 1)
-            self.q = (self.p - 1) / 2
-            if (isPrime(self.p) and isPrime(self.q)):
-                break
+    def paramgen(self, bits, r=2, threads=0):
+        """generates a safe prime p = 2q + 1 of the given size; the prime search
+        runs on the given number of threads (default: one per online CPU)"""
+        self.p = randomPrime(bits, 1, threads)
+        self.q = (self.p - 1) / 2
         self.r = r
         return None    
     
@@ -181,13 +210,46 @@ class IntegerGroupQ:
             List.append(i)
         return hashInt(tuple(List), self.p, self.q, True)
 
-    def serialize(self, object):
+    def batch_invert(self, elems):
+        """inverts a list of integers that share a modulus with a single modular inversion"""
+        return batch_invert(elems)
+
+    def multiexp(self, bases, exps):
+        """computes the product of bases[i] ** exps[i] mod p in a single call.
+        Not constant time: use it with public exponents only (e.g., verification)"""
+        return multiexp(bases, exps, self.p)
+
+    def multiexp_sec(self, bases, exps):
+        """multiexp for secret exponents, with fixed windows and constant-time table reads"""
+        return multiexp_sec(bases, exps, self.p)
+
+    def serialize(self, object, format='base64'):
+        """serializes an integer into bytes. With format='raw' the result is a sign
+        byte and a fixed-width big-endian value, and a modulus of p or q is referenced
+        from the group instead of being written out"""
         assert type(object) == integer, "cannot serialize non-integer types"
+        if format not in ('base64', 'raw'):
+            raise ValueError("unknown serialization format: {}".format(format))
+        if format == 'raw':
+            return serialize(object, True, self._context())
         return serialize(object)
     
     def deserialize(self, bytes_object):
-        assert type(bytes_object) == bytes, "cannot deserialize object"
-        return deserialize(bytes_object)
+        """deserializes either format. Raw encodings are also accepted from any
+        bytes-like object (bytearray, memoryview, ...)"""
+        return deserialize(bytes_object, self._context())
+
+    def serializeList(self, elems):
+        """serializes a list of integers that share a modulus into a single raw buffer"""
+        return serializeList(elems, self._context())
+
+    def deserializeList(self, bytes_object):
+        """deserializes a buffer written by serializeList into a list of integers"""
+        return deserializeList(bytes_object, self._context())
+
+    def _context(self):
+        """moduli that raw encodings reference by index"""
+        return tuple(m for m in (getattr(self, 'p', None), getattr(self, 'q', None)) if m is not None)
 
     def InitBenchmark(self):
         """initiates the benchmark state"""
@@ -244,13 +306,34 @@ class RSAGroup:
             print("p and q are not primes!")
         return False
 
-    def serialize(self, object):
+    def serialize(self, object, format='base64'):
+        """serializes an integer into bytes. With format='raw' the result is a sign
+        byte and a fixed-width big-endian value, and a modulus of n or n^2 is referenced
+        from the group instead of being written out"""
         assert type(object) == integer, "cannot serialize non-integer types"
+        if format not in ('base64', 'raw'):
+            raise ValueError("unknown serialization format: {}".format(format))
+        if format == 'raw':
+            return serialize(object, True, self._context())
         return serialize(object)
     
     def deserialize(self, bytes_object):
-        assert type(bytes_object) == bytes, "cannot deserialize object"
-        return deserialize(bytes_object)
+        """deserializes either format. Raw encodings are also accepted from any
+        bytes-like object (bytearray, memoryview, ...)"""
+        return deserialize(bytes_object, self._context())
+
+    def serializeList(self, elems):
+        """serializes a list of integers that share a modulus into a single raw buffer"""
+        return serializeList(elems, self._context())
+
+    def deserializeList(self, bytes_object):
+        """deserializes a buffer written by serializeList into a list of integers"""
+        return deserializeList(bytes_object, self._context())
+
+    def _context(self):
+        """moduli that raw encodings reference by index"""
+        if not self.n: return ()
+        return (self.n, self.n * self.n)
 
     def random(self, max=0):
         if max == 0:
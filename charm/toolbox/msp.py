@@ -102,14 +102,20 @@ class MSP:
 
         coeff = {}
         list2 = [self.group.init(ZR, i) for i in list]
+        # same Lagrange computation as SecretUtil.recoverCoefficients
+        nums, dens = [], []
         for i in list2:
-            result = 1
+            num, den = 1, 1
             for j in list2:
                 if not (i == j):
-                    # lagrange basis poly
-                    result *= (0 - j) / (i - j)
-                    #                print("coeff '%d' => '%s'" % (i, result))
-            coeff[int(i)] = result
+                    num *= (0 - j)
+                    den *= (i - j)
+            nums.append(num)
+            dens.append(den)
+        if len(list2) > 1:
+            dens = self.group.batch_invert(dens)
+        for i, num, inv in zip(list2, nums, dens):
+            coeff[int(i)] = num * inv
         return coeff
 
     def _getCoefficientsDict(self, tree, coeff_list, coeff=1):
@@ -93,8 +93,26 @@ class PairingGroup():
     def decode(self, element):
         raise NotImplementedException 
     
-    def hash(self, args, type=ZR):
-        """hashes objects into ZR, G1 or G2 depending on the pairing curve"""
+    def hash(self, args, type=ZR, method=None, dst=None):
+        """hashes objects into ZR, G1 or G2 depending on the pairing curve
+
+           :param method: 'sswu' hashes a string into G1 or G2 following
+                RFC 9380 (simplified SWU with isogeny where needed). Only
+                available on the RELIC backend.
+           :param dst: domain separation tag for the 'sswu' method.
+        """
+        if method == 'sswu':
+            if pairing_lib != libs.relic:
+                raise ValueError("'sswu' hashing requires the RELIC backend")
+            if type not in [G1, G2]:
+                raise ValueError("'sswu' can only hash into G1 or G2")
+            if isinstance(args, str):
+                args = args.encode('utf-8')
+            if dst is None:
+                dst = b'CHARM-V01-CS02-with-RELIC-' + (b'G1' if type == G1 else b'G2') + b'_XMD:SHA-256_SSWU_RO_'
+            return H(self.Pairing, args, type, dst)
+        elif method is not None:
+            raise ValueError("unknown hash method: {}".format(method))
         return H(self.Pairing, args, type)
     
     def serialize(self, obj, compression=True):
@@ -127,6 +145,14 @@ class PairingGroup():
                 compatibility with previous versions of charm.
         """
         return deserialize(self.Pairing, obj, compression)
+
+    def deserializeList(self, obj, compression=True):
+        """Deserialize a list of bytes serialized elements. On the RELIC
+           backend the whole list is decoded outside of the GIL; each point
+           is still decompressed on its own."""
+        if hasattr(pg, 'deserializeList'):
+            return pg.deserializeList(self.Pairing, obj, compression)
+        return [deserialize(self.Pairing, o, compression) for o in obj]
     
     def debug(self, data, prefix=None):
         if not self._verbose:
@@ -148,6 +174,25 @@ class PairingGroup():
         """takes two lists of G1 & G2 and computes a pairing product"""
         return pair(lhs, rhs, self.Pairing)
 
+    def multiexp(self, bases, exps):
+        """takes a list of G1, G2 or GT elements and a list of ZR exponents (or ints)
+        and computes the product of bases[i] ** exps[i]. It is variable-time (the
+        MIRACL backend skips zero window digits), so use it with public exponents only."""
+        assert len(bases) == len(exps) and len(bases) > 0, "need equal, non-empty lists of bases and exponents"
+        if hasattr(pg, 'multiexp'):
+            return pg.multiexp(self.Pairing, bases, exps)
+        result = bases[0] ** exps[0]
+        for i in range(1, len(bases)):
+            result *= bases[i] ** exps[i]
+        return result
+
+    def batch_invert(self, elems):
+        """takes a list of ZR elements and returns the list of their inverses,
+        computed with a single modular inversion"""
+        if hasattr(pg, 'batch_invert'):
+            return pg.batch_invert(self.Pairing, elems)
+        return [~x for x in elems]
+
     def InitBenchmark(self):
         """initiates the benchmark state"""
         return pg.InitBenchmark(self.Pairing)
@@ -157,7 +157,7 @@ if opt.get('PAIR_MOD') == 'yes':
                             include_dirs = [utils_path,
                                             benchmark_path] + inc_dirs,
                             sources = [math_path+'pairing/pairingmodule.c', 
-                                        utils_path+'base64.c'],
+                                        utils_path+'base64.c', utils_path+'drbg.c'],
                             libraries=['pbc', 'gmp', 'crypto'], define_macros=_macros, undef_macros=_undef_macro,
                             library_dirs=library_dirs, runtime_library_dirs=runtime_library_dirs)
 
@@ -172,7 +172,7 @@ if opt.get('PAIR_MOD') == 'yes':
                                             benchmark_path, relic_inc],
                             sources = [math_path + 'pairing/relic/pairingmodule3.c',
                                         math_path + 'pairing/relic/relic_interface.c',
-                                        utils_path + 'base64.c'],
+                                        utils_path + 'base64.c', utils_path + 'drbg.c'],
                             libraries=['relic', 'gmp', 'crypto'], define_macros=_macros, undef_macros=_undef_macro,
                             library_dirs=library_dirs, runtime_library_dirs=runtime_library_dirs)
                             #extra_objects=[relic_lib], extra_compile_args=None)
@@ -187,7 +187,8 @@ if opt.get('PAIR_MOD') == 'yes':
                             include_dirs = [utils_path,
                                             benchmark_path, miracl_inc],
                             sources = [math_path + 'pairing/miracl/pairingmodule2.c',
-                                        math_path + 'pairing/miracl/miracl_interface2.cc'],
+                                        math_path + 'pairing/miracl/miracl_interface2.cc',
+                                        utils_path + 'base64.c', utils_path + 'drbg.c'],
                             libraries=['gmp', 'crypto', 'stdc++'], define_macros=_macros, undef_macros=_undef_macro,
                             extra_objects=[miracl_lib], extra_compile_args=None,
                             library_dirs=library_dirs, runtime_library_dirs=runtime_library_dirs)
@@ -200,7 +201,7 @@ if opt.get('INT_MOD') == 'yes':
                             include_dirs = [utils_path,
                                             benchmark_path] + inc_dirs,
                             sources = [math_path + 'integer/integermodule.c', 
-                                        utils_path + 'base64.c'], 
+                                        utils_path + 'base64.c', utils_path + 'drbg.c'], 
                             libraries=['gmp', 'crypto'], define_macros=_macros, undef_macros=_undef_macro,
                             library_dirs=library_dirs, runtime_library_dirs=runtime_library_dirs)
    _ext_modules.append(integer_module)
@@ -211,7 +212,8 @@ if opt.get('ECC_MOD') == 'yes':
                 include_dirs = [utils_path,
                                 benchmark_path] + inc_dirs,
 				sources = [math_path + 'elliptic_curve/ecmodule.c',
-                            utils_path + 'base64.c'], 
+                            math_path + 'elliptic_curve/ec_secp256k1.c',
+                            utils_path + 'base64.c', utils_path + 'drbg.c'], 
 				libraries=['gmp', 'crypto'], define_macros=_macros, undef_macros=_undef_macro,
                 library_dirs=library_dirs, runtime_library_dirs=runtime_library_dirs)
    _ext_modules.append(ecc_module)